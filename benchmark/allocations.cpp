@@ -0,0 +1,35 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+// Replaces the global allocation functions to count the allocations of every
+// benchmark for the `json` reporter.  It is linked into the benchmarks as a
+// separate translation unit, so the compiler does not see the definitions
+// together with the allocations of the benchmark code.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+std::atomic<std::size_t>& benchmark_allocations()
+{
+    static std::atomic<std::size_t> count{0};
+    return count;
+}
+
+void* operator new(std::size_t size)
+{
+    benchmark_allocations().fetch_add(1, std::memory_order_relaxed);
+    if (auto p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
@@ -0,0 +1,233 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/heap/gc_heap.hpp>
+#include <immer/memory_policy.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+struct contention_config
+{
+    std::size_t n        = 1000;
+    std::size_t ops      = 100000;
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t runs     = 5;
+    // operations timed together by `latencies::record`
+    std::size_t batch = 64;
+};
+
+// Every combination of heap and reference counting, plus garbage
+// collection.  The policies are named after their heap and refcount.
+template <typename Heap, typename Refcount>
+using bench_memory =
+    immer::memory_policy<Heap, Refcount, immer::default_lock_policy>;
+
+using cpp_heap_policy = immer::heap_policy<immer::cpp_heap>;
+using fl_heap_policy  = immer::free_list_heap_policy<immer::cpp_heap>;
+using ufl_heap_policy = immer::unsafe_free_list_heap_policy<immer::cpp_heap>;
+using gc_heap_policy  = immer::heap_policy<immer::gc_heap>;
+
+using cpp_rc_memory = bench_memory<cpp_heap_policy, immer::refcount_policy>;
+using cpp_urc_memory =
+    bench_memory<cpp_heap_policy, immer::unsafe_refcount_policy>;
+using fl_rc_memory = bench_memory<fl_heap_policy, immer::refcount_policy>;
+using fl_urc_memory =
+    bench_memory<fl_heap_policy, immer::unsafe_refcount_policy>;
+using ufl_rc_memory = bench_memory<ufl_heap_policy, immer::refcount_policy>;
+using ufl_urc_memory =
+    bench_memory<ufl_heap_policy, immer::unsafe_refcount_policy>;
+using gc_memory = bench_memory<gc_heap_policy, immer::no_refcount_policy>;
+
+/*!
+ * Whether containers using `MemoryPolicy` can be shared among threads.  The
+ * unsafe reference counts are not atomic, the unsafe free lists are global,
+ * and the garbage collector only scans the threads it knows about, so those
+ * are only measured with a single thread as a baseline.
+ */
+template <typename MemoryPolicy>
+constexpr bool thread_safe_policy()
+{
+    using heap = typename MemoryPolicy::heap;
+#if defined(GC_THREADS)
+    constexpr auto gc_ok = true;
+#else
+    constexpr auto gc_ok = !std::is_same<heap, gc_heap_policy>::value;
+#endif
+    return gc_ok && !std::is_same<heap, ufl_heap_policy>::value &&
+           !std::is_same<typename MemoryPolicy::refcount,
+                         immer::unsafe_refcount_policy>::value;
+}
+
+struct gc_thread_guard
+{
+#if defined(GC_THREADS)
+    gc_thread_guard()
+    {
+        auto sb = GC_stack_base{};
+        GC_get_stack_base(&sb);
+        GC_register_my_thread(&sb);
+    }
+    ~gc_thread_guard() { GC_unregister_my_thread(); }
+#endif
+};
+
+using bench_clock = std::chrono::steady_clock;
+
+inline std::uint64_t elapsed_ns(bench_clock::time_point from,
+                                bench_clock::time_point to)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from)
+        .count();
+}
+
+/*!
+ * Latencies of operations, in nanoseconds.  Every thread records into its
+ * own instance and they are merged after the run.
+ */
+struct latencies
+{
+    std::vector<std::uint64_t> samples;
+
+    /*!
+     * Calls `fn` `ops` times.  Reading the clock takes about as long as
+     * loading an atom, so the calls are timed in batches of `batch` and the
+     * average of each batch is recorded.  The percentiles are then those of
+     * the batch averages, which hide outliers shorter than a batch.
+     */
+    template <typename Fn>
+    void record(std::size_t ops, std::size_t batch, Fn&& fn)
+    {
+        samples.reserve(samples.size() + (ops + batch - 1) / batch);
+        for (auto i = std::size_t{}; i < ops;) {
+            auto k  = std::min(batch, ops - i);
+            auto t0 = bench_clock::now();
+            for (auto j = std::size_t{}; j < k; ++j)
+                fn();
+            samples.push_back(elapsed_ns(t0, bench_clock::now()) / k);
+            i += k;
+        }
+    }
+
+    void merge(const latencies& other)
+    {
+        samples.insert(
+            samples.end(), other.samples.begin(), other.samples.end());
+    }
+
+    // `q` in [0, 1]; reorders the samples
+    std::uint64_t percentile(double q)
+    {
+        if (samples.empty())
+            return 0;
+        auto idx = std::min(samples.size() - 1,
+                            static_cast<std::size_t>(q * samples.size()));
+        std::nth_element(
+            samples.begin(), samples.begin() + idx, samples.end());
+        return samples[idx];
+    }
+};
+
+/*!
+ * Runs `fn(thread_index, lat)` in `threads` threads at once.  The threads
+ * are created before the clock starts and wait on a spin barrier, so that
+ * only the concurrent part is measured.  Returns the wall time in seconds
+ * and merges the latencies recorded by every thread into `lat`.
+ */
+template <typename Fn>
+double run_threads(unsigned threads, latencies& lat, Fn&& fn)
+{
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+    auto lats    = std::vector<latencies>(threads);
+    auto workers = std::vector<std::thread>{};
+    for (auto i = 0u; i < threads; ++i)
+        workers.emplace_back([&, i] {
+            auto guard = gc_thread_guard{};
+            (void) guard;
+            ready.fetch_add(1);
+            while (!go.load())
+                std::this_thread::yield();
+            fn(i, lats[i]);
+        });
+    while (ready.load() < threads)
+        std::this_thread::yield();
+    auto t0 = bench_clock::now();
+    go.store(true);
+    for (auto& w : workers)
+        w.join();
+    auto t1 = bench_clock::now();
+    for (auto& l : lats)
+        lat.merge(l);
+    return elapsed_ns(t0, t1) / 1e9;
+}
+
+struct contention_result
+{
+    std::string benchmark;
+    std::string container;
+    std::string policy;
+    unsigned threads;
+    std::size_t n;
+    std::size_t ops;
+    double seconds;
+    std::uint64_t p50;
+    std::uint64_t p99;
+    std::uint64_t p999;
+    std::uint64_t max;
+};
+
+/*!
+ * Writes the results as a JSON array with one object per benchmark, policy
+ * and thread count.  `ops` counts the operations done by all threads in the
+ * fastest run, which took `seconds`, and the percentiles are over the
+ * latencies of every run, averaged per batch where `latencies::record` timed
+ * several operations at once.
+ */
+inline void write_json(std::FILE* out,
+                       const std::vector<contention_result>& results)
+{
+    std::fprintf(out, "[\n");
+    for (auto i = std::size_t{}; i < results.size(); ++i) {
+        auto& r = results[i];
+        std::fprintf(out,
+                     "  {\"benchmark\": \"%s\", \"container\": \"%s\", "
+                     "\"policy\": \"%s\", \"threads\": %u, \"N\": %zu, "
+                     "\"ops\": %zu, \"seconds\": %.9f, "
+                     "\"ops_per_second\": %.1f, \"latency_ns\": {\"p50\": "
+                     "%llu, \"p99\": %llu, \"p999\": %llu, \"max\": "
+                     "%llu}}%s\n",
+                     r.benchmark.c_str(),
+                     r.container.c_str(),
+                     r.policy.c_str(),
+                     r.threads,
+                     r.n,
+                     r.ops,
+                     r.seconds,
+                     r.seconds > 0 ? r.ops / r.seconds : 0.0,
+                     static_cast<unsigned long long>(r.p50),
+                     static_cast<unsigned long long>(r.p99),
+                     static_cast<unsigned long long>(r.p999),
+                     static_cast<unsigned long long>(r.max),
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "]\n");
+}
+
+} // anonymous namespace
@@ -0,0 +1,294 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+// Measures throughput and latency percentiles of `immer::atom` and of shared
+// containers when used from 1 to `max_threads` threads, for every memory
+// policy.  The results are written to the standard output as JSON.
+//
+// Usage: contention [N] [ops] [max_threads] [runs] [batch]
+
+#include "benchmark/concurrency/common.hpp"
+
+#include <immer/algorithm.hpp>
+#include <immer/atom.hpp>
+#include <immer/map.hpp>
+#include <immer/map_transient.hpp>
+#include <immer/vector.hpp>
+#include <immer/vector_transient.hpp>
+
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+
+namespace {
+
+struct context
+{
+    const contention_config& cfg;
+    const char* policy;
+    std::vector<contention_result>& results;
+};
+
+// Runs the benchmark `cfg.runs` times, keeping the fastest time and the
+// latencies of every run.  `fn(threads, lat)` returns the seconds and the
+// number of operations done.
+template <typename Fn>
+void measure(context& ctx,
+             const char* benchmark,
+             const char* container,
+             unsigned threads,
+             Fn&& fn)
+{
+    auto lat  = latencies{};
+    auto best = contention_result{benchmark,
+                                  container,
+                                  ctx.policy,
+                                  threads,
+                                  ctx.cfg.n,
+                                  0,
+                                  0,
+                                  0,
+                                  0,
+                                  0,
+                                  0};
+    for (auto i = 0u; i < ctx.cfg.runs; ++i) {
+        auto r = fn(threads, lat);
+        if (i == 0 || r.first < best.seconds) {
+            best.seconds = r.first;
+            best.ops     = r.second;
+        }
+    }
+    best.p50  = lat.percentile(0.5);
+    best.p99  = lat.percentile(0.99);
+    best.p999 = lat.percentile(0.999);
+    best.max  = lat.percentile(1);
+    ctx.results.push_back(best);
+}
+
+template <typename MemoryPolicy>
+void atom_benchmarks(context& ctx, unsigned threads)
+{
+    using atom_t = immer::atom<std::size_t, MemoryPolicy>;
+    auto ops     = ctx.cfg.ops;
+
+    measure(ctx, "load", "atom", threads, [&](auto threads, auto& lat) {
+        atom_t a{42};
+        auto secs = run_threads(threads, lat, [&](auto, auto& l) {
+            auto sink = std::size_t{};
+            l.record(ops, ctx.cfg.batch, [&] { sink += *a.load(); });
+            if (sink == 0)
+                std::abort();
+        });
+        return std::make_pair(secs, ops * threads);
+    });
+
+    measure(ctx, "update", "atom", threads, [&](auto threads, auto& lat) {
+        atom_t a{0};
+        auto secs = run_threads(threads, lat, [&](auto, auto& l) {
+            l.record(ops, ctx.cfg.batch, [&] {
+                a.update([](auto x) { return x + 1; });
+            });
+        });
+        if (*a.load() != ops * threads)
+            std::abort();
+        return std::make_pair(secs, ops * threads);
+    });
+
+    // one writer keeps updating while the others load, only the loads are
+    // measured
+    if (threads < 2)
+        return;
+    measure(ctx, "load-under-update", "atom", threads, [&](auto threads,
+                                                           auto& lat) {
+        atom_t a{1};
+        std::atomic<unsigned> readers{threads - 1};
+        auto secs = run_threads(threads, lat, [&](auto i, auto& l) {
+            if (i == 0) {
+                while (readers.load())
+                    a.update([](auto x) { return x + 1; });
+            } else {
+                auto sink = std::size_t{};
+                l.record(ops, ctx.cfg.batch, [&] { sink += *a.load(); });
+                if (sink == 0)
+                    std::abort();
+                readers.fetch_sub(1);
+            }
+        });
+        return std::make_pair(secs, ops * (threads - 1));
+    });
+}
+
+// Every operation copies the shared container, which touches the reference
+// count of its root, and then traverses the copy with `immer::accumulate`.
+// That takes long enough compared to reading the clock to time every
+// operation on its own.
+template <typename Container, typename Fn>
+void traverse_benchmark(context& ctx,
+                        const char* container,
+                        unsigned threads,
+                        const Container& shared,
+                        Fn fn)
+{
+    auto ops = std::max<std::size_t>(1, ctx.cfg.ops / 10);
+    measure(ctx, "traverse", container, threads, [&](auto threads, auto& lat) {
+        auto secs = run_threads(threads, lat, [&](auto, auto& l) {
+            auto sink = std::size_t{};
+            l.record(ops, 1, [&] {
+                auto local = shared;
+                sink       = immer::accumulate(local, sink, fn);
+            });
+            if (sink == 1)
+                std::abort();
+        });
+        return std::make_pair(secs, ops * threads);
+    });
+}
+
+template <typename MemoryPolicy>
+void shared_container_benchmarks(context& ctx, unsigned threads)
+{
+    using vector_t = immer::vector<std::size_t, MemoryPolicy>;
+    using map_t    = immer::map<std::size_t,
+                             std::size_t,
+                             std::hash<std::size_t>,
+                             std::equal_to<std::size_t>,
+                             MemoryPolicy>;
+
+    auto v = vector_t{}.transient();
+    auto m = map_t{}.transient();
+    for (auto i = std::size_t{}; i < ctx.cfg.n; ++i) {
+        v.push_back(i);
+        m.set(i, i);
+    }
+    traverse_benchmark(
+        ctx, "vector", threads, v.persistent(), [](auto acc, auto x) {
+            return acc + x;
+        });
+    traverse_benchmark(
+        ctx, "map", threads, m.persistent(), [](auto acc, auto& kv) {
+            return acc + kv.second;
+        });
+}
+
+// The first thread pushes new versions of a vector into a bounded queue, and
+// the others take them out and read them.  The latency is the time between
+// publishing and taking a version, and the versions are released by the
+// consumers, often freeing nodes allocated by the producer.
+template <typename MemoryPolicy>
+void handoff_benchmark(context& ctx, unsigned threads)
+{
+    using vector_t = immer::vector<std::size_t, MemoryPolicy>;
+    using item_t   = std::pair<vector_t, bench_clock::time_point>;
+
+    if (threads < 2)
+        return;
+
+    auto n   = ctx.cfg.n;
+    auto ops = ctx.cfg.ops;
+    measure(ctx, "handoff", "vector", threads, [&](auto threads, auto& lat) {
+        std::mutex mutex;
+        std::condition_variable cv;
+        auto queue     = std::deque<item_t>{};
+        auto done      = false;
+        auto capacity  = std::size_t{64};
+        auto consumers = threads - 1;
+        auto total     = ops * consumers;
+        auto secs      = run_threads(threads, lat, [&](auto i, auto& l) {
+            if (i == 0) {
+                auto v = vector_t{};
+                for (auto k = std::size_t{}; k < total; ++k) {
+                    v = v.size() < n ? v.push_back(k) : vector_t{}.push_back(k);
+                    auto lock = std::unique_lock<std::mutex>{mutex};
+                    cv.wait(lock, [&] { return queue.size() < capacity; });
+                    queue.emplace_back(v, bench_clock::now());
+                    cv.notify_all();
+                }
+                auto lock = std::unique_lock<std::mutex>{mutex};
+                done      = true;
+                cv.notify_all();
+            } else {
+                auto sink = std::size_t{};
+                l.samples.reserve(ops);
+                while (true) {
+                    auto lock = std::unique_lock<std::mutex>{mutex};
+                    cv.wait(lock, [&] { return done || !queue.empty(); });
+                    if (queue.empty())
+                        break;
+                    auto item = std::move(queue.front());
+                    queue.pop_front();
+                    cv.notify_all();
+                    lock.unlock();
+                    l.samples.push_back(
+                        elapsed_ns(item.second, bench_clock::now()));
+                    sink += item.first.back();
+                }
+                if (sink == 1)
+                    std::abort();
+            }
+        });
+        return std::make_pair(secs, total);
+    });
+}
+
+std::vector<unsigned> thread_counts(unsigned max_threads)
+{
+    auto r = std::vector<unsigned>{};
+    for (auto t = 1u; t < max_threads; t *= 2)
+        r.push_back(t);
+    r.push_back(max_threads);
+    return r;
+}
+
+template <typename MemoryPolicy>
+void run_policy(const contention_config& cfg,
+                const char* policy,
+                std::vector<contention_result>& results)
+{
+    auto ctx = context{cfg, policy, results};
+    auto max = thread_safe_policy<MemoryPolicy>() ? cfg.max_threads : 1u;
+    for (auto threads : thread_counts(max)) {
+        atom_benchmarks<MemoryPolicy>(ctx, threads);
+        shared_container_benchmarks<MemoryPolicy>(ctx, threads);
+        handoff_benchmark<MemoryPolicy>(ctx, threads);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto cfg = contention_config{};
+    if (argc > 1)
+        cfg.n = std::strtoul(argv[1], nullptr, 10);
+    if (argc > 2)
+        cfg.ops = std::strtoul(argv[2], nullptr, 10);
+    if (argc > 3)
+        cfg.max_threads = std::max(1ul, std::strtoul(argv[3], nullptr, 10));
+    if (argc > 4)
+        cfg.runs = std::max(1ul, std::strtoul(argv[4], nullptr, 10));
+    if (argc > 5)
+        cfg.batch = std::max(1ul, std::strtoul(argv[5], nullptr, 10));
+
+    GC_INIT();
+#if defined(GC_THREADS)
+    GC_allow_register_threads();
+#endif
+
+    auto results = std::vector<contention_result>{};
+    run_policy<cpp_rc_memory>(cfg, "heap/refcount", results);
+    run_policy<cpp_urc_memory>(cfg, "heap/unsafe_refcount", results);
+    run_policy<fl_rc_memory>(cfg, "free_list/refcount", results);
+    run_policy<fl_urc_memory>(cfg, "free_list/unsafe_refcount", results);
+    run_policy<ufl_rc_memory>(cfg, "unsafe_free_list/refcount", results);
+    run_policy<ufl_urc_memory>(
+        cfg, "unsafe_free_list/unsafe_refcount", results);
+    run_policy<gc_memory>(cfg, "gc", results);
+    write_json(stdout, results);
+    return 0;
+}
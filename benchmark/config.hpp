@@ -12,6 +12,8 @@
 
 #include <nonius.h++>
 
+#include "benchmark/reporter.hpp"
+
 #include <immer/heap/gc_heap.hpp>
 #include <immer/memory_policy.hpp>
 
@@ -56,16 +58,19 @@ using gcf_memory   = immer::memory_policy<immer::heap_policy<immer::gc_heap>,
                                           immer::default_lock_policy,
                                           immer::gc_transience_policy,
                                           false>;
-using basic_memory = immer::memory_policy<immer::heap_policy<immer::cpp_heap>,
-                                          immer::refcount_policy,
-                                          immer::default_lock_policy>;
-using safe_memory =
-    immer::memory_policy<immer::free_list_heap_policy<immer::cpp_heap>,
+// These use `immer::default_base_heap`, so that they go through the
+// `immer::counting_heap` when building with `ENABLE_COUNTING_HEAP`.
+using basic_memory =
+    immer::memory_policy<immer::heap_policy<immer::default_base_heap>,
                          immer::refcount_policy,
                          immer::default_lock_policy>;
-using unsafe_memory =
-    immer::memory_policy<immer::unsafe_free_list_heap_policy<immer::cpp_heap>,
-                         immer::unsafe_refcount_policy,
-                         immer::default_lock_policy>;
+using safe_memory = immer::memory_policy<
+    immer::free_list_heap_policy<immer::default_base_heap>,
+    immer::refcount_policy,
+    immer::default_lock_policy>;
+using unsafe_memory = immer::memory_policy<
+    immer::unsafe_free_list_heap_policy<immer::default_base_heap>,
+    immer::unsafe_refcount_policy,
+    immer::default_lock_policy>;
 
 } // anonymous namespace
@@ -0,0 +1,424 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/extra/persist/cereal/load.hpp>
+#include <immer/extra/persist/cereal/save.hpp>
+#include <immer/extra/persist/transform.hpp>
+
+#include <immer/box.hpp>
+#include <immer/flex_vector.hpp>
+#include <immer/flex_vector_transient.hpp>
+#include <immer/map.hpp>
+#include <immer/map_transient.hpp>
+#include <immer/set.hpp>
+#include <immer/set_transient.hpp>
+#include <immer/table.hpp>
+#include <immer/table_transient.hpp>
+#include <immer/vector.hpp>
+#include <immer/vector_transient.hpp>
+
+#include <cereal/types/string.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Shared infrastructure for the `immer::persist` benchmarks.
+ *
+ * Every benchmark works on a *history*: an `immer::vector` with a number of
+ * versions of one container, where every version is derived from the previous
+ * one by a few updates.  This is the scenario where the pools pay off, since
+ * all the versions share most of their nodes.  The amount of versions controls
+ * the sharing ratio of the serialized data.
+ */
+
+namespace {
+
+/**
+ * Number of updates applied to derive a version from the previous one, as a
+ * fraction of the size of the container.
+ */
+constexpr auto persist_edits_ratio = std::size_t{100};
+
+inline std::size_t persist_edits_for(std::size_t n)
+{
+    return std::max(std::size_t{1}, n / persist_edits_ratio);
+}
+
+/**
+ * Pool policy that stores the given container types in pools with names
+ * derived from the demangled name of the types.
+ */
+template <class... Containers>
+struct persist_policy
+    : immer::persist::demangled_names_t
+    , immer::persist::value0_serialize_t
+{
+    template <class T>
+    auto get_pool_types(const T&) const
+    {
+        return boost::hana::tuple_t<Containers...>;
+    }
+};
+
+/**
+ * Element conversion used by the transformation benchmarks, simulating a
+ * migration of the stored state to a new element type.
+ */
+inline std::uint64_t persist_migrate(unsigned x) { return x; }
+inline std::string persist_migrate(const std::string& x) { return x + "'"; }
+
+template <typename T>
+using persist_migrated_t =
+    decltype(persist_migrate(std::declval<const T&>()));
+
+/**
+ * Most kinds of containers are converted directly, boxes are not because
+ * they are stored inside of vectors.
+ */
+struct persist_convert_container
+{
+    template <typename Pools, typename NewPools, typename Container>
+    static auto
+    convert(const Pools& pools, NewPools& new_pools, const Container& v)
+    {
+        return immer::persist::convert_container(pools, new_pools, v);
+    }
+};
+
+template <typename T, typename V = unsigned>
+struct persist_entry
+{
+    T id;
+    V value;
+
+    friend bool operator==(const persist_entry& a, const persist_entry& b)
+    {
+        return a.id == b.id && a.value == b.value;
+    }
+
+    template <class Archive>
+    void serialize(Archive& ar)
+    {
+        ar(CEREAL_NVP(id), CEREAL_NVP(value));
+    }
+};
+
+template <typename T>
+struct persist_vector : persist_convert_container
+{
+    static constexpr auto name = "vector";
+
+    using container_t = immer::vector<T>;
+    using migrated_t  = immer::vector<persist_migrated_t<T>>;
+    using history_t   = immer::vector<container_t>;
+    using policy_t    = persist_policy<history_t, container_t>;
+
+    static container_t make(const std::vector<T>& g, std::size_t n)
+    {
+        auto t = container_t{}.transient();
+        for (auto i = 0u; i < n; ++i)
+            t.push_back(g[i]);
+        return t.persistent();
+    }
+
+    static container_t
+    edit(container_t v, const std::vector<T>& g, std::size_t i)
+    {
+        return std::move(v).set((i * 7919) % v.size(), g[i % g.size()]);
+    }
+
+    static auto conversion_map()
+    {
+        return boost::hana::make_map(boost::hana::make_pair(
+            boost::hana::type_c<container_t>,
+            [](const T& x) { return persist_migrate(x); }));
+    }
+};
+
+template <typename T>
+struct persist_flex_vector : persist_convert_container
+{
+    static constexpr auto name = "flex_vector";
+
+    using container_t = immer::flex_vector<T>;
+    using migrated_t  = immer::flex_vector<persist_migrated_t<T>>;
+    using history_t   = immer::vector<container_t>;
+    using policy_t    = persist_policy<history_t, container_t>;
+
+    static container_t make(const std::vector<T>& g, std::size_t n)
+    {
+        auto t = container_t{}.transient();
+        for (auto i = 0u; i < n; ++i)
+            t.push_back(g[i]);
+        return t.persistent();
+    }
+
+    // Mix concatenations in, so the trees contain relaxed nodes.
+    static container_t
+    edit(container_t v, const std::vector<T>& g, std::size_t i)
+    {
+        auto idx = (i * 7919) % v.size();
+        return i % 2 ? std::move(v).set(idx, g[i % g.size()])
+                     : std::move(v).insert(idx, g[i % g.size()]).drop(1);
+    }
+
+    static auto conversion_map()
+    {
+        return boost::hana::make_map(boost::hana::make_pair(
+            boost::hana::type_c<container_t>,
+            [](const T& x) { return persist_migrate(x); }));
+    }
+};
+
+template <typename T>
+struct persist_map : persist_convert_container
+{
+    static constexpr auto name = "map";
+
+    using container_t = immer::map<T, unsigned>;
+    using migrated_t  = immer::map<T, std::uint64_t>;
+    using history_t   = immer::vector<container_t>;
+    using policy_t    = persist_policy<history_t, container_t>;
+
+    static container_t make(const std::vector<T>& g, std::size_t n)
+    {
+        auto t = container_t{}.transient();
+        for (auto i = 0u; i < n; ++i)
+            t.set(g[i], i);
+        return t.persistent();
+    }
+
+    static container_t
+    edit(container_t v, const std::vector<T>& g, std::size_t i)
+    {
+        return std::move(v).set(g[(i * 7919) % g.size()],
+                                static_cast<unsigned>(i));
+    }
+
+    // The keys are kept, so the structure of the tries can be preserved.
+    static auto conversion_map()
+    {
+        return boost::hana::make_map(boost::hana::make_pair(
+            boost::hana::type_c<container_t>,
+            boost::hana::overload(
+                [](const std::pair<T, unsigned>& x) {
+                    return std::make_pair(x.first,
+                                          std::uint64_t{x.second});
+                },
+                [](immer::persist::target_container_type_request) {
+                    return migrated_t{};
+                })));
+    }
+};
+
+template <typename T>
+struct persist_set : persist_convert_container
+{
+    static constexpr auto name = "set";
+
+    using container_t = immer::set<T>;
+    using migrated_t  = immer::set<persist_migrated_t<T>>;
+    using history_t   = immer::vector<container_t>;
+    using policy_t    = persist_policy<history_t, container_t>;
+
+    static container_t make(const std::vector<T>& g, std::size_t n)
+    {
+        auto t = container_t{}.transient();
+        for (auto i = 0u; i < n; ++i)
+            t.insert(g[i]);
+        return t.persistent();
+    }
+
+    static container_t
+    edit(container_t v, const std::vector<T>& g, std::size_t i)
+    {
+        auto& x = g[(i * 7919) % g.size()];
+        return v.count(x) ? std::move(v).erase(x) : std::move(v).insert(x);
+    }
+
+    // The elements are the keys, their hashes may change so the tries are
+    // rebuilt from the converted values.
+    static auto conversion_map()
+    {
+        return boost::hana::make_map(boost::hana::make_pair(
+            boost::hana::type_c<container_t>,
+            boost::hana::overload(
+                [](const T& x) { return persist_migrate(x); },
+                [](immer::persist::target_container_type_request) {
+                    return immer::persist::incompatible_hash_wrapper<
+                        migrated_t>{};
+                })));
+    }
+};
+
+template <typename T>
+struct persist_table : persist_convert_container
+{
+    static constexpr auto name = "table";
+
+    using entry_t     = persist_entry<T>;
+    using container_t = immer::table<entry_t>;
+    using migrated_t  = immer::table<persist_entry<T, std::uint64_t>>;
+    using history_t   = immer::vector<container_t>;
+    using policy_t    = persist_policy<history_t, container_t>;
+
+    static container_t make(const std::vector<T>& g, std::size_t n)
+    {
+        auto t = container_t{}.transient();
+        for (auto i = 0u; i < n; ++i)
+            t.insert(entry_t{g[i], i});
+        return t.persistent();
+    }
+
+    static container_t
+    edit(container_t v, const std::vector<T>& g, std::size_t i)
+    {
+        return std::move(v).insert(
+            entry_t{g[(i * 7919) % g.size()], static_cast<unsigned>(i)});
+    }
+
+    static auto conversion_map()
+    {
+        return boost::hana::make_map(boost::hana::make_pair(
+            boost::hana::type_c<container_t>,
+            boost::hana::overload(
+                [](const entry_t& x) {
+                    return persist_entry<T, std::uint64_t>{x.id, x.value};
+                },
+                [](immer::persist::target_container_type_request) {
+                    return migrated_t{};
+                })));
+    }
+};
+
+/**
+ * Boxes are stored in a vector, so every version of the structure refers to
+ * many boxes, most of them shared with the previous version.
+ */
+template <typename T>
+struct persist_box
+{
+    static constexpr auto name = "box";
+
+    using box_t       = immer::box<T>;
+    using container_t = immer::vector<box_t>;
+    using migrated_t  = immer::vector<immer::box<persist_migrated_t<T>>>;
+    using history_t   = immer::vector<container_t>;
+    using policy_t    = persist_policy<history_t, container_t, box_t>;
+
+    static container_t make(const std::vector<T>& g, std::size_t n)
+    {
+        auto t = container_t{}.transient();
+        for (auto i = 0u; i < n; ++i)
+            t.push_back(box_t{g[i]});
+        return t.persistent();
+    }
+
+    static container_t
+    edit(container_t v, const std::vector<T>& g, std::size_t i)
+    {
+        return std::move(v).set((i * 7919) % v.size(),
+                                box_t{g[i % g.size()]});
+    }
+
+    static auto conversion_map()
+    {
+        return boost::hana::make_map(boost::hana::make_pair(
+            boost::hana::type_c<box_t>,
+            [](const T& x) { return persist_migrate(x); }));
+    }
+
+    template <typename Pools, typename NewPools>
+    static migrated_t
+    convert(const Pools& pools, NewPools& new_pools, const container_t& v)
+    {
+        auto t = migrated_t{}.transient();
+        for (const auto& b : v)
+            t.push_back(
+                immer::persist::convert_container(pools, new_pools, b));
+        return t.persistent();
+    }
+};
+
+/**
+ * Generates a history with `versions` versions of a container of `n`
+ * elements.
+ */
+template <typename Kind, typename T>
+typename Kind::history_t make_persist_history(const std::vector<T>& g,
+                                              std::size_t n,
+                                              std::size_t versions)
+{
+    auto edits   = persist_edits_for(n);
+    auto v       = Kind::make(g, n);
+    auto history = typename Kind::history_t{}.transient();
+    for (auto k = 0u; k < versions; ++k) {
+        history.push_back(v);
+        for (auto i = 0u; i < edits; ++i)
+            v = Kind::edit(std::move(v), g, k * edits + i);
+    }
+    return history.persistent();
+}
+
+/**
+ * Converts all the versions in a history using previously transformed pools.
+ */
+template <typename Kind, typename Pools, typename NewPools>
+auto convert_persist_history(const typename Kind::history_t& history,
+                             const Pools& pools,
+                             NewPools& new_pools)
+{
+    auto result = immer::vector<typename Kind::migrated_t>{}.transient();
+    for (const auto& v : history)
+        result.push_back(Kind::convert(pools, new_pools, v));
+    return result.persistent();
+}
+
+/**
+ * Number of nodes stored in the pools, used to report throughput in nodes per
+ * second.
+ */
+template <typename T,
+          typename MP,
+          immer::detail::rbts::bits_t B,
+          immer::detail::rbts::bits_t BL>
+std::size_t
+persist_pool_nodes(const immer::persist::rbts::output_pool<T, MP, B, BL>& p)
+{
+    return p.leaves.size() + p.inners.size();
+}
+
+template <typename Container>
+std::size_t persist_pool_nodes(
+    const immer::persist::champ::container_output_pool<Container>& p)
+{
+    return p.nodes.inners.size();
+}
+
+template <typename T, typename MP>
+std::size_t
+persist_pool_nodes(const immer::persist::box::output_pool<T, MP>& p)
+{
+    return p.boxes.size();
+}
+
+template <typename Pools>
+std::size_t persist_pools_nodes(const Pools& pools)
+{
+    auto r = std::size_t{};
+    boost::hana::for_each(boost::hana::values(pools.storage()),
+                          [&](const auto& p) { r += persist_pool_nodes(p); });
+    return r;
+}
+
+} // namespace
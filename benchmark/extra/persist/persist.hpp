@@ -0,0 +1,160 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include "benchmark/config.hpp"
+#include "benchmark/extra/persist/common.hpp"
+
+#include <immer/extra/cereal/immer_box.hpp>
+#include <immer/extra/cereal/immer_map.hpp>
+#include <immer/extra/cereal/immer_set.hpp>
+#include <immer/extra/cereal/immer_table.hpp>
+#include <immer/extra/cereal/immer_vector.hpp>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/archives/json.hpp>
+
+#include <sstream>
+
+NONIUS_PARAM(V, std::size_t{16})
+
+namespace {
+
+template <typename Generator, typename Kind>
+auto make_persist_history_for(nonius::chronometer& meter)
+{
+    auto n = meter.param<N>();
+    auto g = Generator{}(n);
+    return make_persist_history<Kind>(g, n, meter.param<V>());
+}
+
+template <typename Archive, typename T>
+std::string cereal_save_plain(const T& value)
+{
+    auto os = std::ostringstream{};
+    {
+        auto ar = Archive{os};
+        ar(value);
+    }
+    return os.str();
+}
+
+template <typename Archive, typename T>
+T cereal_load_plain(const std::string& str)
+{
+    auto is = std::istringstream{str};
+    auto ar = Archive{is};
+    auto r  = T{};
+    ar(r);
+    return r;
+}
+
+template <typename Generator, typename Kind>
+auto benchmark_persist_save()
+{
+    return [](nonius::chronometer meter) {
+        auto h = make_persist_history_for<Generator, Kind>(meter);
+
+        measure(meter, [&] {
+            return immer::persist::cereal_save_with_pools(
+                h, typename Kind::policy_t{});
+        });
+    };
+}
+
+template <typename Generator, typename Kind>
+auto benchmark_persist_load()
+{
+    return [](nonius::chronometer meter) {
+        using history_t = typename Kind::history_t;
+        auto h          = make_persist_history_for<Generator, Kind>(meter);
+        auto policy     = typename Kind::policy_t{};
+        auto str        = immer::persist::cereal_save_with_pools(h, policy);
+
+        measure(meter, [&] {
+            return immer::persist::cereal_load_with_pools<history_t>(str,
+                                                                     policy);
+        });
+    };
+}
+
+template <typename Generator, typename Kind, typename Archive>
+auto benchmark_cereal_save()
+{
+    return [](nonius::chronometer meter) {
+        auto h = make_persist_history_for<Generator, Kind>(meter);
+
+        measure(meter, [&] { return cereal_save_plain<Archive>(h); });
+    };
+}
+
+template <typename Generator,
+          typename Kind,
+          typename OutputArchive,
+          typename InputArchive>
+auto benchmark_cereal_load()
+{
+    return [](nonius::chronometer meter) {
+        using history_t = typename Kind::history_t;
+        auto h          = make_persist_history_for<Generator, Kind>(meter);
+        auto str        = cereal_save_plain<OutputArchive>(h);
+
+        measure(meter,
+                [&] { return cereal_load_plain<InputArchive, history_t>(str); });
+    };
+}
+
+template <typename Generator, typename Kind>
+auto benchmark_persist_get_output_pools()
+{
+    return [](nonius::chronometer meter) {
+        auto h = make_persist_history_for<Generator, Kind>(meter);
+
+        measure(meter, [&] {
+            return immer::persist::get_output_pools(h,
+                                                    typename Kind::policy_t{});
+        });
+    };
+}
+
+template <typename Generator, typename Kind>
+auto benchmark_persist_transform()
+{
+    return [](nonius::chronometer meter) {
+        auto h     = make_persist_history_for<Generator, Kind>(meter);
+        auto pools = immer::persist::get_output_pools(
+            h, typename Kind::policy_t{});
+        auto conversion_map = Kind::conversion_map();
+
+        measure(meter, [&] {
+            auto new_pools = immer::persist::transform_output_pool(
+                pools, conversion_map);
+            return convert_persist_history<Kind>(h, pools, new_pools);
+        });
+    };
+}
+
+template <typename Generator, typename Kind>
+auto benchmark_persist_transform_parallel()
+{
+    return [](nonius::chronometer meter) {
+        auto h     = make_persist_history_for<Generator, Kind>(meter);
+        auto pools = immer::persist::get_output_pools(
+            h, typename Kind::policy_t{});
+        auto conversion_map = Kind::conversion_map();
+
+        measure(meter, [&] {
+            auto new_pools = immer::persist::transform_output_pool(
+                pools, conversion_map, immer::persist::parallel_options{});
+            return convert_persist_history<Kind>(h, pools, new_pools);
+        });
+    };
+}
+
+} // namespace
@@ -0,0 +1,151 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+// Reports the output sizes of the different serialization formats and the
+// save and load throughput of `immer::persist`, in MB/s and nodes/s.
+//
+// Usage: report [N] [versions] [runs]
+
+#include "benchmark/extra/persist/common.hpp"
+
+#include "benchmark/set/string-long/generator.ipp"
+#undef GENERATOR_T
+#include "benchmark/set/string-short/generator.ipp"
+#undef GENERATOR_T
+#include "benchmark/set/unsigned/generator.ipp"
+#undef GENERATOR_T
+
+#include <immer/extra/cereal/immer_box.hpp>
+#include <immer/extra/cereal/immer_map.hpp>
+#include <immer/extra/cereal/immer_set.hpp>
+#include <immer/extra/cereal/immer_table.hpp>
+#include <immer/extra/cereal/immer_vector.hpp>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/archives/json.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+
+struct report_config
+{
+    std::size_t n        = 1000;
+    std::size_t versions = 16;
+    std::size_t runs     = 5;
+};
+
+template <typename Archive, typename T>
+std::size_t cereal_plain_size(const T& value)
+{
+    auto os = std::ostringstream{};
+    {
+        auto ar = Archive{os};
+        ar(value);
+    }
+    return os.str().size();
+}
+
+// Returns the best time in seconds over the configured amount of runs.
+template <typename Fn>
+double best_time(const report_config& cfg, Fn&& fn)
+{
+    using clock_t = std::chrono::steady_clock;
+    auto best     = std::chrono::duration<double>::max();
+    for (auto i = 0u; i < cfg.runs; ++i) {
+        auto start  = clock_t::now();
+        auto result = fn();
+        auto time   = clock_t::now() - start;
+        best        = std::min<std::chrono::duration<double>>(best, time);
+        (void) result;
+    }
+    return best.count();
+}
+
+template <template <class> class Kind, typename Generator>
+void report(const report_config& cfg, const char* type_name)
+{
+    using T         = typename decltype(Generator{}(0))::value_type;
+    using kind_t    = Kind<T>;
+    using history_t = typename kind_t::history_t;
+
+    auto g      = Generator{}(cfg.n);
+    auto h      = make_persist_history<kind_t>(g, cfg.n, cfg.versions);
+    auto policy = typename kind_t::policy_t{};
+    auto pools  = immer::persist::get_output_pools(h, policy);
+    auto nodes  = persist_pools_nodes(pools);
+    auto str    = immer::persist::cereal_save_with_pools(h, policy);
+    auto json   = cereal_plain_size<cereal::JSONOutputArchive>(h);
+    auto binary = cereal_plain_size<cereal::BinaryOutputArchive>(h);
+    auto t_save = best_time(cfg, [&] {
+        return immer::persist::cereal_save_with_pools(h, policy);
+    });
+    auto t_load = best_time(cfg, [&] {
+        return immer::persist::cereal_load_with_pools<history_t>(str, policy);
+    });
+    auto megs   = str.size() / (1024.0 * 1024.0);
+    std::printf("%-12s %-14s %10zu %12zu %12zu %12zu %10.2f %12.0f %10.2f "
+                "%12.0f\n",
+                kind_t::name,
+                type_name,
+                nodes,
+                str.size(),
+                json,
+                binary,
+                megs / t_save,
+                nodes / t_save,
+                megs / t_load,
+                nodes / t_load);
+}
+
+template <typename Generator>
+void report_all(const report_config& cfg, const char* type_name)
+{
+    report<persist_vector, Generator>(cfg, type_name);
+    report<persist_flex_vector, Generator>(cfg, type_name);
+    report<persist_map, Generator>(cfg, type_name);
+    report<persist_set, Generator>(cfg, type_name);
+    report<persist_table, Generator>(cfg, type_name);
+    report<persist_box, Generator>(cfg, type_name);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto cfg = report_config{};
+    if (argc > 1)
+        cfg.n = std::strtoul(argv[1], nullptr, 10);
+    if (argc > 2)
+        cfg.versions = std::strtoul(argv[2], nullptr, 10);
+    if (argc > 3)
+        cfg.runs = std::strtoul(argv[3], nullptr, 10);
+
+    std::printf("N = %zu, versions = %zu, runs = %zu\n\n",
+                cfg.n,
+                cfg.versions,
+                cfg.runs);
+    std::printf("%-12s %-14s %10s %12s %12s %12s %10s %12s %10s %12s\n",
+                "container",
+                "element",
+                "nodes",
+                "persist B",
+                "json B",
+                "binary B",
+                "save MB/s",
+                "save nodes/s",
+                "load MB/s",
+                "load nodes/s");
+    report_all<generate_unsigned>(cfg, "unsigned");
+    report_all<generate_string_short>(cfg, "string-short");
+    report_all<generate_string_long>(cfg, "string-long");
+    return 0;
+}
@@ -0,0 +1,42 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include "benchmark/extra/persist/persist.hpp"
+
+#ifndef GENERATOR_T
+#error "you must define a GENERATOR_T"
+#endif
+
+using generator__ = GENERATOR_T;
+using t__         = typename decltype(generator__{}(0))::value_type;
+
+// clang-format off
+NONIUS_BENCHMARK("vector/persist", benchmark_persist_save<generator__, persist_vector<t__>>())
+NONIUS_BENCHMARK("vector/cereal-json", benchmark_cereal_save<generator__, persist_vector<t__>, cereal::JSONOutputArchive>())
+NONIUS_BENCHMARK("vector/cereal-binary", benchmark_cereal_save<generator__, persist_vector<t__>, cereal::BinaryOutputArchive>())
+
+NONIUS_BENCHMARK("flex_vector/persist", benchmark_persist_save<generator__, persist_flex_vector<t__>>())
+NONIUS_BENCHMARK("flex_vector/cereal-json", benchmark_cereal_save<generator__, persist_flex_vector<t__>, cereal::JSONOutputArchive>())
+NONIUS_BENCHMARK("flex_vector/cereal-binary", benchmark_cereal_save<generator__, persist_flex_vector<t__>, cereal::BinaryOutputArchive>())
+
+NONIUS_BENCHMARK("map/persist", benchmark_persist_save<generator__, persist_map<t__>>())
+NONIUS_BENCHMARK("map/cereal-json", benchmark_cereal_save<generator__, persist_map<t__>, cereal::JSONOutputArchive>())
+NONIUS_BENCHMARK("map/cereal-binary", benchmark_cereal_save<generator__, persist_map<t__>, cereal::BinaryOutputArchive>())
+
+NONIUS_BENCHMARK("set/persist", benchmark_persist_save<generator__, persist_set<t__>>())
+NONIUS_BENCHMARK("set/cereal-json", benchmark_cereal_save<generator__, persist_set<t__>, cereal::JSONOutputArchive>())
+NONIUS_BENCHMARK("set/cereal-binary", benchmark_cereal_save<generator__, persist_set<t__>, cereal::BinaryOutputArchive>())
+
+NONIUS_BENCHMARK("table/persist", benchmark_persist_save<generator__, persist_table<t__>>())
+NONIUS_BENCHMARK("table/cereal-json", benchmark_cereal_save<generator__, persist_table<t__>, cereal::JSONOutputArchive>())
+NONIUS_BENCHMARK("table/cereal-binary", benchmark_cereal_save<generator__, persist_table<t__>, cereal::BinaryOutputArchive>())
+
+NONIUS_BENCHMARK("box/persist", benchmark_persist_save<generator__, persist_box<t__>>())
+NONIUS_BENCHMARK("box/cereal-json", benchmark_cereal_save<generator__, persist_box<t__>, cereal::JSONOutputArchive>())
+NONIUS_BENCHMARK("box/cereal-binary", benchmark_cereal_save<generator__, persist_box<t__>, cereal::BinaryOutputArchive>())
+// clang-format on
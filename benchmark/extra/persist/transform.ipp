@@ -0,0 +1,42 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include "benchmark/extra/persist/persist.hpp"
+
+#ifndef GENERATOR_T
+#error "you must define a GENERATOR_T"
+#endif
+
+using generator__ = GENERATOR_T;
+using t__         = typename decltype(generator__{}(0))::value_type;
+
+// clang-format off
+NONIUS_BENCHMARK("vector/get_output_pools", benchmark_persist_get_output_pools<generator__, persist_vector<t__>>())
+NONIUS_BENCHMARK("vector/transform", benchmark_persist_transform<generator__, persist_vector<t__>>())
+NONIUS_BENCHMARK("vector/transform/parallel", benchmark_persist_transform_parallel<generator__, persist_vector<t__>>())
+
+NONIUS_BENCHMARK("flex_vector/get_output_pools", benchmark_persist_get_output_pools<generator__, persist_flex_vector<t__>>())
+NONIUS_BENCHMARK("flex_vector/transform", benchmark_persist_transform<generator__, persist_flex_vector<t__>>())
+NONIUS_BENCHMARK("flex_vector/transform/parallel", benchmark_persist_transform_parallel<generator__, persist_flex_vector<t__>>())
+
+NONIUS_BENCHMARK("map/get_output_pools", benchmark_persist_get_output_pools<generator__, persist_map<t__>>())
+NONIUS_BENCHMARK("map/transform", benchmark_persist_transform<generator__, persist_map<t__>>())
+NONIUS_BENCHMARK("map/transform/parallel", benchmark_persist_transform_parallel<generator__, persist_map<t__>>())
+
+NONIUS_BENCHMARK("set/get_output_pools", benchmark_persist_get_output_pools<generator__, persist_set<t__>>())
+NONIUS_BENCHMARK("set/transform", benchmark_persist_transform<generator__, persist_set<t__>>())
+NONIUS_BENCHMARK("set/transform/parallel", benchmark_persist_transform_parallel<generator__, persist_set<t__>>())
+
+NONIUS_BENCHMARK("table/get_output_pools", benchmark_persist_get_output_pools<generator__, persist_table<t__>>())
+NONIUS_BENCHMARK("table/transform", benchmark_persist_transform<generator__, persist_table<t__>>())
+NONIUS_BENCHMARK("table/transform/parallel", benchmark_persist_transform_parallel<generator__, persist_table<t__>>())
+
+NONIUS_BENCHMARK("box/get_output_pools", benchmark_persist_get_output_pools<generator__, persist_box<t__>>())
+NONIUS_BENCHMARK("box/transform", benchmark_persist_transform<generator__, persist_box<t__>>())
+NONIUS_BENCHMARK("box/transform/parallel", benchmark_persist_transform_parallel<generator__, persist_box<t__>>())
+// clang-format on
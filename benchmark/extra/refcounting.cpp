@@ -14,6 +14,8 @@
 
 #include <nonius.h++>
 
+#include "benchmark/reporter.hpp"
+
 #include <array>
 #include <atomic>
 #include <cstdlib>
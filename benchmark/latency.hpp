@@ -0,0 +1,131 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+/*!
+ * Histogram of latencies in nanoseconds, in the spirit of HdrHistogram.
+ * Values below `2^sub_bucket_bits` are counted exactly.  Above that, every
+ * power of two is split in `2^(sub_bucket_bits - 1)` linear buckets, so that
+ * any recorded value is off by less than 0.2%, while recording is only a few
+ * instructions.  Values above `2^max_bits` nanoseconds, about 18 minutes,
+ * are counted in the last bucket, but `max()` is always exact.
+ */
+class latency_histogram
+{
+public:
+    static constexpr auto sub_bucket_bits  = 10u;
+    static constexpr auto max_bits         = 40u;
+    static constexpr auto sub_bucket_count = std::uint64_t{1}
+                                             << sub_bucket_bits;
+    static constexpr auto sub_bucket_half  = sub_bucket_count / 2;
+    static constexpr auto bucket_count =
+        sub_bucket_count + (max_bits - sub_bucket_bits) * sub_bucket_half;
+
+    void reset()
+    {
+        counts_.fill(0);
+        total_ = 0;
+        max_   = 0;
+    }
+
+    void record(std::uint64_t ns)
+    {
+        ++counts_[index_of(ns)];
+        ++total_;
+        max_ = std::max(max_, ns);
+    }
+
+    std::uint64_t count() const { return total_; }
+    std::uint64_t max() const { return max_; }
+
+    /*!
+     * Returns the smallest latency such that `q` of the recorded ones, with
+     * `0 < q <= 1`, are not above it.  Like HdrHistogram, this is the highest
+     * value that falls in the same bucket, never above `max()`.
+     */
+    std::uint64_t percentile(double q) const
+    {
+        if (!total_)
+            return 0;
+        auto target = std::max(std::uint64_t{1},
+                               static_cast<std::uint64_t>(q * total_ + 0.5));
+        auto acc    = std::uint64_t{};
+        for (auto i = std::size_t{}; i < bucket_count; ++i) {
+            acc += counts_[i];
+            if (acc >= target)
+                return std::min(highest_of(i), max_);
+        }
+        return max_;
+    }
+
+private:
+    static std::size_t index_of(std::uint64_t ns)
+    {
+        if (ns < sub_bucket_count)
+            return ns;
+        auto msb = std::uint64_t{63} - __builtin_clzll(ns);
+        if (msb >= max_bits)
+            return bucket_count - 1;
+        auto shift = msb - (sub_bucket_bits - 1);
+        return sub_bucket_count + (shift - 1) * sub_bucket_half +
+               ((ns >> shift) - sub_bucket_half);
+    }
+
+    static std::uint64_t highest_of(std::size_t index)
+    {
+        if (index < sub_bucket_count)
+            return index;
+        auto shift = (index - sub_bucket_count) / sub_bucket_half + 1;
+        auto sub   = (index - sub_bucket_count) % sub_bucket_half;
+        return ((sub + sub_bucket_half + 1) << shift) - 1;
+    }
+
+    std::array<std::uint64_t, bucket_count> counts_ = {};
+    std::uint64_t total_                            = 0;
+    std::uint64_t max_                              = 0;
+};
+
+// Latencies recorded with `timed()` during the current measurement, which
+// the `json_reporter` summarizes.
+latency_histogram& benchmark_latencies()
+{
+    static latency_histogram histogram;
+    return histogram;
+}
+
+/*!
+ * Calls `fn` and records how long it took in `benchmark_latencies()`,
+ * returning its result.  The result is returned by value, so that assigning
+ * it, which may free the previous value of a container, is not timed.  The
+ * latencies include the cost of reading the clock, a few tens of
+ * nanoseconds on most Linux machines.
+ */
+template <typename Fn>
+auto timed(Fn&& fn)
+{
+    using clock = std::chrono::steady_clock;
+    auto start  = clock::now();
+    auto result = std::forward<Fn>(fn)();
+    auto stop   = clock::now();
+    benchmark_latencies().record(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+            .count());
+    return result;
+}
+
+} // anonymous namespace
@@ -0,0 +1,104 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include "benchmark/config.hpp"
+
+#include <boost/container/flat_map.hpp>
+#include <immer/map.hpp>
+#include <immer/map_transient.hpp>
+#include <unordered_map>
+
+namespace {
+
+template <typename Generator, typename Map>
+auto benchmark_erase_mut_std()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g  = Generator{}(n);
+        auto v_ = [&] {
+            auto v = Map{};
+            for (auto i = 0u; i < n; ++i)
+                v[g[i]] = i;
+            return v;
+        }();
+        measure(meter, [&] {
+            auto v = v_;
+            for (auto i = 0u; i < n; ++i)
+                v.erase(g[i]);
+            return v;
+        });
+    };
+}
+
+template <typename Generator, typename Map>
+auto benchmark_erase_mut()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g  = Generator{}(n);
+        auto v_ = [&] {
+            auto v = Map{}.transient();
+            for (auto i = 0u; i < n; ++i)
+                v.set(g[i], i);
+            return v.persistent();
+        }();
+        measure(meter, [&] {
+            auto v = v_.transient();
+            for (auto i = 0u; i < n; ++i)
+                v.erase(g[i]);
+            return v;
+        });
+    };
+}
+
+template <typename Generator, typename Map>
+auto benchmark_erase()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g  = Generator{}(n);
+        auto v_ = [&] {
+            auto v = Map{}.transient();
+            for (auto i = 0u; i < n; ++i)
+                v.set(g[i], i);
+            return v.persistent();
+        }();
+        measure(meter, [&] {
+            auto v = v_;
+            for (auto i = 0u; i < n; ++i)
+                v = v.erase(g[i]);
+            return v;
+        });
+    };
+}
+
+template <typename Generator, typename Map>
+auto benchmark_erase_move()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g  = Generator{}(n);
+        auto v_ = [&] {
+            auto v = Map{}.transient();
+            for (auto i = 0u; i < n; ++i)
+                v.set(g[i], i);
+            return v.persistent();
+        }();
+        measure(meter, [&] {
+            auto v = v_;
+            for (auto i = 0u; i < n; ++i)
+                v = std::move(v).erase(g[i]);
+            return v;
+        });
+    };
+}
+
+} // namespace
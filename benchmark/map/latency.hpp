@@ -0,0 +1,34 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include "benchmark/config.hpp"
+#include "benchmark/latency.hpp"
+
+#include <immer/map.hpp>
+
+namespace {
+
+template <typename Generator, typename Map>
+auto benchmark_insert_latency()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+        auto g = Generator{}(n);
+
+        measure(meter, [&] {
+            auto v = Map{};
+            for (auto i = 0u; i < n; ++i)
+                v = timed([&] { return v.set(g[i], i); });
+            return v;
+        });
+    };
+}
+
+} // namespace
@@ -0,0 +1,130 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include "benchmark/config.hpp"
+
+#include <boost/container/flat_map.hpp>
+#include <immer/map.hpp>
+#include <immer/map_transient.hpp>
+#include <unordered_map>
+
+namespace {
+
+// Operations modifying the value of a key that is already in the map.  They
+// work both on persistent maps, returning the new version, and on transients,
+// updating them in place.
+struct update_op
+{
+    template <typename Map, typename K>
+    auto operator()(Map&& v, const K& k, unsigned) const
+    {
+        return std::forward<Map>(v).update(k, [](auto x) { return x + 1; });
+    }
+};
+
+struct update_if_exists_op
+{
+    template <typename Map, typename K>
+    auto operator()(Map&& v, const K& k, unsigned) const
+    {
+        return std::forward<Map>(v).update_if_exists(
+            k, [](auto x) { return x + 1; });
+    }
+};
+
+struct set_op
+{
+    template <typename Map, typename K>
+    auto operator()(Map&& v, const K& k, unsigned i) const
+    {
+        return std::forward<Map>(v).set(k, i);
+    }
+};
+
+template <typename Generator, typename Map>
+auto make_map(std::size_t n)
+{
+    auto g = Generator{}(n);
+    auto v = Map{}.transient();
+    for (auto i = 0u; i < n; ++i)
+        v.set(g[i], i);
+    return std::make_pair(g, v.persistent());
+}
+
+template <typename Generator, typename Map>
+auto benchmark_update_std()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+        auto g = Generator{}(n);
+        auto v = Map{};
+        for (auto i = 0u; i < n; ++i)
+            v[g[i]] = i;
+
+        measure(meter, [&] {
+            for (auto i = 0u; i < n; ++i)
+                ++v.find(g[i])->second;
+            return v.size();
+        });
+    };
+}
+
+template <typename Generator, typename Map, typename Op>
+auto benchmark_update()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto gv = make_map<Generator, Map>(n);
+        auto& g = gv.first;
+
+        measure(meter, [&] {
+            auto v = gv.second;
+            for (auto i = 0u; i < n; ++i)
+                v = Op{}(v, g[i], i);
+            return v;
+        });
+    };
+}
+
+template <typename Generator, typename Map, typename Op>
+auto benchmark_update_move()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto gv = make_map<Generator, Map>(n);
+        auto& g = gv.first;
+
+        measure(meter, [&] {
+            auto v = gv.second;
+            for (auto i = 0u; i < n; ++i)
+                v = Op{}(std::move(v), g[i], i);
+            return v;
+        });
+    };
+}
+
+template <typename Generator, typename Map, typename Op>
+auto benchmark_update_mut()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto gv = make_map<Generator, Map>(n);
+        auto& g = gv.first;
+
+        measure(meter, [&] {
+            auto v = gv.second.transient();
+            for (auto i = 0u; i < n; ++i)
+                Op{}(v, g[i], i);
+            return v;
+        });
+    };
+}
+
+} // namespace
@@ -0,0 +1,247 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#ifndef IMMER_BENCHMARK_PERF_COUNTERS
+#define IMMER_BENCHMARK_PERF_COUNTERS 0
+#endif
+
+#if IMMER_BENCHMARK_PERF_COUNTERS && !defined(__linux__)
+#error "perf counters are only available on Linux"
+#endif
+
+#include <algorithm> // missing in nonius
+
+#include <nonius.h++>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#if IMMER_BENCHMARK_PERF_COUNTERS
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/*!
+ * Hardware events counted by `perf_counters`.
+ */
+enum class perf_event
+{
+    cycles,
+    instructions,
+    l1d_misses,
+    llc_misses,
+    dtlb_misses,
+};
+
+constexpr auto perf_event_count = std::size_t{5};
+
+constexpr const char* perf_event_names[perf_event_count] = {
+    "cycles",
+    "instructions",
+    "l1d_misses",
+    "llc_misses",
+    "dtlb_misses",
+};
+
+/*!
+ * Counts of every `perf_event` between a `start()` and a `stop()`.  An event
+ * that the machine or the permissions of the process do not allow counting
+ * is `-1`.
+ */
+using perf_counts = std::array<double, perf_event_count>;
+
+/*!
+ * Reads the hardware performance counters of the calling thread with Linux'
+ * `perf_event_open`, when `IMMER_BENCHMARK_PERF_COUNTERS` is `1`.  Otherwise
+ * it counts nothing, and every event reads as `-1`.
+ *
+ * The events are counted for the calling thread only, in user space.  The
+ * counts are scaled by the time that the kernel actually counted them,
+ * in case there are more events than hardware counters.  Opening the events
+ * may fail, for example, when `/proc/sys/kernel/perf_event_paranoid` is
+ * above `2`, in which case a warning is printed once.
+ */
+class perf_counters
+{
+public:
+    perf_counters() { fds_.fill(-1); }
+
+    /*!
+     * Opens the events, if they were not open already.  Must be called from
+     * the thread that runs the benchmarks.
+     */
+    void open()
+    {
+#if IMMER_BENCHMARK_PERF_COUNTERS
+        if (opened_)
+            return;
+        opened_     = true;
+        auto failed = false;
+        for (auto i = std::size_t{}; i < perf_event_count; ++i) {
+            auto attr = config(static_cast<perf_event>(i));
+            fds_[i]   = static_cast<int>(
+                syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            failed = failed || fds_[i] < 0;
+        }
+        if (failed)
+            std::cerr << "warning: some perf counters are not available, "
+                         "check /proc/sys/kernel/perf_event_paranoid\n";
+#endif
+    }
+
+    ~perf_counters()
+    {
+#if IMMER_BENCHMARK_PERF_COUNTERS
+        for (auto fd : fds_)
+            if (fd >= 0)
+                close(fd);
+#endif
+    }
+
+    perf_counters(const perf_counters&)            = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    /*!
+     * Whether any of the events can be counted.
+     */
+    bool available() const
+    {
+        return std::any_of(
+            fds_.begin(), fds_.end(), [](int fd) { return fd >= 0; });
+    }
+
+    void start()
+    {
+#if IMMER_BENCHMARK_PERF_COUNTERS
+        for (auto fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    perf_counts stop()
+    {
+        auto r = perf_counts{};
+        r.fill(-1);
+#if IMMER_BENCHMARK_PERF_COUNTERS
+        for (auto fd : fds_)
+            if (fd >= 0)
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        for (auto i = std::size_t{}; i < perf_event_count; ++i) {
+            // value, time enabled and time running, see
+            // PERF_FORMAT_TOTAL_TIME_ENABLED and _RUNNING
+            std::uint64_t data[3];
+            if (fds_[i] >= 0 &&
+                read(fds_[i], data, sizeof(data)) == sizeof(data))
+                r[i] = data[2] ? double(data[0]) * data[1] / data[2] : 0;
+        }
+#endif
+        return r;
+    }
+
+private:
+#if IMMER_BENCHMARK_PERF_COUNTERS
+    static perf_event_attr config(perf_event ev)
+    {
+        auto attr = perf_event_attr{};
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        switch (ev) {
+        case perf_event::cycles:
+            attr.type   = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case perf_event::instructions:
+            attr.type   = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case perf_event::l1d_misses:
+            attr.type   = PERF_TYPE_HW_CACHE;
+            attr.config = cache_miss(PERF_COUNT_HW_CACHE_L1D);
+            break;
+        case perf_event::llc_misses:
+            // usually the last level cache, depends on the CPU
+            attr.type   = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case perf_event::dtlb_misses:
+            attr.type   = PERF_TYPE_HW_CACHE;
+            attr.config = cache_miss(PERF_COUNT_HW_CACHE_DTLB);
+            break;
+        }
+        return attr;
+    }
+
+    static std::uint64_t cache_miss(std::uint64_t cache)
+    {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+#endif
+
+    std::array<int, perf_event_count> fds_;
+#if IMMER_BENCHMARK_PERF_COUNTERS
+    bool opened_ = false;
+#endif
+};
+
+/*!
+ * A nonius chronometer that counts the events of the block that the
+ * benchmark measures, instead of timing it.
+ */
+struct perf_chronometer : nonius::detail::chronometer_concept
+{
+    perf_chronometer(perf_counters& c)
+        : counters{c}
+    {}
+
+    void start() override { counters.start(); }
+    void finish() override { counts = counters.stop(); }
+
+    perf_counters& counters;
+    perf_counts counts = {{-1, -1, -1, -1, -1}};
+};
+
+/*!
+ * Runs one more sample of the benchmark in `plan`, returning the events
+ * per iteration of its measured block.  Nonius warms up right before
+ * taking the timed samples, so the counters can not simply be read around
+ * them.
+ */
+inline perf_counts
+measure_perf(perf_counters& counters,
+             const nonius::execution_plan<nonius::fp_seconds>& plan)
+{
+    auto meter = perf_chronometer{counters};
+    plan.benchmark(
+        nonius::chronometer{meter, plan.iterations_per_sample, plan.params});
+    auto r = meter.counts;
+    for (auto& x : r)
+        if (x > 0)
+            x /= plan.iterations_per_sample;
+    return r;
+}
+
+} // anonymous namespace
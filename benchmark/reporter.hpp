@@ -0,0 +1,461 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <algorithm> // missing in nonius
+
+#include <nonius.h++>
+
+#include "benchmark/latency.hpp"
+#include "benchmark/perf_counters.hpp"
+
+#include <immer/config.hpp>
+#include <immer/heap/counting_heap.hpp>
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Number of calls to the global `operator new` so far.  It is defined in
+// `benchmark/allocations.cpp`, together with the replacement of the global
+// allocation functions that counts them.
+std::atomic<std::size_t>& benchmark_allocations();
+
+namespace {
+
+constexpr auto latency_field_count = std::size_t{5};
+
+constexpr const char* latency_field_names[latency_field_count] = {
+    "latency_p50",
+    "latency_p90",
+    "latency_p99",
+    "latency_p999",
+    "latency_max",
+};
+
+/*!
+ * Nonius reporter writing machine readable results, selected with `-r json`.
+ * The output file gets a JSON object with one entry per benchmark and
+ * parameter set, containing:
+ *
+ * - `benchmark`: the title of the run, by default the CMake target name.
+ * - `name`: the full nonius benchmark name, like `"flex/5B"`.
+ * - `container` and `policy`: the name split at its last `/`.  `policy` is
+ *   empty when there is no `/`.
+ * - `N`: the `N` parameter, or `null`, and `params` with all of them.
+ * - `mean` and `stddev`: seconds per iteration, over `samples` samples of
+ *   `iterations` iterations each, and `sample_times` with every sample.
+ * - `allocations`: calls to `operator new` per iteration, including any
+ *   setup the benchmark does for every sample.
+ * - `heap_allocations` and `heap_bytes`: allocations and bytes per iteration
+ *   that went through an `immer::counting_heap`, and `heap_peak_bytes`, the
+ *   most bytes that were live at once above the ones live before measuring.
+ *   They are `null` unless `IMMER_ENABLE_COUNTING_HEAP` is enabled, which
+ *   the `ENABLE_COUNTING_HEAP` CMake option does.
+ * - `cycles`, `instructions`, `l1d_misses`, `llc_misses` and `dtlb_misses`:
+ *   hardware events per iteration, see `perf_counters`, counted in an extra
+ *   sample after the timed ones.  They are `null`
+ *   unless `IMMER_BENCHMARK_PERF_COUNTERS` is enabled, which the
+ *   `BENCHMARK_PERF_COUNTERS` CMake option does, and the kernel allows
+ *   counting them.
+ * - `latency_p50`, `latency_p90`, `latency_p99`, `latency_p999` and
+ *   `latency_max`: percentiles, in seconds, of the single operations that
+ *   the benchmark timed with `timed()`, over all its samples, and
+ *   `latencies`, how many there were.  They are `null` for benchmarks
+ *   that time no single operations.
+ *
+ * The same summary, without `params` and `sample_times`, is written as CSV
+ * next to the output with the `.csv` extension, and the usual nonius HTML
+ * report with the `.html` extension.
+ */
+struct json_reporter : nonius::reporter
+{
+private:
+    struct latency_summary
+    {
+        std::uint64_t count = 0;
+        std::array<double, latency_field_count> seconds;
+    };
+
+    struct result
+    {
+        std::string name;
+        nonius::parameters params;
+        std::vector<double> samples;
+        int iterations;
+        double allocations;
+        double heap_allocations;
+        double heap_bytes;
+        std::size_t heap_peak_bytes;
+        perf_counts perf;
+        latency_summary latency;
+        bool failed;
+    };
+
+    std::string description() override
+    {
+        return "outputs results to JSON, CSV and HTML files";
+    }
+
+    void do_configure(nonius::configuration& cfg) override
+    {
+        perf_.open();
+        title_ = cfg.title;
+        html_.reset();
+        csv_path_.clear();
+        if (!cfg.output_file.empty()) {
+            auto stem  = cfg.output_file;
+            auto dot   = stem.rfind('.');
+            auto slash = stem.rfind('/');
+            if (dot != std::string::npos &&
+                (slash == std::string::npos || dot > slash))
+                stem.erase(dot);
+            auto html_cfg        = cfg;
+            html_cfg.output_file = stem + ".html";
+            csv_path_            = stem + ".csv";
+            html_ = std::make_unique<nonius::html_reporter>();
+            html_->configure(html_cfg);
+        }
+    }
+
+    void do_warmup_start() override { forward(&reporter::warmup_start); }
+    void do_warmup_end(int iterations) override
+    {
+        if (html_)
+            html_->warmup_end(iterations);
+    }
+    void do_estimate_clock_resolution_start() override
+    {
+        forward(&reporter::estimate_clock_resolution_start);
+    }
+    void do_estimate_clock_resolution_complete(
+        nonius::environment_estimate<nonius::fp_seconds> estimate) override
+    {
+        if (html_)
+            html_->estimate_clock_resolution_complete(estimate);
+    }
+    void do_estimate_clock_cost_start() override
+    {
+        forward(&reporter::estimate_clock_cost_start);
+    }
+    void do_estimate_clock_cost_complete(
+        nonius::environment_estimate<nonius::fp_seconds> estimate) override
+    {
+        if (html_)
+            html_->estimate_clock_cost_complete(estimate);
+    }
+
+    void do_suite_start() override { forward(&reporter::suite_start); }
+
+    void do_params_start(nonius::parameters const& params) override
+    {
+        params_ = params;
+        if (html_)
+            html_->params_start(params);
+    }
+
+    void do_benchmark_start(std::string const& name) override
+    {
+        results_.push_back({name, params_, {}, 0, 0, 0, 0, 0, {}, {}, false});
+        if (html_)
+            html_->benchmark_start(name);
+    }
+
+    void do_measurement_start(
+        nonius::execution_plan<nonius::fp_seconds> plan) override
+    {
+        results_.back().iterations = plan.iterations_per_sample;
+        plan_ = std::make_unique<nonius::execution_plan<nonius::fp_seconds>>(
+            plan);
+        allocations_ = benchmark_allocations().load();
+        immer::reset_heap_peak();
+        heap_ = immer::get_heap_stats();
+        benchmark_latencies().reset();
+        if (html_)
+            html_->measurement_start(plan);
+    }
+
+    void do_measurement_complete(
+        std::vector<nonius::fp_seconds> const& samples) override
+    {
+        auto& r      = results_.back();
+        auto iters   = double(r.iterations) * samples.size();
+        auto allocs  = benchmark_allocations().load() - allocations_;
+        auto heap    = immer::get_heap_stats();
+        auto hallocs = heap.allocations - heap_.allocations;
+        auto hbytes  = heap.allocated_bytes - heap_.allocated_bytes;
+
+        r.allocations      = iters > 0 ? allocs / iters : 0;
+        r.heap_allocations = iters > 0 ? hallocs / iters : 0;
+        r.heap_bytes       = iters > 0 ? hbytes / iters : 0;
+        r.heap_peak_bytes  = heap.peak_live_bytes - heap_.live_bytes;
+        r.latency          = summarize(benchmark_latencies());
+        r.perf.fill(-1);
+        if (perf_.available())
+            r.perf = measure_perf(perf_, *plan_);
+        for (auto& s : samples)
+            r.samples.push_back(s.count());
+        if (html_)
+            html_->measurement_complete(samples);
+    }
+
+    void do_analysis_start() override { forward(&reporter::analysis_start); }
+    void do_analysis_complete(
+        nonius::sample_analysis<nonius::fp_seconds> const& analysis) override
+    {
+        if (html_)
+            html_->analysis_complete(analysis);
+    }
+
+    void do_benchmark_failure(std::exception_ptr error) override
+    {
+        results_.back().failed = true;
+        error_stream() << results_.back().name
+                       << " failed to run successfully\n";
+        if (html_)
+            html_->benchmark_failure(error);
+    }
+    void do_benchmark_complete() override
+    {
+        forward(&reporter::benchmark_complete);
+    }
+    void do_params_complete() override { forward(&reporter::params_complete); }
+
+    void do_suite_complete() override
+    {
+        forward(&reporter::suite_complete);
+        write_json(report_stream());
+        if (!csv_path_.empty()) {
+            auto csv = std::ofstream{csv_path_};
+            write_csv(csv);
+        }
+    }
+
+    void forward(void (reporter::*event)())
+    {
+        if (html_)
+            ((*html_).*event)();
+    }
+
+    static double mean(const std::vector<double>& xs)
+    {
+        auto sum = 0.0;
+        for (auto x : xs)
+            sum += x;
+        return xs.empty() ? 0 : sum / xs.size();
+    }
+
+    static double stddev(const std::vector<double>& xs)
+    {
+        if (xs.size() < 2)
+            return 0;
+        auto m   = mean(xs);
+        auto acc = 0.0;
+        for (auto x : xs)
+            acc += (x - m) * (x - m);
+        return std::sqrt(acc / (xs.size() - 1));
+    }
+
+    static latency_summary summarize(const latency_histogram& h)
+    {
+        auto r    = latency_summary{};
+        auto secs = [](std::uint64_t ns) { return ns * 1e-9; };
+        r.count   = h.count();
+        r.seconds = {{secs(h.percentile(0.5)),
+                      secs(h.percentile(0.9)),
+                      secs(h.percentile(0.99)),
+                      secs(h.percentile(0.999)),
+                      secs(h.max())}};
+        return r;
+    }
+
+    static std::string escape(const std::string& s)
+    {
+        auto r = std::string{};
+        for (auto c : s) {
+            if (c == '"' || c == '\\')
+                r += '\\';
+            r += c;
+        }
+        return r;
+    }
+
+    static std::string csv_quote(const std::string& s)
+    {
+        auto r = std::string{"\""};
+        for (auto c : s) {
+            if (c == '"')
+                r += '"';
+            r += c;
+        }
+        return r + '"';
+    }
+
+    static std::string to_string(const nonius::param& p)
+    {
+        auto os = std::ostringstream{};
+        os << p;
+        return os.str();
+    }
+
+    static std::string container_of(const std::string& name)
+    {
+        auto slash = name.rfind('/');
+        return slash == std::string::npos ? name : name.substr(0, slash);
+    }
+
+    static std::string policy_of(const std::string& name)
+    {
+        auto slash = name.rfind('/');
+        return slash == std::string::npos ? "" : name.substr(slash + 1);
+    }
+
+    static std::string n_of(const result& r)
+    {
+        auto it = r.params.find("N");
+        if (it == r.params.end())
+            return "null";
+        auto s = to_string(it->second);
+        auto numeric =
+            !s.empty() && std::all_of(s.begin(), s.end(), [](char c) {
+                return c >= '0' && c <= '9';
+            });
+        return numeric ? s : "\"" + escape(s) + "\"";
+    }
+
+    // The heap counters are only meaningful when the default heap counts
+    template <typename T>
+    static std::string heap_field(T x, const char* none = "null")
+    {
+        if (!IMMER_ENABLE_COUNTING_HEAP)
+            return none;
+        auto os = std::ostringstream{};
+        os << std::setprecision(9) << x;
+        return os.str();
+    }
+
+    // Events that could not be counted are negative
+    static std::string perf_field(double x, const char* none = "null")
+    {
+        if (x < 0)
+            return none;
+        auto os = std::ostringstream{};
+        os << std::setprecision(9) << x;
+        return os.str();
+    }
+
+    // Benchmarks that time no single operation have no latencies
+    static std::string latency_field(const latency_summary& l,
+                                     double x,
+                                     const char* none = "null")
+    {
+        if (!l.count)
+            return none;
+        auto os = std::ostringstream{};
+        os << std::setprecision(9) << x;
+        return os.str();
+    }
+
+    void write_json(std::ostream& os)
+    {
+        os << std::setprecision(9);
+        os << "{\n  \"title\": \"" << escape(title_) << "\",\n";
+        os << "  \"results\": [";
+        auto first = true;
+        for (auto& r : results_) {
+            if (r.failed)
+                continue;
+            os << (first ? "\n" : ",\n");
+            first = false;
+            os << "    {\"benchmark\": \"" << escape(title_) << "\", "
+               << "\"name\": \"" << escape(r.name) << "\", "
+               << "\"container\": \"" << escape(container_of(r.name))
+               << "\", "
+               << "\"policy\": \"" << escape(policy_of(r.name)) << "\", "
+               << "\"N\": " << n_of(r) << ", \"params\": {";
+            auto pfirst = true;
+            for (auto& p : r.params) {
+                os << (pfirst ? "" : ", ") << "\"" << escape(p.first)
+                   << "\": \"" << escape(to_string(p.second)) << "\"";
+                pfirst = false;
+            }
+            os << "}, \"samples\": " << r.samples.size()
+               << ", \"iterations\": " << r.iterations
+               << ", \"mean\": " << mean(r.samples)
+               << ", \"stddev\": " << stddev(r.samples)
+               << ", \"allocations\": " << r.allocations
+               << ", \"heap_allocations\": " << heap_field(r.heap_allocations)
+               << ", \"heap_bytes\": " << heap_field(r.heap_bytes)
+               << ", \"heap_peak_bytes\": " << heap_field(r.heap_peak_bytes);
+            for (auto i = std::size_t{}; i < perf_event_count; ++i)
+                os << ", \"" << perf_event_names[i]
+                   << "\": " << perf_field(r.perf[i]);
+            os << ", \"latencies\": " << r.latency.count;
+            for (auto i = std::size_t{}; i < latency_field_count; ++i)
+                os << ", \"" << latency_field_names[i]
+                   << "\": " << latency_field(r.latency, r.latency.seconds[i]);
+            os << ", \"sample_times\": [";
+            for (auto i = std::size_t{}; i < r.samples.size(); ++i)
+                os << (i ? ", " : "") << r.samples[i];
+            os << "]}";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+    void write_csv(std::ostream& os)
+    {
+        os << std::setprecision(9);
+        os << "benchmark,container,policy,N,samples,mean,stddev,allocations,"
+              "heap_allocations,heap_bytes,heap_peak_bytes";
+        for (auto name : perf_event_names)
+            os << ',' << name;
+        os << ",latencies";
+        for (auto name : latency_field_names)
+            os << ',' << name;
+        os << '\n';
+        for (auto& r : results_) {
+            if (r.failed)
+                continue;
+            auto n = n_of(r);
+            os << csv_quote(title_) << ',' << csv_quote(container_of(r.name))
+               << ',' << csv_quote(policy_of(r.name)) << ','
+               << (n == "null" ? "" : n) << ',' << r.samples.size() << ','
+               << mean(r.samples) << ',' << stddev(r.samples) << ','
+               << r.allocations << ',' << heap_field(r.heap_allocations, "")
+               << ',' << heap_field(r.heap_bytes, "") << ','
+               << heap_field(r.heap_peak_bytes, "");
+            for (auto x : r.perf)
+                os << ',' << perf_field(x, "");
+            os << ',' << r.latency.count;
+            for (auto x : r.latency.seconds)
+                os << ',' << latency_field(r.latency, x, "");
+            os << '\n';
+        }
+    }
+
+    std::string title_;
+    std::string csv_path_;
+    std::unique_ptr<nonius::html_reporter> html_;
+    nonius::parameters params_;
+    std::vector<result> results_;
+    std::size_t allocations_ = 0;
+    immer::heap_stats heap_;
+    perf_counters perf_;
+    std::unique_ptr<nonius::execution_plan<nonius::fp_seconds>> plan_;
+};
+
+NONIUS_REPORTER("json", json_reporter);
+
+} // anonymous namespace
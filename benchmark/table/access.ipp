@@ -0,0 +1,33 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include "access.hpp"
+
+#ifndef GENERATOR_T
+#error "you must define a GENERATOR_T"
+#endif
+
+using generator__ = GENERATOR_T;
+using t__         = typename decltype(generator__{}(0))::value_type;
+
+// clang-format off
+
+NONIUS_BENCHMARK("std::unordered_map", benchmark_access_std<generator__, std::unordered_map<t__, table_entry<t__>>>())
+NONIUS_BENCHMARK("boost::flat_map", benchmark_access_std<generator__, boost::container::flat_map<t__, table_entry<t__>>>())
+NONIUS_BENCHMARK("immer::table/5B", benchmark_access<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>>())
+NONIUS_BENCHMARK("immer::table/4B", benchmark_access<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>>())
+
+NONIUS_BENCHMARK("find/immer::table/5B", benchmark_access_find<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>>())
+NONIUS_BENCHMARK("find/immer::table/4B", benchmark_access_find<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>>())
+
+NONIUS_BENCHMARK("bad/std::unordered_map", benchmark_bad_access_std<generator__, std::unordered_map<t__, table_entry<t__>>>())
+NONIUS_BENCHMARK("bad/boost::flat_map", benchmark_bad_access_std<generator__, boost::container::flat_map<t__, table_entry<t__>>>())
+NONIUS_BENCHMARK("bad/immer::table/5B", benchmark_bad_access<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>>())
+NONIUS_BENCHMARK("bad/immer::table/4B", benchmark_bad_access<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>>())
+
+// clang-format on
@@ -0,0 +1,55 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include "benchmark/config.hpp"
+
+#include <boost/container/flat_map.hpp>
+#include <immer/table.hpp>
+#include <immer/table_transient.hpp>
+#include <unordered_map>
+
+namespace {
+
+// Values stored in the tables, keyed by `id` like `immer::table_key_fn`
+// expects.  The other containers map the `id` to the whole entry.
+template <typename K>
+struct table_entry
+{
+    K id;
+    unsigned value;
+};
+
+template <typename K>
+table_entry<K> make_entry(const K& k, unsigned value)
+{
+    return {k, value};
+}
+
+// Fills an `std::unordered_map` or `boost::container::flat_map`.
+template <typename Map, typename Generator>
+Map make_std_table(const Generator& g, std::size_t n)
+{
+    auto v = Map{};
+    for (auto i = 0u; i < n; ++i)
+        v[g[i]] = make_entry(g[i], i);
+    return v;
+}
+
+// Fills an `immer::table`, using a transient.
+template <typename Table, typename Generator>
+Table make_table(const Generator& g, std::size_t n)
+{
+    auto v = Table{}.transient();
+    for (auto i = 0u; i < n; ++i)
+        v.insert(make_entry(g[i], i));
+    return v.persistent();
+}
+
+} // namespace
@@ -0,0 +1,83 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include "entry.hpp"
+
+namespace {
+
+template <typename Generator, typename Map>
+auto benchmark_erase_mut_std()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g  = Generator{}(n);
+        auto v_ = make_std_table<Map>(g, n);
+
+        measure(meter, [&] {
+            auto v = v_;
+            for (auto i = 0u; i < n; ++i)
+                v.erase(g[i]);
+            return v;
+        });
+    };
+}
+
+template <typename Generator, typename Table>
+auto benchmark_erase_mut()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g  = Generator{}(n);
+        auto v_ = make_table<Table>(g, n);
+
+        measure(meter, [&] {
+            auto v = v_.transient();
+            for (auto i = 0u; i < n; ++i)
+                v.erase(g[i]);
+            return v;
+        });
+    };
+}
+
+template <typename Generator, typename Table>
+auto benchmark_erase()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g  = Generator{}(n);
+        auto v_ = make_table<Table>(g, n);
+
+        measure(meter, [&] {
+            auto v = v_;
+            for (auto i = 0u; i < n; ++i)
+                v = v.erase(g[i]);
+            return v;
+        });
+    };
+}
+
+template <typename Generator, typename Table>
+auto benchmark_erase_move()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g  = Generator{}(n);
+        auto v_ = make_table<Table>(g, n);
+
+        measure(meter, [&] {
+            auto v = v_;
+            for (auto i = 0u; i < n; ++i)
+                v = std::move(v).erase(g[i]);
+            return v;
+        });
+    };
+}
+
+} // namespace
@@ -0,0 +1,81 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include "entry.hpp"
+
+#include <immer/algorithm.hpp>
+#include <numeric>
+
+namespace {
+
+struct iter_step
+{
+    template <typename K>
+    unsigned operator()(unsigned x, const table_entry<K>& y) const
+    {
+        return x + y.value;
+    }
+
+    template <typename KV>
+    auto operator()(unsigned x, const KV& kv) const
+        -> decltype(x + kv.second.value)
+    {
+        return x + kv.second.value;
+    }
+};
+
+template <typename Generator, typename Map>
+auto benchmark_access_std_iter()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g1 = Generator{}(n);
+        auto v  = make_std_table<Map>(g1, n);
+
+        measure(meter, [&] {
+            volatile auto c =
+                std::accumulate(v.begin(), v.end(), 0u, iter_step{});
+            return c;
+        });
+    };
+}
+
+template <typename Generator, typename Table>
+auto benchmark_access_reduce()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g1 = Generator{}(n);
+        auto v  = make_table<Table>(g1, n);
+
+        measure(meter, [&] {
+            volatile auto c = immer::accumulate(v, 0u, iter_step{});
+            return c;
+        });
+    };
+}
+
+template <typename Generator, typename Table>
+auto benchmark_access_iter()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g1 = Generator{}(n);
+        auto v  = make_table<Table>(g1, n);
+
+        measure(meter, [&] {
+            volatile auto c =
+                std::accumulate(v.begin(), v.end(), 0u, iter_step{});
+            return c;
+        });
+    };
+}
+
+} // namespace
@@ -0,0 +1,122 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include "entry.hpp"
+
+namespace {
+
+// Operations modifying the entry of a key that is already in the table.  They
+// work both on persistent tables, returning the new version, and on
+// transients, updating them in place.
+struct increment_entry
+{
+    template <typename T>
+    T operator()(T x) const
+    {
+        ++x.value;
+        return x;
+    }
+};
+
+struct update_op
+{
+    template <typename Table, typename K>
+    auto operator()(Table&& v, const K& k, unsigned) const
+    {
+        return std::forward<Table>(v).update(k, increment_entry{});
+    }
+};
+
+struct update_if_exists_op
+{
+    template <typename Table, typename K>
+    auto operator()(Table&& v, const K& k, unsigned) const
+    {
+        return std::forward<Table>(v).update_if_exists(k, increment_entry{});
+    }
+};
+
+struct insert_op
+{
+    template <typename Table, typename K>
+    auto operator()(Table&& v, const K& k, unsigned i) const
+    {
+        return std::forward<Table>(v).insert(make_entry(k, i));
+    }
+};
+
+template <typename Generator, typename Map>
+auto benchmark_update_std()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+        auto g = Generator{}(n);
+        auto v = make_std_table<Map>(g, n);
+
+        measure(meter, [&] {
+            for (auto i = 0u; i < n; ++i)
+                ++v.find(g[i])->second.value;
+            return v.size();
+        });
+    };
+}
+
+template <typename Generator, typename Table, typename Op>
+auto benchmark_update()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g  = Generator{}(n);
+        auto v_ = make_table<Table>(g, n);
+
+        measure(meter, [&] {
+            auto v = v_;
+            for (auto i = 0u; i < n; ++i)
+                v = Op{}(v, g[i], i);
+            return v;
+        });
+    };
+}
+
+template <typename Generator, typename Table, typename Op>
+auto benchmark_update_move()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g  = Generator{}(n);
+        auto v_ = make_table<Table>(g, n);
+
+        measure(meter, [&] {
+            auto v = v_;
+            for (auto i = 0u; i < n; ++i)
+                v = Op{}(std::move(v), g[i], i);
+            return v;
+        });
+    };
+}
+
+template <typename Generator, typename Table, typename Op>
+auto benchmark_update_mut()
+{
+    return [](nonius::chronometer meter) {
+        auto n  = meter.param<N>();
+        auto g  = Generator{}(n);
+        auto v_ = make_table<Table>(g, n);
+
+        measure(meter, [&] {
+            auto v = v_.transient();
+            for (auto i = 0u; i < n; ++i)
+                Op{}(v, g[i], i);
+            return v;
+        });
+    };
+}
+
+} // namespace
@@ -0,0 +1,76 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include "update.hpp"
+
+#ifndef GENERATOR_T
+#error "you must define a GENERATOR_T"
+#endif
+
+using generator__ = GENERATOR_T;
+using t__         = typename decltype(generator__{}(0))::value_type;
+
+// clang-format off
+NONIUS_BENCHMARK("update/std::unordered_map", benchmark_update_std<generator__, std::unordered_map<t__, table_entry<t__>>>())
+NONIUS_BENCHMARK("update/boost::flat_map", benchmark_update_std<generator__, boost::container::flat_map<t__, table_entry<t__>>>())
+
+NONIUS_BENCHMARK("update/immer::table/5B", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>, update_op>())
+NONIUS_BENCHMARK("update/immer::table/4B", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>, update_op>())
+#ifndef DISABLE_GC_BENCHMARKS
+NONIUS_BENCHMARK("update/immer::table/GC", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,gc_memory,5>, update_op>())
+#endif
+NONIUS_BENCHMARK("update/immer::table/UN", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,unsafe_memory,5>, update_op>())
+
+NONIUS_BENCHMARK("update/immer::table/move/5B", benchmark_update_move<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>, update_op>())
+NONIUS_BENCHMARK("update/immer::table/move/4B", benchmark_update_move<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>, update_op>())
+NONIUS_BENCHMARK("update/immer::table/move/UN", benchmark_update_move<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,unsafe_memory,5>, update_op>())
+
+NONIUS_BENCHMARK("update/immer::table/tran/5B", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>, update_op>())
+NONIUS_BENCHMARK("update/immer::table/tran/4B", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>, update_op>())
+#ifndef DISABLE_GC_BENCHMARKS
+NONIUS_BENCHMARK("update/immer::table/tran/GC", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,gc_memory,5>, update_op>())
+#endif
+NONIUS_BENCHMARK("update/immer::table/tran/UN", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,unsafe_memory,5>, update_op>())
+
+NONIUS_BENCHMARK("update_if_exists/immer::table/5B", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>, update_if_exists_op>())
+NONIUS_BENCHMARK("update_if_exists/immer::table/4B", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>, update_if_exists_op>())
+#ifndef DISABLE_GC_BENCHMARKS
+NONIUS_BENCHMARK("update_if_exists/immer::table/GC", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,gc_memory,5>, update_if_exists_op>())
+#endif
+NONIUS_BENCHMARK("update_if_exists/immer::table/UN", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,unsafe_memory,5>, update_if_exists_op>())
+
+NONIUS_BENCHMARK("update_if_exists/immer::table/move/5B", benchmark_update_move<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>, update_if_exists_op>())
+NONIUS_BENCHMARK("update_if_exists/immer::table/move/4B", benchmark_update_move<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>, update_if_exists_op>())
+NONIUS_BENCHMARK("update_if_exists/immer::table/move/UN", benchmark_update_move<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,unsafe_memory,5>, update_if_exists_op>())
+
+NONIUS_BENCHMARK("update_if_exists/immer::table/tran/5B", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>, update_if_exists_op>())
+NONIUS_BENCHMARK("update_if_exists/immer::table/tran/4B", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>, update_if_exists_op>())
+#ifndef DISABLE_GC_BENCHMARKS
+NONIUS_BENCHMARK("update_if_exists/immer::table/tran/GC", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,gc_memory,5>, update_if_exists_op>())
+#endif
+NONIUS_BENCHMARK("update_if_exists/immer::table/tran/UN", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,unsafe_memory,5>, update_if_exists_op>())
+
+NONIUS_BENCHMARK("insert/immer::table/5B", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>, insert_op>())
+NONIUS_BENCHMARK("insert/immer::table/4B", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>, insert_op>())
+#ifndef DISABLE_GC_BENCHMARKS
+NONIUS_BENCHMARK("insert/immer::table/GC", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,gc_memory,5>, insert_op>())
+#endif
+NONIUS_BENCHMARK("insert/immer::table/UN", benchmark_update<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,unsafe_memory,5>, insert_op>())
+
+NONIUS_BENCHMARK("insert/immer::table/move/5B", benchmark_update_move<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>, insert_op>())
+NONIUS_BENCHMARK("insert/immer::table/move/4B", benchmark_update_move<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>, insert_op>())
+NONIUS_BENCHMARK("insert/immer::table/move/UN", benchmark_update_move<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,unsafe_memory,5>, insert_op>())
+
+NONIUS_BENCHMARK("insert/immer::table/tran/5B", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,5>, insert_op>())
+NONIUS_BENCHMARK("insert/immer::table/tran/4B", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,def_memory,4>, insert_op>())
+#ifndef DISABLE_GC_BENCHMARKS
+NONIUS_BENCHMARK("insert/immer::table/tran/GC", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,gc_memory,5>, insert_op>())
+#endif
+NONIUS_BENCHMARK("insert/immer::table/tran/UN", benchmark_update_mut<generator__, immer::table<table_entry<t__>, immer::table_key_fn, std::hash<t__>,std::equal_to<t__>,unsafe_memory,5>, insert_op>())
+
+// clang-format on
@@ -0,0 +1,158 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include "benchmark/vector/common.hpp"
+
+#include <immer/algorithm.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+template <typename Vektor>
+Vektor make_kernel_vector(std::size_t n)
+{
+    using value_t = typename Vektor::value_type;
+    auto t        = Vektor{}.transient();
+    for (auto i = 0u; i < n; ++i)
+        t.push_back(static_cast<value_t>(i % 1021));
+    return t.persistent();
+}
+
+// The generic path that the algorithms used before, visiting every chunk
+// with the standard algorithm.
+
+template <typename Vektor>
+auto benchmark_sum_generic()
+{
+    return [](nonius::chronometer meter) {
+        using value_t = typename Vektor::value_type;
+        auto v        = make_kernel_vector<Vektor>(meter.param<N>());
+        measure(meter, [&] {
+            auto r = value_t{};
+            immer::for_each_chunk(v, [&](auto f, auto l) {
+                r = std::accumulate(f, l, r);
+            });
+            volatile auto x = r;
+            return x;
+        });
+    };
+}
+
+template <typename Vektor>
+auto benchmark_sum()
+{
+    return [](nonius::chronometer meter) {
+        using value_t = typename Vektor::value_type;
+        auto v        = make_kernel_vector<Vektor>(meter.param<N>());
+        measure(meter, [&] {
+            volatile auto x = immer::accumulate(v, value_t{});
+            return x;
+        });
+    };
+}
+
+template <typename Vektor>
+auto benchmark_count_generic()
+{
+    return [](nonius::chronometer meter) {
+        using value_t = typename Vektor::value_type;
+        auto v        = make_kernel_vector<Vektor>(meter.param<N>());
+        measure(meter, [&] {
+            auto r = std::ptrdiff_t{};
+            immer::for_each_chunk(v, [&](auto f, auto l) {
+                r += std::count_if(
+                    f, l, [](auto x) { return x < value_t{100}; });
+            });
+            volatile auto x = r;
+            return x;
+        });
+    };
+}
+
+template <typename Vektor>
+auto benchmark_count()
+{
+    return [](nonius::chronometer meter) {
+        using value_t = typename Vektor::value_type;
+        auto v        = make_kernel_vector<Vektor>(meter.param<N>());
+        measure(meter, [&] {
+            volatile auto x = immer::count_if(
+                v, [](auto x) { return x < value_t{100}; });
+            return x;
+        });
+    };
+}
+
+template <typename Vektor>
+auto benchmark_find_generic()
+{
+    return [](nonius::chronometer meter) {
+        using value_t = typename Vektor::value_type;
+        auto v        = make_kernel_vector<Vektor>(meter.param<N>());
+        measure(meter, [&] {
+            auto n = std::size_t{};
+            immer::for_each_chunk_p(v, [&](auto f, auto l) {
+                auto p = std::find(f, l, value_t{2000});
+                n += p - f;
+                return p == l;
+            });
+            volatile auto x = n;
+            return x;
+        });
+    };
+}
+
+template <typename Vektor>
+auto benchmark_find()
+{
+    return [](nonius::chronometer meter) {
+        using value_t = typename Vektor::value_type;
+        auto v        = make_kernel_vector<Vektor>(meter.param<N>());
+        measure(meter, [&] {
+            volatile auto x = immer::find(v, value_t{2000}).index();
+            return x;
+        });
+    };
+}
+
+template <typename Vektor>
+auto benchmark_min_generic()
+{
+    return [](nonius::chronometer meter) {
+        using value_t = typename Vektor::value_type;
+        auto v        = make_kernel_vector<Vektor>(meter.param<N>());
+        measure(meter, [&] {
+            auto best = static_cast<const value_t*>(nullptr);
+            immer::for_each_chunk(v, [&](auto f, auto l) {
+                auto p = std::min_element(f, l);
+                if (p != l && (!best || *p < *best))
+                    best = p;
+            });
+            volatile auto x = *best;
+            return x;
+        });
+    };
+}
+
+template <typename Vektor>
+auto benchmark_min()
+{
+    return [](nonius::chronometer meter) {
+        auto v = make_kernel_vector<Vektor>(meter.param<N>());
+        measure(meter, [&] {
+            volatile auto x = *immer::min_element(v);
+            return x;
+        });
+    };
+}
+
+} // anonymous namespace
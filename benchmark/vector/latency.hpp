@@ -0,0 +1,89 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include "benchmark/latency.hpp"
+#include "benchmark/vector/common.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+// Largest slice that `benchmark_concat_latency` appends at once
+constexpr auto latency_concat_max_slice = 100u;
+
+template <typename Vektor, typename PushFn = push_back_fn>
+auto benchmark_push_latency()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+
+        measure(meter, [&] {
+            auto v = Vektor{};
+            for (auto i = 0u; i < n; ++i)
+                v = timed([&] { return PushFn{}(v, i); });
+            return v;
+        });
+    };
+}
+
+template <typename Vektor, typename PushFn = push_back_fn>
+auto benchmark_assoc_latency()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+        auto g = make_generator(n);
+
+        auto v = Vektor{};
+        for (auto i = 0u; i < n; ++i)
+            v = PushFn{}(std::move(v), i);
+
+        measure(meter, [&] {
+            auto r = v;
+            for (auto i = 0u; i < n; ++i)
+                r = timed([&] { return r.set(g[i], i); });
+            return r;
+        });
+    };
+}
+
+// Builds a vector of `N` elements by appending slices of random sizes of
+// another one, such that most concatenations have to rebalance relaxed
+// nodes.
+template <typename Vektor>
+auto benchmark_concat_latency()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+
+        auto v = Vektor{};
+        for (auto i = 0u; i < n; ++i)
+            v = v.push_back(i);
+
+        auto engine = std::default_random_engine{42};
+        auto dist   = std::uniform_int_distribution<std::size_t>{
+            1, latency_concat_max_slice};
+        auto slices = std::vector<Vektor>{};
+        for (auto size = std::size_t{}; size < n;) {
+            auto first = size;
+            size       = std::min<std::size_t>(n, size + dist(engine));
+            slices.push_back(v.drop(first).take(size - first));
+        }
+
+        measure(meter, [&] {
+            auto r = Vektor{};
+            for (auto& s : slices)
+                r = timed([&] { return r + s; });
+            return r;
+        });
+    };
+}
+
+} // anonymous namespace
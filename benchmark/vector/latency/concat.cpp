@@ -0,0 +1,20 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include "benchmark/vector/latency.hpp"
+
+#include <immer/flex_vector.hpp>
+
+// clang-format off
+
+NONIUS_BENCHMARK("flex/basic",  benchmark_concat_latency<immer::flex_vector<unsigned,basic_memory>>())
+NONIUS_BENCHMARK("flex/safe",   benchmark_concat_latency<immer::flex_vector<unsigned,def_memory>>())
+NONIUS_BENCHMARK("flex/unsafe", benchmark_concat_latency<immer::flex_vector<unsigned,unsafe_memory>>())
+NONIUS_BENCHMARK("flex/gc",     benchmark_concat_latency<immer::flex_vector<unsigned,gc_memory>>())
+
+// clang-format on
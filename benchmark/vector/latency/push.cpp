@@ -0,0 +1,31 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include "benchmark/vector/latency.hpp"
+
+#include <immer/flex_vector.hpp>
+#include <immer/vector.hpp>
+
+// clang-format off
+
+NONIUS_BENCHMARK("vector/basic",  benchmark_push_latency<immer::vector<unsigned,basic_memory>>())
+NONIUS_BENCHMARK("vector/safe",   benchmark_push_latency<immer::vector<unsigned,def_memory>>())
+NONIUS_BENCHMARK("vector/unsafe", benchmark_push_latency<immer::vector<unsigned,unsafe_memory>>())
+NONIUS_BENCHMARK("vector/gc",     benchmark_push_latency<immer::vector<unsigned,gc_memory>>())
+
+NONIUS_BENCHMARK("flex/basic",    benchmark_push_latency<immer::flex_vector<unsigned,basic_memory>>())
+NONIUS_BENCHMARK("flex/safe",     benchmark_push_latency<immer::flex_vector<unsigned,def_memory>>())
+NONIUS_BENCHMARK("flex/unsafe",   benchmark_push_latency<immer::flex_vector<unsigned,unsafe_memory>>())
+NONIUS_BENCHMARK("flex/gc",       benchmark_push_latency<immer::flex_vector<unsigned,gc_memory>>())
+
+NONIUS_BENCHMARK("flex_f/basic",  benchmark_push_latency<immer::flex_vector<unsigned,basic_memory>, push_front_fn>())
+NONIUS_BENCHMARK("flex_f/safe",   benchmark_push_latency<immer::flex_vector<unsigned,def_memory>, push_front_fn>())
+NONIUS_BENCHMARK("flex_f/unsafe", benchmark_push_latency<immer::flex_vector<unsigned,unsafe_memory>, push_front_fn>())
+NONIUS_BENCHMARK("flex_f/gc",     benchmark_push_latency<immer::flex_vector<unsigned,gc_memory>, push_front_fn>())
+
+// clang-format on
@@ -0,0 +1,38 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include "benchmark/vector/kernels.hpp"
+
+#include <immer/vector.hpp>
+#include <immer/vector_transient.hpp>
+
+#include <cstdint>
+
+// clang-format off
+
+NONIUS_BENCHMARK("sum/generic/int", benchmark_sum_generic<immer::vector<std::int32_t>>())
+NONIUS_BENCHMARK("sum/immer/int", benchmark_sum<immer::vector<std::int32_t>>())
+NONIUS_BENCHMARK("sum/generic/i64", benchmark_sum_generic<immer::vector<std::int64_t>>())
+NONIUS_BENCHMARK("sum/immer/i64", benchmark_sum<immer::vector<std::int64_t>>())
+NONIUS_BENCHMARK("sum/generic/float", benchmark_sum_generic<immer::vector<float>>())
+NONIUS_BENCHMARK("sum/immer/float", benchmark_sum<immer::vector<float>>())
+
+NONIUS_BENCHMARK("count/generic/int", benchmark_count_generic<immer::vector<std::int32_t>>())
+NONIUS_BENCHMARK("count/immer/int", benchmark_count<immer::vector<std::int32_t>>())
+NONIUS_BENCHMARK("count/generic/float", benchmark_count_generic<immer::vector<float>>())
+NONIUS_BENCHMARK("count/immer/float", benchmark_count<immer::vector<float>>())
+
+NONIUS_BENCHMARK("find/generic/int", benchmark_find_generic<immer::vector<std::int32_t>>())
+NONIUS_BENCHMARK("find/immer/int", benchmark_find<immer::vector<std::int32_t>>())
+NONIUS_BENCHMARK("find/generic/float", benchmark_find_generic<immer::vector<float>>())
+NONIUS_BENCHMARK("find/immer/float", benchmark_find<immer::vector<float>>())
+
+NONIUS_BENCHMARK("min/generic/int", benchmark_min_generic<immer::vector<std::int32_t>>())
+NONIUS_BENCHMARK("min/immer/int", benchmark_min<immer::vector<std::int32_t>>())
+
+// clang-format on
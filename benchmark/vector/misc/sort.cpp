@@ -0,0 +1,30 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include "benchmark/vector/sort.hpp"
+
+#include <immer/flex_vector.hpp>
+#include <immer/flex_vector_transient.hpp>
+#include <immer/refcount/unsafe_refcount_policy.hpp>
+
+// clang-format off
+
+NONIUS_BENCHMARK("std/flex", benchmark_sort_std<immer::flex_vector<unsigned,def_memory,5>>())
+NONIUS_BENCHMARK("seq/flex", benchmark_sort<immer::flex_vector<unsigned,def_memory,5>>())
+NONIUS_BENCHMARK("seq/flex/UN", benchmark_sort<immer::flex_vector<unsigned,unsafe_memory,5>>())
+NONIUS_BENCHMARK("par/flex", benchmark_sort<immer::flex_vector<unsigned,def_memory,5>, immer::async_executor>())
+
+NONIUS_BENCHMARK("s/std/flex", benchmark_stable_sort_std<immer::flex_vector<unsigned,def_memory,5>>())
+NONIUS_BENCHMARK("s/seq/flex", benchmark_stable_sort<immer::flex_vector<unsigned,def_memory,5>>())
+NONIUS_BENCHMARK("s/par/flex", benchmark_stable_sort<immer::flex_vector<unsigned,def_memory,5>, immer::async_executor>())
+
+NONIUS_BENCHMARK("p/std/flex", benchmark_partial_sort_std<immer::flex_vector<unsigned,def_memory,5>>())
+NONIUS_BENCHMARK("p/seq/flex", benchmark_partial_sort<immer::flex_vector<unsigned,def_memory,5>>())
+NONIUS_BENCHMARK("p/par/flex", benchmark_partial_sort<immer::flex_vector<unsigned,def_memory,5>, immer::async_executor>())
+
+// clang-format on
@@ -0,0 +1,111 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include "benchmark/vector/common.hpp"
+
+#include <immer/sort.hpp>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename Vektor>
+Vektor make_shuffled_vector(std::size_t n)
+{
+    auto engine = std::default_random_engine{42};
+    auto dist   = std::uniform_int_distribution<unsigned>{};
+    auto t      = Vektor{}.transient();
+    for (auto i = 0u; i < n; ++i)
+        t.push_back(dist(engine));
+    return t.persistent();
+}
+
+template <typename Vektor>
+auto benchmark_sort_std()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+        auto v = make_shuffled_vector<Vektor>(n);
+        measure(meter, [&] {
+            auto s = std::vector<typename Vektor::value_type>(v.begin(),
+                                                              v.end());
+            std::sort(s.begin(), s.end());
+            return Vektor(s.begin(), s.end());
+        });
+    };
+}
+
+template <typename Vektor>
+auto benchmark_stable_sort_std()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+        auto v = make_shuffled_vector<Vektor>(n);
+        measure(meter, [&] {
+            auto s = std::vector<typename Vektor::value_type>(v.begin(),
+                                                              v.end());
+            std::stable_sort(s.begin(), s.end());
+            return Vektor(s.begin(), s.end());
+        });
+    };
+}
+
+template <typename Vektor>
+auto benchmark_partial_sort_std()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+        auto v = make_shuffled_vector<Vektor>(n);
+        measure(meter, [&] {
+            auto s = std::vector<typename Vektor::value_type>(v.begin(),
+                                                              v.end());
+            std::partial_sort(s.begin(), s.begin() + n / 10, s.end());
+            return Vektor(s.begin(), s.end());
+        });
+    };
+}
+
+template <typename Vektor, typename Executor = immer::sequential_executor>
+auto benchmark_sort()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+        auto v = make_shuffled_vector<Vektor>(n);
+        measure(meter,
+                [&] { return immer::sort(v, std::less<>{}, Executor{}); });
+    };
+}
+
+template <typename Vektor, typename Executor = immer::sequential_executor>
+auto benchmark_stable_sort()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+        auto v = make_shuffled_vector<Vektor>(n);
+        measure(meter, [&] {
+            return immer::stable_sort(v, std::less<>{}, Executor{});
+        });
+    };
+}
+
+template <typename Vektor, typename Executor = immer::sequential_executor>
+auto benchmark_partial_sort()
+{
+    return [](nonius::chronometer meter) {
+        auto n = meter.param<N>();
+        auto v = make_shuffled_vector<Vektor>(n);
+        measure(meter, [&] {
+            return immer::partial_sort(v, n / 10, std::less<>{}, Executor{});
+        });
+    };
+}
+
+} // anonymous namespace
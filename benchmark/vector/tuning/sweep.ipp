@@ -0,0 +1,102 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+// Measures the main operations over flex_vectors of ELEM_T for a grid of
+// inner and leaf branching factors, next to the `tuned_flex_vector` for
+// various leaf sizes.  Comparing the reports of various element types on a
+// given machine tells what `default_leaf_cache_lines` should be.
+
+#include "benchmark/vector/access.hpp"
+#include "benchmark/vector/assoc.hpp"
+#include "benchmark/vector/concat.hpp"
+#include "benchmark/vector/push.hpp"
+
+#include <immer/flex_vector.hpp>
+#include <immer/tuned.hpp>
+
+#ifndef ELEM_T
+#error "define the ELEM_T"
+#endif
+
+namespace {
+
+/*!
+ * An element of `Size` bytes that behaves like an `unsigned`, such that it
+ * can be used with the vector benchmarks.
+ */
+template <std::size_t Size>
+struct padded
+{
+    static_assert(Size >= sizeof(unsigned), "");
+
+    unsigned value;
+    char padding[Size - sizeof(unsigned)];
+
+    padded(unsigned v = 0)
+        : value{v}
+    {}
+
+    operator unsigned() const { return value; }
+};
+
+} // namespace
+
+#define IMMER_SWEEP_NAME(op, B, BL) op "/B" #B "-BL" #BL
+
+#define IMMER_SWEEP_T(B, BL) immer::flex_vector<ELEM_T, def_memory, B, BL>
+
+#define IMMER_SWEEP(B, BL)                                                     \
+    NONIUS_BENCHMARK(IMMER_SWEEP_NAME("access", B, BL),                        \
+                     benchmark_access_idx<IMMER_SWEEP_T(B, BL)>())             \
+    NONIUS_BENCHMARK(IMMER_SWEEP_NAME("iter", B, BL),                          \
+                     benchmark_access_iter<IMMER_SWEEP_T(B, BL)>())            \
+    NONIUS_BENCHMARK(IMMER_SWEEP_NAME("push", B, BL),                          \
+                     benchmark_push<IMMER_SWEEP_T(B, BL)>())                   \
+    NONIUS_BENCHMARK(IMMER_SWEEP_NAME("assoc", B, BL),                         \
+                     benchmark_assoc<IMMER_SWEEP_T(B, BL)>())                  \
+    NONIUS_BENCHMARK(IMMER_SWEEP_NAME("concat", B, BL),                        \
+                     benchmark_concat<IMMER_SWEEP_T(B, BL)>())
+
+#define IMMER_SWEEP_TUNED_T(L)                                                 \
+    immer::tuned_flex_vector<ELEM_T, def_memory, L>
+
+#define IMMER_SWEEP_TUNED(L)                                                   \
+    NONIUS_BENCHMARK("access/tuned-" #L,                                       \
+                     benchmark_access_idx<IMMER_SWEEP_TUNED_T(L)>())           \
+    NONIUS_BENCHMARK("iter/tuned-" #L,                                         \
+                     benchmark_access_iter<IMMER_SWEEP_TUNED_T(L)>())          \
+    NONIUS_BENCHMARK("push/tuned-" #L,                                         \
+                     benchmark_push<IMMER_SWEEP_TUNED_T(L)>())                 \
+    NONIUS_BENCHMARK("assoc/tuned-" #L,                                        \
+                     benchmark_assoc<IMMER_SWEEP_TUNED_T(L)>())                \
+    NONIUS_BENCHMARK("concat/tuned-" #L,                                       \
+                     benchmark_concat<IMMER_SWEEP_TUNED_T(L)>())
+
+IMMER_SWEEP(4, 2)
+IMMER_SWEEP(4, 3)
+IMMER_SWEEP(4, 4)
+IMMER_SWEEP(4, 5)
+IMMER_SWEEP(4, 6)
+IMMER_SWEEP(4, 7)
+IMMER_SWEEP(5, 2)
+IMMER_SWEEP(5, 3)
+IMMER_SWEEP(5, 4)
+IMMER_SWEEP(5, 5)
+IMMER_SWEEP(5, 6)
+IMMER_SWEEP(5, 7)
+IMMER_SWEEP(6, 2)
+IMMER_SWEEP(6, 3)
+IMMER_SWEEP(6, 4)
+IMMER_SWEEP(6, 5)
+IMMER_SWEEP(6, 6)
+IMMER_SWEEP(6, 7)
+
+IMMER_SWEEP_TUNED(1)
+IMMER_SWEEP_TUNED(2)
+IMMER_SWEEP_TUNED(4)
+IMMER_SWEEP_TUNED(8)
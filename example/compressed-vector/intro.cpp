@@ -0,0 +1,34 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <cassert>
+#include <cstdint>
+
+// include:intro/start
+#include <immer/algorithm.hpp>
+#include <immer/compressed_vector.hpp>
+#include <immer/compressed_vector_transient.hpp>
+
+int main()
+{
+    auto t = immer::compressed_vector<std::uint64_t>{}.transient();
+    for (auto i = std::uint64_t{}; i < 10000; ++i)
+        t.push_back(1500000000 + i * 60);
+    const auto v0 = t.persistent();
+    assert(v0.size() == 10000);
+    assert(v0[10] == 1500000600);
+    assert(v0.data_bytes() < 10000 * sizeof(std::uint64_t) / 10);
+
+    const auto v1 = v0.set(10, 42);
+    assert(v0[10] == 1500000600);
+    assert(v1[10] == 42);
+
+    const auto n = immer::count_if(v1, [](auto x) { return x < 100; });
+    assert(n == 1);
+}
+// include:intro/end
@@ -0,0 +1,27 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <cassert>
+
+// include:intro/start
+#include <immer/deque.hpp>
+
+int main()
+{
+    const auto v0 = immer::deque<int>{};
+    const auto v1 = v0.push_back(13).push_front(12);
+    assert(v0.size() == 0 && v1.size() == 2);
+    assert(v1.front() == 12 && v1.back() == 13);
+
+    const auto v2 = v1.pop_front().push_front(42);
+    assert(v1[0] == 12 && v2[0] == 42);
+
+    const auto f = v2.flex();
+    assert(f.size() == 2 && f[0] == 42 && f[1] == 13);
+}
+// include:intro/end
@@ -0,0 +1,28 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <cassert>
+#include <functional>
+#include <immer/flex_vector.hpp>
+#include <immer/sort.hpp>
+
+int main()
+{
+    {
+        // include:sort/start
+        auto v = immer::flex_vector<int>{3, 1, 4, 1, 5, 9, 2, 6};
+
+        auto s = immer::sort(v);
+        assert((s == immer::flex_vector<int>{1, 1, 2, 3, 4, 5, 6, 9}));
+
+        // Large vectors can be sorted in multiple threads
+        auto r = immer::sort(v, std::greater<>{}, immer::async_executor{});
+        assert((r == immer::flex_vector<int>{9, 6, 5, 4, 3, 2, 1, 1}));
+        // include:sort/end
+    }
+}
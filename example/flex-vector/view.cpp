@@ -0,0 +1,31 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <cassert>
+#include <immer/algorithm.hpp>
+#include <immer/flex_vector.hpp>
+#include <immer/vector_view.hpp>
+
+int main()
+{
+    {
+        // include:view/start
+        auto v = immer::flex_vector<int>{1, 2, 3, 4, 5, 6, 7, 8};
+
+        // Views share the nodes of the vector and do not allocate
+        auto w = immer::make_view(v, 2, 6);
+        assert(w.size() == 4);
+        assert(w[0] == 3);
+        assert(immer::accumulate(w, 0) == 3 + 4 + 5 + 6);
+
+        // Getting an actual vector is an explicit operation
+        auto x = w.drop(1).materialize();
+        assert(x == (immer::flex_vector<int>{4, 5, 6}));
+        // include:view/end
+    }
+}
@@ -0,0 +1,30 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <cassert>
+
+// include:intro/start
+#include <immer/text.hpp>
+
+int main()
+{
+    const auto t0 = immer::text<>{"first\nsecond\nthird"};
+    assert(t0.line_count() == 3);
+    assert(t0.line_to_offset(2) == 13);
+    assert(t0.offset_to_line(7) == 1);
+
+    const auto t1 = t0.insert(t0.line_to_offset(1), "inserted\n");
+    assert(t1.line_count() == 4);
+    assert(t1.line(1).str() == "inserted");
+    assert(t1.line(2).str() == "second");
+    assert(t0.line(1).str() == "second");
+
+    const auto t2 = t1.erase(0, t1.line_to_offset(2));
+    assert(t2.str() == "second\nthird");
+}
+// include:intro/end
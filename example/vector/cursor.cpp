@@ -0,0 +1,30 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <cassert>
+#include <immer/cursor.hpp>
+#include <immer/vector.hpp>
+
+int main()
+{
+    {
+        // include:cursor/start
+        auto v = immer::vector<int>{};
+        for (auto i = 0; i < 1000; ++i)
+            v = v.push_back(i);
+
+        // Accesses close to the previous one do not descend from the root
+        auto c   = immer::make_cursor(v);
+        auto sum = 0;
+        for (auto i = 0; i + 2 < 1000; i += 3)
+            sum += c[i] + c[i + 2];
+
+        assert(sum == 332334);
+        // include:cursor/end
+    }
+}
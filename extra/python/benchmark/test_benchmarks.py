@@ -1,4 +1,3 @@
-
 # immer: immutable data structures for C++
 # Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
 #
@@ -7,11 +6,25 @@
 
 ##
 
+import array
+
 import immer
 import pyrsistent
+import pytest
+
+try:
+    xrange
+except NameError:
+    xrange = range
 
 BENCHMARK_SIZE = 1000
 
+# Only the pybind11 bindings provide the other containers, transients and
+# bulk constructors
+pybind_only = pytest.mark.skipif(
+    not hasattr(immer, 'FlexVector'),
+    reason='requires the pybind11 bindings')
+
 def push(v, n=BENCHMARK_SIZE):
     for x in xrange(n):
         v = v.append(x)
@@ -26,6 +39,44 @@ def index(v):
     for i in xrange(len(v)):
         v[i]
 
+def push_transient(t, n=BENCHMARK_SIZE):
+    for x in xrange(n):
+        t.append(x)
+    return t.persistent()
+
+def slices(v):
+    for i in xrange(len(v) // 2):
+        v[i:-i-1]
+
+def concat(v, n=10):
+    r = v
+    for _ in xrange(n):
+        r = r + v
+    return r
+
+def insert(m, n=BENCHMARK_SIZE):
+    for x in xrange(n):
+        m = m.set(x, x)
+    return m
+
+def lookup(m):
+    for x in xrange(len(m)):
+        m[x]
+
+def insert_set(s, n=BENCHMARK_SIZE):
+    for x in xrange(n):
+        s = s.insert(x)
+    return s
+
+def add_set(s, n=BENCHMARK_SIZE):
+    for x in xrange(n):
+        s = s.add(x)
+    return s
+
+def contains(s):
+    for x in xrange(len(s)):
+        x in s
+
 def test_push_immer(benchmark):
     benchmark(push, immer.Vector())
 
@@ -43,3 +94,92 @@ def test_index_immer(benchmark):
 
 def test_index_pyrsistent(benchmark):
     benchmark(index, push(pyrsistent.pvector()))
+
+@pybind_only
+def test_push_flex_immer(benchmark):
+    benchmark(push, immer.FlexVector())
+
+@pybind_only
+def test_assoc_flex_immer(benchmark):
+    benchmark(assoc, push(immer.FlexVector()))
+
+@pybind_only
+def test_index_flex_immer(benchmark):
+    benchmark(index, push(immer.FlexVector()))
+
+@pybind_only
+def test_push_transient_immer(benchmark):
+    benchmark(lambda: push_transient(immer.Vector().transient()))
+
+def test_push_transient_pyrsistent(benchmark):
+    benchmark(lambda: push_transient(pyrsistent.pvector().evolver()))
+
+@pybind_only
+def test_from_list_immer(benchmark):
+    benchmark(immer.Vector, list(xrange(BENCHMARK_SIZE)))
+
+def test_from_list_pyrsistent(benchmark):
+    benchmark(pyrsistent.pvector, list(xrange(BENCHMARK_SIZE)))
+
+@pybind_only
+def test_from_buffer_immer(benchmark):
+    benchmark(immer.Vector, array.array('l', xrange(BENCHMARK_SIZE)))
+
+def test_from_buffer_pyrsistent(benchmark):
+    benchmark(pyrsistent.pvector, array.array('l', xrange(BENCHMARK_SIZE)))
+
+@pybind_only
+def test_slice_immer(benchmark):
+    benchmark(slices, immer.FlexVector(xrange(BENCHMARK_SIZE)))
+
+def test_slice_pyrsistent(benchmark):
+    benchmark(slices, pyrsistent.pvector(xrange(BENCHMARK_SIZE)))
+
+@pybind_only
+def test_concat_immer(benchmark):
+    benchmark(concat, immer.FlexVector(xrange(BENCHMARK_SIZE)))
+
+def test_concat_pyrsistent(benchmark):
+    benchmark(concat, pyrsistent.pvector(xrange(BENCHMARK_SIZE)))
+
+@pybind_only
+def test_insert_map_immer(benchmark):
+    benchmark(insert, immer.Map())
+
+def test_insert_map_pyrsistent(benchmark):
+    benchmark(insert, pyrsistent.pmap())
+
+@pybind_only
+def test_lookup_map_immer(benchmark):
+    benchmark(lookup, insert(immer.Map()))
+
+def test_lookup_map_pyrsistent(benchmark):
+    benchmark(lookup, insert(pyrsistent.pmap()))
+
+@pybind_only
+def test_from_dict_immer(benchmark):
+    benchmark(immer.Map, {x: x for x in xrange(BENCHMARK_SIZE)})
+
+def test_from_dict_pyrsistent(benchmark):
+    benchmark(pyrsistent.pmap, {x: x for x in xrange(BENCHMARK_SIZE)})
+
+@pybind_only
+def test_insert_set_immer(benchmark):
+    benchmark(insert_set, immer.Set())
+
+def test_insert_set_pyrsistent(benchmark):
+    benchmark(add_set, pyrsistent.pset())
+
+@pybind_only
+def test_contains_set_immer(benchmark):
+    benchmark(contains, insert_set(immer.Set()))
+
+def test_contains_set_pyrsistent(benchmark):
+    benchmark(contains, add_set(pyrsistent.pset()))
+
+@pybind_only
+def test_from_list_set_immer(benchmark):
+    benchmark(immer.Set, list(xrange(BENCHMARK_SIZE)))
+
+def test_from_list_set_pyrsistent(benchmark):
+    benchmark(pyrsistent.pset, list(xrange(BENCHMARK_SIZE)))
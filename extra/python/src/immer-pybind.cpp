@@ -8,8 +8,21 @@
 
 #include <pybind11/pybind11.h>
 
+#include <immer/flex_vector.hpp>
+#include <immer/flex_vector_transient.hpp>
+#include <immer/map.hpp>
+#include <immer/map_transient.hpp>
 #include <immer/refcount/unsafe_refcount_policy.hpp>
+#include <immer/set.hpp>
+#include <immer/set_transient.hpp>
 #include <immer/vector.hpp>
+#include <immer/vector_transient.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace py = pybind11;
 
 namespace {
 
@@ -32,9 +45,278 @@ using memory_t =
     immer::memory_policy<immer::unsafe_free_list_heap_policy<heap_t>,
                          immer::unsafe_refcount_policy>;
 
-} // anonymous namespace
+struct hash_t
+{
+    std::size_t operator()(const py::object& x) const
+    {
+        auto h = PyObject_Hash(x.ptr());
+        if (h == -1 && PyErr_Occurred())
+            throw py::error_already_set{};
+        return static_cast<std::size_t>(h);
+    }
+};
 
-namespace py = pybind11;
+struct equal_t
+{
+    bool operator()(const py::object& a, const py::object& b) const
+    {
+        auto r = PyObject_RichCompareBool(a.ptr(), b.ptr(), Py_EQ);
+        if (r < 0)
+            throw py::error_already_set{};
+        return r;
+    }
+};
+
+using vector_t      = immer::vector<py::object, memory_t>;
+using flex_vector_t = immer::flex_vector<py::object, memory_t>;
+using map_t =
+    immer::map<py::object, py::object, hash_t, equal_t, memory_t>;
+using set_t = immer::set<py::object, hash_t, equal_t, memory_t>;
+
+using item_fn = py::object (*)(const char*);
+
+template <typename T, typename As = T>
+py::object buffer_item(const char* p)
+{
+    auto x = T{};
+    std::memcpy(&x, p, sizeof(T));
+    return py::cast(static_cast<As>(x));
+}
+
+// Returns how to read the items of a buffer with the given `struct` format,
+// or null when they are not native numbers.
+item_fn buffer_item_fn(std::string format)
+{
+    if (format.size() == 2 && format[0] == '@')
+        format.erase(0, 1);
+    if (format.size() != 1)
+        return nullptr;
+    switch (format[0]) {
+    case '?':
+        return &buffer_item<bool>;
+    case 'b':
+        return &buffer_item<signed char, int>;
+    case 'B':
+        return &buffer_item<unsigned char, unsigned>;
+    case 'h':
+        return &buffer_item<short>;
+    case 'H':
+        return &buffer_item<unsigned short>;
+    case 'i':
+        return &buffer_item<int>;
+    case 'I':
+        return &buffer_item<unsigned>;
+    case 'l':
+        return &buffer_item<long>;
+    case 'L':
+        return &buffer_item<unsigned long>;
+    case 'q':
+        return &buffer_item<long long>;
+    case 'Q':
+        return &buffer_item<unsigned long long>;
+    case 'n':
+        return &buffer_item<Py_ssize_t>;
+    case 'N':
+        return &buffer_item<std::size_t>;
+    case 'f':
+        return &buffer_item<float>;
+    case 'd':
+        return &buffer_item<double>;
+    default:
+        return nullptr;
+    }
+}
+
+// Calls `fn` with every item of `src`.  One dimensional buffers of numbers,
+// like `bytes`, `array.array` or NumPy arrays, are read directly from memory
+// instead of going through the iterator protocol.
+template <typename Fn>
+void for_each_item(py::handle src, Fn&& fn)
+{
+    if (PyObject_CheckBuffer(src.ptr())) {
+        auto info = py::reinterpret_borrow<py::buffer>(src).request();
+        auto item = buffer_item_fn(info.format);
+        if (info.ndim == 1 && item) {
+            auto p = static_cast<const char*>(info.ptr);
+            for (auto i = py::ssize_t{}; i < info.shape[0];
+                 ++i, p += info.strides[0])
+                fn(item(p));
+            return;
+        }
+    }
+    for (auto x : src)
+        fn(py::reinterpret_borrow<py::object>(x));
+}
+
+// Calls `fn` with every key and value of `src`, which is either a mapping
+// or an iterable of pairs, like the argument of `dict.update()`.
+template <typename Fn>
+void for_each_pair(py::handle src, Fn&& fn)
+{
+    auto items = py::hasattr(src, "items")
+                     ? src.attr("items")()
+                     : py::reinterpret_borrow<py::object>(src);
+    for (auto x : items) {
+        auto kv = py::tuple(py::reinterpret_borrow<py::object>(x));
+        if (kv.size() != 2)
+            throw py::value_error{"Expected a key and value pair"};
+        fn(py::object(kv[0]), py::object(kv[1]));
+    }
+}
+
+template <typename Vector>
+std::size_t check_index(const Vector& v, py::ssize_t i)
+{
+    auto size = static_cast<py::ssize_t>(v.size());
+    if (i < 0)
+        i += size;
+    if (i < 0 || i >= size)
+        throw py::index_error{"Index out of range"};
+    return static_cast<std::size_t>(i);
+}
+
+// Clamps the position like `list.insert()` does
+template <typename Vector>
+std::size_t insert_index(const Vector& v, py::ssize_t i)
+{
+    auto size = static_cast<py::ssize_t>(v.size());
+    if (i < 0)
+        i = std::max(py::ssize_t{}, i + size);
+    return static_cast<std::size_t>(std::min(i, size));
+}
+
+// Slices with a step of one share the structure of `v`, in logarithmic
+// time.  Otherwise the elements are collected in a new vector.
+flex_vector_t slice_vector(const flex_vector_t& v, const py::slice& s)
+{
+    auto start = std::size_t{}, stop = std::size_t{}, step = std::size_t{},
+         length = std::size_t{};
+    if (!s.compute(v.size(), &start, &stop, &step, &length))
+        throw py::error_already_set{};
+    if (step == 1)
+        return v.drop(start).take(length);
+    auto r = flex_vector_t{}.transient();
+    // a negative `step` wraps around
+    for (auto i = std::size_t{}; i < length; ++i, start += step)
+        r.push_back(v[start]);
+    return std::move(r).persistent();
+}
+
+// A `Vector` is converted in constant time, sharing its structure
+template <typename Vector>
+Vector make_vector(py::handle src)
+{
+    if (py::isinstance<vector_t>(src))
+        return Vector{src.cast<const vector_t&>()};
+    auto r = Vector{}.transient();
+    for_each_item(src, [&](py::object x) { r.push_back(std::move(x)); });
+    return std::move(r).persistent();
+}
+
+// Binds the methods common to `Vector` and `FlexVector`
+template <typename Vector, typename... Options>
+py::class_<Vector, Options...>& def_vector(py::class_<Vector, Options...>& c)
+{
+    using transient_t = typename Vector::transient_type;
+    return c.def(py::init<>())
+        .def(py::init(&make_vector<Vector>),
+             "Makes a vector with the items of an iterable or buffer")
+        .def("__len__", &Vector::size)
+        .def("__getitem__",
+             [](const Vector& v, py::ssize_t i) {
+                 return v[check_index(v, i)];
+             })
+        .def("__getitem__",
+             [](const Vector& v, py::slice s) {
+                 return slice_vector(flex_vector_t{v}, s);
+             })
+        .def(
+            "__iter__",
+            [](const Vector& v) {
+                return py::make_iterator(v.begin(), v.end());
+            },
+            py::keep_alive<0, 1>())
+        .def("append",
+             [](const Vector& v, py::object x) {
+                 return v.push_back(std::move(x));
+             })
+        .def("set",
+             [](const Vector& v, py::ssize_t i, py::object x) {
+                 return v.set(check_index(v, i), std::move(x));
+             })
+        .def("extend",
+             [](const Vector& v, py::handle src) {
+                 auto r = v.transient();
+                 for_each_item(
+                     src, [&](py::object x) { r.push_back(std::move(x)); });
+                 return std::move(r).persistent();
+             })
+        .def("take",
+             [](const Vector& v, std::size_t n) { return v.take(n); })
+        .def("tolist",
+             [](const Vector& v) {
+                 auto r = py::list(v.size());
+                 auto i = std::size_t{};
+                 for (auto& x : v)
+                     r[i++] = x;
+                 return r;
+             })
+        .def("transient", [](const Vector& v) -> transient_t {
+            return v.transient();
+        });
+}
+
+template <typename Transient, typename... Options>
+py::class_<Transient, Options...>&
+def_vector_transient(py::class_<Transient, Options...>& c)
+{
+    return c.def("__len__", &Transient::size)
+        .def("__getitem__",
+             [](const Transient& v, py::ssize_t i) {
+                 return v[check_index(v, i)];
+             })
+        .def("append",
+             [](Transient& v, py::object x) { v.push_back(std::move(x)); })
+        .def("set",
+             [](Transient& v, py::ssize_t i, py::object x) {
+                 v.set(check_index(v, i), std::move(x));
+             })
+        .def("extend",
+             [](Transient& v, py::handle src) {
+                 for_each_item(
+                     src, [&](py::object x) { v.push_back(std::move(x)); });
+             })
+        .def("persistent", [](Transient& v) { return v.persistent(); });
+}
+
+map_t make_map(py::handle src)
+{
+    auto r = map_t{}.transient();
+    for_each_pair(src, [&](py::object k, py::object v) {
+        r.set(std::move(k), std::move(v));
+    });
+    return std::move(r).persistent();
+}
+
+set_t make_set(py::handle src)
+{
+    auto r = set_t{}.transient();
+    for_each_item(src, [&](py::object x) { r.insert(std::move(x)); });
+    return std::move(r).persistent();
+}
+
+template <typename Map>
+const py::object& map_get(const Map& m, const py::object& k)
+{
+    auto p = m.find(k);
+    if (!p) {
+        PyErr_SetObject(PyExc_KeyError, k.ptr());
+        throw py::error_already_set{};
+    }
+    return *p;
+}
+
+} // anonymous namespace
 
 PYBIND11_PLUGIN(immer_python_module)
 {
@@ -45,26 +327,167 @@ PYBIND11_PLUGIN(immer_python_module)
         .. autosummary::
            :toctree: _generate
            Vector
+           VectorTransient
+           FlexVector
+           FlexVectorTransient
+           Map
+           MapTransient
+           Set
+           SetTransient
     )pbdoc");
 
-    using vector_t = immer::vector<py::object, memory_t>;
+    using vector_transient_t      = vector_t::transient_type;
+    using flex_vector_transient_t = flex_vector_t::transient_type;
+    using map_transient_t         = map_t::transient_type;
+    using set_transient_t         = set_t::transient_type;
 
-    py::class_<vector_t>(m, "Vector")
-        .def(py::init<>())
-        .def("__len__", &vector_t::size)
-        .def("__getitem__",
-             [](const vector_t& v, std::size_t i) {
-                 if (i > v.size())
-                     throw py::index_error{"Index out of range"};
-                 return v[i];
+    auto vector = py::class_<vector_t>(m, "Vector");
+    def_vector(vector);
+
+    auto vector_transient =
+        py::class_<vector_transient_t>(m, "VectorTransient");
+    def_vector_transient(vector_transient);
+
+    auto flex_vector = py::class_<flex_vector_t>(m, "FlexVector");
+    def_vector(flex_vector)
+        .def("prepend",
+             [](const flex_vector_t& v, py::object x) {
+                 return v.push_front(std::move(x));
              })
-        .def("append",
-             [](const vector_t& v, py::object x) {
-                 return v.push_back(std::move(x));
+        .def("insert",
+             [](const flex_vector_t& v, py::ssize_t i, py::object x) {
+                 return v.insert(insert_index(v, i), std::move(x));
+             })
+        .def("erase",
+             [](const flex_vector_t& v, py::ssize_t i) {
+                 return v.erase(check_index(v, i));
              })
-        .def("set", [](const vector_t& v, std::size_t i, py::object x) {
-            return v.set(i, std::move(x));
+        .def("drop",
+             [](const flex_vector_t& v, std::size_t n) { return v.drop(n); })
+        .def("__add__", [](const flex_vector_t& a, const flex_vector_t& b) {
+            return a + b;
         });
+    py::implicitly_convertible<vector_t, flex_vector_t>();
+
+    auto flex_vector_transient =
+        py::class_<flex_vector_transient_t>(m, "FlexVectorTransient");
+    def_vector_transient(flex_vector_transient);
+
+    py::class_<map_t>(m, "Map")
+        .def(py::init<>())
+        .def(py::init(&make_map),
+             "Makes a map with the items of a mapping or iterable of pairs")
+        .def("__len__", &map_t::size)
+        .def("__contains__",
+             [](const map_t& m, const py::object& k) {
+                 return m.count(k) > 0;
+             })
+        .def("__getitem__", &map_get<map_t>)
+        .def(
+            "get",
+            [](const map_t& m, const py::object& k, py::object def) {
+                auto p = m.find(k);
+                return p ? *p : def;
+            },
+            py::arg("key"),
+            py::arg("default") = py::none())
+        .def(
+            "__iter__",
+            [](const map_t& m) {
+                return py::make_key_iterator(m.begin(), m.end());
+            },
+            py::keep_alive<0, 1>())
+        .def(
+            "items",
+            [](const map_t& m) {
+                return py::make_iterator(m.begin(), m.end());
+            },
+            py::keep_alive<0, 1>())
+        .def("set",
+             [](const map_t& m, py::object k, py::object v) {
+                 return m.set(std::move(k), std::move(v));
+             })
+        .def("discard",
+             [](const map_t& m, const py::object& k) { return m.erase(k); })
+        .def("update",
+             [](const map_t& m, py::handle src) {
+                 auto r = m.transient();
+                 for_each_pair(src, [&](py::object k, py::object v) {
+                     r.set(std::move(k), std::move(v));
+                 });
+                 return std::move(r).persistent();
+             })
+        .def("transient",
+             [](const map_t& m) -> map_transient_t { return m.transient(); });
+
+    py::class_<map_transient_t>(m, "MapTransient")
+        .def("__len__", &map_transient_t::size)
+        .def("__contains__",
+             [](const map_transient_t& m, const py::object& k) {
+                 return m.count(k) > 0;
+             })
+        .def("__getitem__", &map_get<map_transient_t>)
+        .def("set",
+             [](map_transient_t& m, py::object k, py::object v) {
+                 m.set(std::move(k), std::move(v));
+             })
+        .def("discard",
+             [](map_transient_t& m, const py::object& k) { m.erase(k); })
+        .def("update",
+             [](map_transient_t& m, py::handle src) {
+                 for_each_pair(src, [&](py::object k, py::object v) {
+                     m.set(std::move(k), std::move(v));
+                 });
+             })
+        .def("persistent", [](map_transient_t& m) { return m.persistent(); });
+
+    py::class_<set_t>(m, "Set")
+        .def(py::init<>())
+        .def(py::init(&make_set),
+             "Makes a set with the items of an iterable or buffer")
+        .def("__len__", &set_t::size)
+        .def("__contains__",
+             [](const set_t& s, const py::object& x) {
+                 return s.count(x) > 0;
+             })
+        .def(
+            "__iter__",
+            [](const set_t& s) {
+                return py::make_iterator(s.begin(), s.end());
+            },
+            py::keep_alive<0, 1>())
+        .def("insert",
+             [](const set_t& s, py::object x) {
+                 return s.insert(std::move(x));
+             })
+        .def("discard",
+             [](const set_t& s, const py::object& x) { return s.erase(x); })
+        .def("update",
+             [](const set_t& s, py::handle src) {
+                 auto r = s.transient();
+                 for_each_item(
+                     src, [&](py::object x) { r.insert(std::move(x)); });
+                 return std::move(r).persistent();
+             })
+        .def("transient",
+             [](const set_t& s) -> set_transient_t { return s.transient(); });
+
+    py::class_<set_transient_t>(m, "SetTransient")
+        .def("__len__", &set_transient_t::size)
+        .def("__contains__",
+             [](const set_transient_t& s, const py::object& x) {
+                 return s.count(x) > 0;
+             })
+        .def("insert",
+             [](set_transient_t& s, py::object x) { s.insert(std::move(x)); })
+        .def("discard",
+             [](set_transient_t& s, const py::object& x) { s.erase(x); })
+        .def("update",
+             [](set_transient_t& s, py::handle src) {
+                 for_each_item(
+                     src, [&](py::object x) { s.insert(std::move(x)); });
+             })
+        .def("persistent", [](set_transient_t& s) { return s.persistent(); });
 
 #ifdef VERSION_INFO
     m.attr("__version__") = py::str(VERSION_INFO);
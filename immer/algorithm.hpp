@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include <immer/detail/kernels.hpp>
+
 #include <algorithm>
 #include <cassert>
 #include <functional>
+#include <iterator>
 #include <numeric>
 #include <type_traits>
 
@@ -229,6 +232,178 @@ bool all_of(Iter first, Iter last, Pred p)
     });
 }
 
+/*!
+ * Equivalent of `std::count_if` applied to the range `r`.
+ */
+template <typename Range, typename Pred>
+std::ptrdiff_t count_if(Range&& r, Pred p)
+{
+    auto n = std::size_t{};
+    for_each_chunk(r, [&](auto first, auto last) {
+        n += detail::count_if_chunk(first, last, p);
+    });
+    return static_cast<std::ptrdiff_t>(n);
+}
+
+/*!
+ * Equivalent of `std::count_if` applied to the range @f$ [first, last)
+ * @f$.
+ */
+template <typename Iter, typename Pred>
+std::ptrdiff_t count_if(Iter first, Iter last, Pred p)
+{
+    auto n = std::size_t{};
+    for_each_chunk(first, last, [&](auto first, auto last) {
+        n += detail::count_if_chunk(first, last, p);
+    });
+    return static_cast<std::ptrdiff_t>(n);
+}
+
+/*!
+ * Equivalent of `std::count` applied to the range `r`.
+ */
+template <typename Range, typename T>
+std::ptrdiff_t count(Range&& r, const T& value)
+{
+    return count_if(r, [&](auto&& x) { return x == value; });
+}
+
+/*!
+ * Equivalent of `std::count` applied to the range @f$ [first, last) @f$.
+ */
+template <typename Iter, typename T>
+std::ptrdiff_t count(Iter first, Iter last, const T& value)
+{
+    return count_if(first, last, [&](auto&& x) { return x == value; });
+}
+
+/*!
+ * Equivalent of `std::find` applied to the range `r`, which must be a
+ * sequence with random access iterators.
+ */
+template <typename Range, typename T>
+auto find(Range&& r, const T& value)
+{
+    auto n = std::size_t{};
+    for_each_chunk_p(r, [&](auto first, auto last) {
+        auto p = detail::find_chunk(first, last, value);
+        n += p - first;
+        return p == last;
+    });
+    return r.begin() + n;
+}
+
+/*!
+ * Equivalent of `std::find` applied to the range @f$ [first, last) @f$,
+ * which must be random access iterators.
+ */
+template <typename Iter, typename T>
+Iter find(Iter first, Iter last, const T& value)
+{
+    auto n = std::size_t{};
+    for_each_chunk_p(first, last, [&](auto first, auto last) {
+        auto p = detail::find_chunk(first, last, value);
+        n += p - first;
+        return p == last;
+    });
+    return first + n;
+}
+
+namespace detail {
+
+template <typename Iter,
+          typename ForEachChunk,
+          typename Compare,
+          typename Better,
+          typename Chunk>
+std::size_t
+best_element(ForEachChunk&& each, Compare& cmp, Better better, Chunk chunk)
+{
+    using value_t = typename std::iterator_traits<Iter>::value_type;
+    auto n        = std::size_t{};
+    auto best     = std::size_t{};
+    auto ptr      = static_cast<const value_t*>(nullptr);
+    each([&](auto first, auto last) {
+        auto p = chunk(first, last, cmp);
+        if (p != last && (!ptr || better(*p, *ptr))) {
+            ptr  = p;
+            best = n + (p - first);
+        }
+        n += last - first;
+    });
+    return best;
+}
+
+template <typename Iter, typename ForEachChunk, typename Compare>
+std::size_t min_element(ForEachChunk&& each, Compare& cmp)
+{
+    return best_element<Iter>(
+        each,
+        cmp,
+        [&](auto&& a, auto&& b) { return cmp(a, b); },
+        [](auto f, auto l, auto& c) { return min_chunk(f, l, c); });
+}
+
+template <typename Iter, typename ForEachChunk, typename Compare>
+std::size_t max_element(ForEachChunk&& each, Compare& cmp)
+{
+    return best_element<Iter>(
+        each,
+        cmp,
+        [&](auto&& a, auto&& b) { return cmp(b, a); },
+        [](auto f, auto l, auto& c) { return max_chunk(f, l, c); });
+}
+
+} // namespace detail
+
+/*!
+ * Equivalent of `std::min_element` applied to the range `r`, which must be a
+ * sequence with random access iterators.
+ */
+template <typename Range, typename Compare = std::less<>>
+auto min_element(Range&& r, Compare cmp = {})
+{
+    using iter_t = decltype(r.begin());
+    return r.begin() + detail::min_element<iter_t>(
+                           [&](auto&& fn) { for_each_chunk(r, fn); }, cmp);
+}
+
+/*!
+ * Equivalent of `std::min_element` applied to the range @f$ [first, last)
+ * @f$, which must be random access iterators.
+ */
+template <typename Iter, typename Compare = std::less<>>
+Iter min_element(Iter first, Iter last, Compare cmp = {})
+{
+    return first + detail::min_element<Iter>(
+                       [&](auto&& fn) { for_each_chunk(first, last, fn); },
+                       cmp);
+}
+
+/*!
+ * Equivalent of `std::max_element` applied to the range `r`, which must be a
+ * sequence with random access iterators.
+ */
+template <typename Range, typename Compare = std::less<>>
+auto max_element(Range&& r, Compare cmp = {})
+{
+    using iter_t = decltype(r.begin());
+    return r.begin() + detail::max_element<iter_t>(
+                           [&](auto&& fn) { for_each_chunk(r, fn); }, cmp);
+}
+
+/*!
+ * Equivalent of `std::max_element` applied to the range @f$ [first, last)
+ * @f$, which must be random access iterators.
+ */
+template <typename Iter, typename Compare = std::less<>>
+Iter max_element(Iter first, Iter last, Compare cmp = {})
+{
+    return first + detail::max_element<Iter>(
+                       [&](auto&& fn) { for_each_chunk(first, last, fn); },
+                       cmp);
+}
+
 /*!
  * Object that can be used to process changes as computed by the @a diff
  * algorithm.
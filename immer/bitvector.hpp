@@ -0,0 +1,376 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/algorithm.hpp>
+#include <immer/config.hpp>
+#include <immer/detail/hamts/bits.hpp>
+#include <immer/detail/rbts/zip.hpp>
+#include <immer/detail/util.hpp>
+#include <immer/memory_policy.hpp>
+#include <immer/vector.hpp>
+#include <immer/vector_transient.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+namespace immer {
+
+/*!
+ * Immutable sequence of bits supporting random access and structural
+ * sharing.
+ *
+ * @tparam MemoryPolicy Memory management policy. See @ref
+ *         memory_policy.
+ *
+ * @rst
+ *
+ * Bits are packed in 64 bit words that are stored in an
+ * ``immer::vector``, so every leaf of the tree holds :math:`64 \cdot 2^{BL}`
+ * bits, and it uses an eighth of the memory of a ``immer::vector<bool>``.
+ * Counting and searching work a word at a time.  The bitwise operators
+ * combine two bitvectors of the same size walking both trees together, and
+ * ``&`` and ``|`` reuse the subtrees that are shared by both operands
+ * instead of visiting them, so combining two versions of a big bitvector
+ * that differ in a few bits is fast and keeps most of the memory shared.
+ *
+ * @endrst
+ */
+template <typename MemoryPolicy   = default_memory_policy,
+          detail::rbts::bits_t B  = default_bits,
+          detail::rbts::bits_t BL = detail::rbts::
+              derive_bits_leaf<std::uint64_t, MemoryPolicy, B>>
+class bitvector
+{
+public:
+    static constexpr auto bits      = B;
+    static constexpr auto bits_leaf = BL;
+    using memory_policy             = MemoryPolicy;
+
+    using value_type      = bool;
+    using reference       = bool;
+    using size_type       = detail::rbts::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = bool;
+
+    using word_type  = std::uint64_t;
+    using words_type = vector<word_type, MemoryPolicy, B, BL>;
+
+    static constexpr size_type word_bits = 64;
+
+    /*!
+     * Value returned by the search methods when no bit is found.
+     */
+    static constexpr size_type npos = ~size_type{};
+
+    /*!
+     * Default constructor.  It creates a bitvector of `size() == 0`.  It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    bitvector() = default;
+
+    /*!
+     * Constructs a bitvector containing the bits in `values`.
+     */
+    bitvector(std::initializer_list<bool> values)
+    {
+        auto t    = words_type{}.transient();
+        auto word = word_type{};
+        for (auto v : values) {
+            word |= word_type{v} << (size_ % word_bits);
+            if (++size_ % word_bits == 0) {
+                t.push_back(word);
+                word = 0;
+            }
+        }
+        if (size_ % word_bits)
+            t.push_back(word);
+        words_ = t.persistent();
+    }
+
+    /*!
+     * Constructs a bitvector with `n` bits with value `v`.
+     */
+    bitvector(size_type n, bool v = false)
+        : words_(n / word_bits, v ? ~word_type{} : word_type{})
+        , size_{n}
+    {
+        if (n % word_bits)
+            words_ = std::move(words_).push_back(v ? low_mask(n) : 0);
+    }
+
+    /*!
+     * Returns the number of bits in the container.  It does not allocate
+     * memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD size_type size() const { return size_; }
+
+    /*!
+     * Returns `true` if there are no bits in the container.  It does not
+     * allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD bool empty() const { return size_ == 0; }
+
+    /*!
+     * Returns the bit at position `index`.  It is undefined when @f$ index
+     * \geq size() @f$.  It does not allocate memory and its complexity is
+     * *effectively* @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD bool test(size_type index) const
+    {
+        return (words_[index / word_bits] >> (index % word_bits)) & 1;
+    }
+
+    IMMER_NODISCARD bool operator[](size_type index) const
+    {
+        return test(index);
+    }
+
+    /*!
+     * Returns the bit at position `index`.  It throws an
+     * `std::out_of_range` exception when @f$ index \geq size() @f$.
+     */
+    bool at(size_type index) const
+    {
+        if (index >= size_)
+            IMMER_THROW(std::out_of_range{"index out of range"});
+        return test(index);
+    }
+
+    /*!
+     * Returns a bitvector with `value` inserted at the end.  It may
+     * allocate memory and its complexity is *effectively* @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD bitvector push_back(bool value) const&
+    {
+        return {size_ % word_bits
+                    ? words_.update(size_ / word_bits, set_fn(size_, value))
+                    : words_.push_back(word_type{value}),
+                size_ + 1};
+    }
+
+    IMMER_NODISCARD bitvector push_back(bool value) &&
+    {
+        return {size_ % word_bits
+                    ? std::move(words_).update(size_ / word_bits,
+                                               set_fn(size_, value))
+                    : std::move(words_).push_back(word_type{value}),
+                size_ + 1};
+    }
+
+    /*!
+     * Returns a bitvector with the bit at position `index` set to `value`.
+     * Undefined for `index >= size()`.  It may allocate memory and its
+     * complexity is *effectively* @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD bitvector set(size_type index, bool value = true) const&
+    {
+        return {words_.update(index / word_bits, set_fn(index, value)), size_};
+    }
+
+    IMMER_NODISCARD bitvector set(size_type index, bool value = true) &&
+    {
+        return {std::move(words_).update(index / word_bits,
+                                         set_fn(index, value)),
+                size_};
+    }
+
+    /*!
+     * Returns a bitvector with the bit at position `index` set to `false`.
+     */
+    IMMER_NODISCARD bitvector reset(size_type index) const&
+    {
+        return set(index, false);
+    }
+
+    IMMER_NODISCARD bitvector reset(size_type index) &&
+    {
+        return std::move(*this).set(index, false);
+    }
+
+    /*!
+     * Returns a bitvector with the bit at position `index` negated.
+     * Undefined for `index >= size()`.  It may allocate memory and its
+     * complexity is *effectively* @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD bitvector flip(size_type index) const&
+    {
+        return {words_.update(index / word_bits, flip_fn(index)), size_};
+    }
+
+    IMMER_NODISCARD bitvector flip(size_type index) &&
+    {
+        return {std::move(words_).update(index / word_bits, flip_fn(index)),
+                size_};
+    }
+
+    /*!
+     * Returns the number of bits set to `true`.  It does not allocate
+     * memory and its complexity is @f$ O(size / 64) @f$.
+     */
+    IMMER_NODISCARD size_type count() const
+    {
+        auto r = size_type{};
+        for_each_chunk(words_, [&](auto first, auto last) {
+            for (; first != last; ++first)
+                r += detail::hamts::popcount(*first);
+        });
+        return r;
+    }
+
+    /*!
+     * Returns `true` if any bit is set.
+     */
+    IMMER_NODISCARD bool any() const { return find_first() != npos; }
+
+    /*!
+     * Returns `true` if no bit is set.
+     */
+    IMMER_NODISCARD bool none() const { return !any(); }
+
+    /*!
+     * Returns the position of the first bit set to `true`, or `npos` when
+     * there is none.  It does not allocate memory and its complexity is
+     * @f$ O(size / 64) @f$ in the worst case.
+     */
+    IMMER_NODISCARD size_type find_first() const { return find_from(0); }
+
+    /*!
+     * Returns the position of the first bit set to `true` after position
+     * `pos`, or `npos` when there is none.  It does not allocate memory and
+     * its complexity is @f$ O(log(size) + d / 64) @f$, where @f$ d @f$ is
+     * the distance to the bit found.
+     */
+    IMMER_NODISCARD size_type find_next(size_type pos) const
+    {
+        return pos + 1 < size_ ? find_from(pos + 1) : npos;
+    }
+
+    /*!
+     * Returns the bitwise AND of both bitvectors.  It is undefined unless
+     * both have the same size.  Subtrees that are shared by both operands
+     * are shared by the result too, without visiting them.
+     */
+    IMMER_NODISCARD bitvector operator&(const bitvector& other) const
+    {
+        return zip(other, [](word_type a, word_type b) { return a & b; }, true);
+    }
+
+    /*!
+     * Returns the bitwise OR of both bitvectors.  It is undefined unless
+     * both have the same size.  Subtrees that are shared by both operands
+     * are shared by the result too, without visiting them.
+     */
+    IMMER_NODISCARD bitvector operator|(const bitvector& other) const
+    {
+        return zip(other, [](word_type a, word_type b) { return a | b; }, true);
+    }
+
+    /*!
+     * Returns the bitwise XOR of both bitvectors.  It is undefined unless
+     * both have the same size.
+     */
+    IMMER_NODISCARD bitvector operator^(const bitvector& other) const
+    {
+        return zip(
+            other, [](word_type a, word_type b) { return a ^ b; }, false);
+    }
+
+    /*!
+     * Returns whether the bitvectors are equal.
+     */
+    IMMER_NODISCARD bool operator==(const bitvector& other) const
+    {
+        return size_ == other.size_ && words_ == other.words_;
+    }
+    IMMER_NODISCARD bool operator!=(const bitvector& other) const
+    {
+        return !(*this == other);
+    }
+
+    /*!
+     * Returns the vector of words holding the bits.  Bit `i` is stored in
+     * the bit `i % 64` of the word `i / 64`, and the bits of the last word
+     * after `size()` are always zero.
+     */
+    IMMER_NODISCARD const words_type& words() const { return words_; }
+
+private:
+    bitvector(words_type words, size_type size)
+        : words_{std::move(words)}
+        , size_{size}
+    {
+    }
+
+    static word_type low_mask(size_type n)
+    {
+        return (word_type{1} << (n % word_bits)) - 1;
+    }
+
+    static auto set_fn(size_type index, bool value)
+    {
+        auto mask = word_type{1} << (index % word_bits);
+        return [=](word_type w) { return value ? w | mask : w & ~mask; };
+    }
+
+    static auto flip_fn(size_type index)
+    {
+        auto mask = word_type{1} << (index % word_bits);
+        return [=](word_type w) { return w ^ mask; };
+    }
+
+    template <typename Fn>
+    bitvector zip(const bitvector& other, Fn fn, bool share) const
+    {
+        assert(size_ == other.size_);
+        return {words_type(detail::rbts::zip_regular(
+                    words_.impl(), other.words_.impl(), fn, share)),
+                size_};
+    }
+
+    size_type find_from(size_type pos) const
+    {
+        if (pos >= size_)
+            return npos;
+        auto first = words_.begin() + pos / word_bits;
+        auto index = pos / word_bits;
+        auto mask  = ~low_mask(pos);
+        auto r     = npos;
+        for_each_chunk_p(first, words_.end(), [&](auto f, auto l) {
+            for (; f != l; ++f, ++index, mask = ~word_type{}) {
+                if (auto w = *f & mask) {
+                    r = index * word_bits + detail::log2(w & (~w + 1));
+                    return false;
+                }
+            }
+            return true;
+        });
+        return r;
+    }
+
+    words_type words_ = {};
+    size_type size_   = 0;
+};
+
+template <typename MemoryPolicy,
+          detail::rbts::bits_t B,
+          detail::rbts::bits_t BL>
+constexpr typename bitvector<MemoryPolicy, B, BL>::size_type
+    bitvector<MemoryPolicy, B, BL>::word_bits;
+
+template <typename MemoryPolicy,
+          detail::rbts::bits_t B,
+          detail::rbts::bits_t BL>
+constexpr typename bitvector<MemoryPolicy, B, BL>::size_type
+    bitvector<MemoryPolicy, B, BL>::npos;
+
+} // namespace immer
@@ -0,0 +1,345 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/config.hpp>
+#include <immer/detail/compressed/tree.hpp>
+#include <immer/memory_policy.hpp>
+
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+namespace immer {
+
+template <typename T,
+          typename MemoryPolicy,
+          detail::rbts::bits_t B,
+          detail::rbts::bits_t BL>
+class compressed_vector_transient;
+
+/*!
+ * Immutable sequential container of integers that stores its elements
+ * compressed.
+ *
+ * @tparam T The type of the values to be stored in the container.  It must
+ *         be an integral type of at most 64 bits.
+ * @tparam MemoryPolicy Memory management policy. See @ref
+ *         memory_policy.
+ *
+ * @rst
+ *
+ * Elements are grouped in blocks of :math:`2^{BL}` elements.  Each block
+ * stores its first value and the differences between consecutive values,
+ * relative to the smallest of them and bit-packed with as many bits as the
+ * largest one needs.  Sorted ids, timestamps and similar sequences with a
+ * regular step thus take a few bits per element instead of
+ * ``sizeof(T) * 8``.  The blocks are kept in an ``immer::vector`` with
+ * branching :math:`2^B`, so updates share structure like in any other
+ * vector.  The last elements are kept uncompressed until a full block is
+ * completed.  Since that tail is copied by every persistent ``push_back``,
+ * and it is bigger than the one of ``immer::vector`` with the default
+ * ``BL``, big vectors are much faster to build through a transient, or by
+ * moving them.
+ *
+ * Reading an element needs to decode part of its block, so ``operator[]``
+ * is :math:`O(2^{BL})` and elements are returned by value.  Iterators and
+ * the algorithms in :doc:`algorithms` decode every block only once, and
+ * they should be preferred for traversals.  Updating an element re-encodes
+ * its whole block.
+ *
+ * **Example**
+ *   .. literalinclude:: ../example/compressed-vector/intro.cpp
+ *      :language: c++
+ *      :start-after: intro/start
+ *      :end-before:  intro/end
+ *
+ * @endrst
+ */
+template <typename T,
+          typename MemoryPolicy   = default_memory_policy,
+          detail::rbts::bits_t B  = default_bits,
+          detail::rbts::bits_t BL = 7>
+class compressed_vector
+{
+    using impl_t = detail::compressed::tree<T, MemoryPolicy, B, BL>;
+
+    using move_t =
+        std::integral_constant<bool, MemoryPolicy::use_transient_rvalues>;
+
+public:
+    static constexpr auto bits      = B;
+    static constexpr auto bits_leaf = BL;
+    using memory_policy             = MemoryPolicy;
+
+    using value_type      = T;
+    using reference       = T;
+    using size_type       = detail::rbts::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = T;
+
+    using iterator         = detail::compressed::tree_iterator<impl_t>;
+    using const_iterator   = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using transient_type = compressed_vector_transient<T, MemoryPolicy, B, BL>;
+
+    /*!
+     * Default constructor.  It creates a vector of `size() == 0`.  It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    compressed_vector() = default;
+
+    /*!
+     * Constructs a vector containing the elements in `values`.
+     */
+    compressed_vector(std::initializer_list<T> values)
+        : impl_{impl_t::from_range(values.begin(), values.end())}
+    {
+    }
+
+    /*!
+     * Constructs a vector containing the elements in the range
+     * defined by the input iterator `first` and range sentinel `last`.
+     */
+    template <typename Iter,
+              typename Sent,
+              std::enable_if_t<detail::compatible_sentinel_v<Iter, Sent>,
+                               bool> = true>
+    compressed_vector(Iter first, Sent last)
+        : impl_{impl_t::from_range(first, last)}
+    {
+    }
+
+    /*!
+     * Returns an iterator pointing at the first element of the
+     * collection.  It does not allocate memory and its complexity is
+     * @f$ O(1) @f$.  Dereferencing it decodes the block of the element
+     * when it is not the one decoded last.
+     */
+    IMMER_NODISCARD iterator begin() const { return {impl_}; }
+
+    /*!
+     * Returns an iterator pointing just after the last element of the
+     * collection. It does not allocate and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD iterator end() const
+    {
+        return {impl_, typename iterator::end_t{}};
+    }
+
+    /*!
+     * Returns an iterator that traverses the collection backwards,
+     * pointing at the first element of the reversed collection. It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD reverse_iterator rbegin() const
+    {
+        return reverse_iterator{end()};
+    }
+
+    /*!
+     * Returns an iterator that traverses the collection backwards,
+     * pointing after the last element of the reversed collection. It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD reverse_iterator rend() const
+    {
+        return reverse_iterator{begin()};
+    }
+
+    /*!
+     * Returns the number of elements in the container.  It does
+     * not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD size_type size() const { return impl_.size(); }
+
+    /*!
+     * Returns `true` if there are no elements in the container.  It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD bool empty() const { return size() == 0; }
+
+    /*!
+     * Returns the last element.
+     */
+    IMMER_NODISCARD T back() const { return impl_.get(size() - 1); }
+
+    /*!
+     * Returns the first element.
+     */
+    IMMER_NODISCARD T front() const { return impl_.get(0); }
+
+    /*!
+     * Returns the element at position `index`.  It is undefined when
+     * @f$ index \geq size() @f$.  It does not allocate memory and its
+     * complexity is *effectively* @f$ O(2^{BL}) @f$.
+     */
+    IMMER_NODISCARD reference operator[](size_type index) const
+    {
+        return impl_.get(index);
+    }
+
+    /*!
+     * Returns the element at position `index`.  It throws an
+     * `std::out_of_range` exception when @f$ index \geq size() @f$.  It
+     * does not allocate memory and its complexity is *effectively* @f$
+     * O(2^{BL}) @f$.
+     */
+    reference at(size_type index) const { return impl_.get_check(index); }
+
+    /*!
+     * Returns whether the vectors are equal.
+     */
+    IMMER_NODISCARD bool operator==(const compressed_vector& other) const
+    {
+        return impl_.equals(other.impl_);
+    }
+    IMMER_NODISCARD bool operator!=(const compressed_vector& other) const
+    {
+        return !(*this == other);
+    }
+
+    /*!
+     * Returns a vector with `value` inserted at the end.  It may
+     * allocate memory and its complexity is @f$ O(2^{BL}) @f$, since the
+     * uncompressed tail is copied, or compressed when it is completed.
+     * When called on an rvalue that is not shared, with a memory policy that
+     * uses transient rvalues, or through a transient, the tail grows in place
+     * instead and the complexity is *effectively* @f$ O(1) @f$, except when
+     * a block is completed and compressed.
+     */
+    IMMER_NODISCARD compressed_vector push_back(value_type value) const&
+    {
+        auto r = *this;
+        r.impl_.push_back_mut(value);
+        return r;
+    }
+
+    IMMER_NODISCARD decltype(auto) push_back(value_type value) &&
+    {
+        return push_back_move(move_t{}, value);
+    }
+
+    /*!
+     * Returns a vector containing value `value` at position `idx`.
+     * Undefined for `index >= size()`.  It may allocate memory and its
+     * complexity is *effectively* @f$ O(2^{BL}) @f$, since the block
+     * containing the element is encoded again.
+     */
+    IMMER_NODISCARD compressed_vector set(size_type index,
+                                          value_type value) const&
+    {
+        auto r = *this;
+        r.impl_.assoc_mut(index, value);
+        return r;
+    }
+
+    IMMER_NODISCARD decltype(auto) set(size_type index, value_type value) &&
+    {
+        return set_move(move_t{}, index, value);
+    }
+
+    /*!
+     * Returns a vector containing the result of the expression
+     * `fn((*this)[idx])` at position `idx`.  Undefined for `index >=
+     * size()`.  It may allocate memory and its complexity is
+     * *effectively* @f$ O(2^{BL}) @f$.
+     */
+    template <typename FnT>
+    IMMER_NODISCARD compressed_vector update(size_type index, FnT&& fn) const&
+    {
+        return set(index, std::forward<FnT>(fn)(impl_.get(index)));
+    }
+
+    template <typename FnT>
+    IMMER_NODISCARD decltype(auto) update(size_type index, FnT&& fn) &&
+    {
+        auto value = std::forward<FnT>(fn)(impl_.get(index));
+        return set_move(move_t{}, index, value);
+    }
+
+    /*!
+     * Returns a vector containing only the first `min(elems, size())`
+     * elements. It may allocate memory and its complexity is
+     * *effectively* @f$ O(2^{BL}) @f$.
+     */
+    IMMER_NODISCARD compressed_vector take(size_type elems) const&
+    {
+        auto r = *this;
+        r.impl_.take_mut(elems);
+        return r;
+    }
+
+    IMMER_NODISCARD decltype(auto) take(size_type elems) &&
+    {
+        return take_move(move_t{}, elems);
+    }
+
+    /*!
+     * Returns the number of bytes used to store the elements, not counting
+     * the inner nodes of the tree of blocks.  Its complexity is @f$
+     * O(size / 2^{BL}) @f$.
+     */
+    IMMER_NODISCARD std::size_t data_bytes() const { return impl_.bytes(); }
+
+    /*!
+     * Returns an @a transient form of this container, an
+     * `immer::compressed_vector_transient`.
+     */
+    IMMER_NODISCARD transient_type transient() const& { return impl_; }
+    IMMER_NODISCARD transient_type transient() && { return std::move(impl_); }
+
+    // Semi-private
+    const impl_t& impl() const { return impl_; }
+
+private:
+    friend transient_type;
+
+    compressed_vector(impl_t impl)
+        : impl_(std::move(impl))
+    {
+    }
+
+    compressed_vector&& push_back_move(std::true_type, value_type value)
+    {
+        impl_.push_back_mut(value);
+        return std::move(*this);
+    }
+    compressed_vector push_back_move(std::false_type, value_type value)
+    {
+        return push_back(value);
+    }
+
+    compressed_vector&&
+    set_move(std::true_type, size_type index, value_type value)
+    {
+        impl_.assoc_mut(index, value);
+        return std::move(*this);
+    }
+    compressed_vector
+    set_move(std::false_type, size_type index, value_type value)
+    {
+        return set(index, value);
+    }
+
+    compressed_vector&& take_move(std::true_type, size_type elems)
+    {
+        impl_.take_mut(elems);
+        return std::move(*this);
+    }
+    compressed_vector take_move(std::false_type, size_type elems)
+    {
+        return take(elems);
+    }
+
+    impl_t impl_ = {};
+};
+
+} // namespace immer
@@ -0,0 +1,240 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/array_transient.hpp>
+#include <immer/detail/compressed/tree.hpp>
+#include <immer/memory_policy.hpp>
+#include <immer/vector_transient.hpp>
+
+#include <iterator>
+
+namespace immer {
+
+template <typename T,
+          typename MemoryPolicy,
+          detail::rbts::bits_t B,
+          detail::rbts::bits_t BL>
+class compressed_vector;
+
+/*!
+ * Mutable version of `immer::compressed_vector`.
+ *
+ * @rst
+ *
+ * Refer to :doc:`transients` to learn more about when and how to use
+ * the mutable versions of immutable containers.
+ *
+ * @endrst
+ */
+template <typename T,
+          typename MemoryPolicy   = default_memory_policy,
+          detail::rbts::bits_t B  = default_bits,
+          detail::rbts::bits_t BL = 7>
+class compressed_vector_transient
+{
+    using impl_t   = detail::compressed::tree<T, MemoryPolicy, B, BL>;
+    using t_impl_t = detail::compressed::transient_tree<T, MemoryPolicy, B, BL>;
+    using block_t  = typename impl_t::block_t;
+
+    static constexpr auto block_size = impl_t::block_size;
+    static constexpr auto block_mask = impl_t::block_mask;
+
+public:
+    static constexpr auto bits      = B;
+    static constexpr auto bits_leaf = BL;
+    using memory_policy             = MemoryPolicy;
+
+    using value_type      = T;
+    using reference       = T;
+    using size_type       = detail::rbts::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = T;
+
+    using iterator         = detail::compressed::tree_iterator<t_impl_t>;
+    using const_iterator   = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using persistent_type = compressed_vector<T, MemoryPolicy, B, BL>;
+
+    /*!
+     * Default constructor.  It creates a mutable vector of `size() ==
+     * 0`.  It does not allocate memory and its complexity is
+     * @f$ O(1) @f$.
+     */
+    compressed_vector_transient() = default;
+
+    /*!
+     * Returns an iterator pointing at the first element of the
+     * collection. It does not allocate memory and its complexity is
+     * @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD iterator begin() const { return {impl_}; }
+
+    /*!
+     * Returns an iterator pointing just after the last element of the
+     * collection. It does not allocate and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD iterator end() const
+    {
+        return {impl_, typename iterator::end_t{}};
+    }
+
+    /*!
+     * Returns an iterator that traverses the collection backwards,
+     * pointing at the first element of the reversed collection. It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD reverse_iterator rbegin() const
+    {
+        return reverse_iterator{end()};
+    }
+
+    /*!
+     * Returns an iterator that traverses the collection backwards,
+     * pointing after the last element of the reversed collection. It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD reverse_iterator rend() const
+    {
+        return reverse_iterator{begin()};
+    }
+
+    /*!
+     * Returns the number of elements in the container.  It does
+     * not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD size_type size() const { return impl_.size(); }
+
+    /*!
+     * Returns `true` if there are no elements in the container.  It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD bool empty() const { return size() == 0; }
+
+    /*!
+     * Returns the element at position `index`.  It is undefined when
+     * @f$ index \geq size() @f$.  It does not allocate memory and its
+     * complexity is *effectively* @f$ O(2^{BL}) @f$.
+     */
+    reference operator[](size_type index) const
+    {
+        auto off = impl_.tail_offset();
+        return index >= off
+                   ? impl_.tail[index - off]
+                   : impl_.blocks[index >> BL].get(index & block_mask);
+    }
+
+    /*!
+     * Returns the element at position `index`.  It throws an
+     * `std::out_of_range` exception when @f$ index \geq size() @f$.
+     */
+    reference at(size_type index) const
+    {
+        if (index >= size())
+            IMMER_THROW(std::out_of_range{"index out of range"});
+        return (*this)[index];
+    }
+
+    /*!
+     * Inserts `value` at the end.  It may allocate memory and its
+     * complexity is *effectively* @f$ O(1) @f$.
+     */
+    void push_back(value_type value)
+    {
+        impl_.tail.push_back(value);
+        if (impl_.tail.size() == block_size) {
+            impl_.blocks.push_back(
+                block_t::encode(impl_.tail.data(), block_size));
+            // keeps the buffer of the tail when it is not shared
+            impl_.tail.take(0);
+        }
+    }
+
+    /*!
+     * Sets to the value `value` at position `idx`.  Undefined for
+     * `index >= size()`.  It may allocate memory and its complexity is
+     * *effectively* @f$ O(2^{BL}) @f$.
+     */
+    void set(size_type index, value_type value)
+    {
+        auto off = impl_.tail_offset();
+        if (index >= off) {
+            impl_.tail.set(index - off, value);
+        } else {
+            T buf[block_size];
+            auto bi = index >> BL;
+            impl_.blocks[bi].decode(buf, block_size);
+            buf[index & block_mask] = value;
+            impl_.blocks.set(bi, block_t::encode(buf, block_size));
+        }
+    }
+
+    /*!
+     * Updates the vector to contain the result of the expression
+     * `fn((*this)[idx])` at position `idx`.  Undefined for `index >=
+     * size()`.  It may allocate memory and its complexity is
+     * *effectively* @f$ O(2^{BL}) @f$.
+     */
+    template <typename FnT>
+    void update(size_type index, FnT&& fn)
+    {
+        set(index, std::forward<FnT>(fn)((*this)[index]));
+    }
+
+    /*!
+     * Resizes the vector to only contain the first `min(elems, size())`
+     * elements. It may allocate memory and its complexity is
+     * *effectively* @f$ O(2^{BL}) @f$.
+     */
+    void take(size_type elems)
+    {
+        auto off = impl_.tail_offset();
+        if (elems >= size()) {
+            return;
+        } else if (elems >= off) {
+            impl_.tail.take(elems - off);
+        } else {
+            T buf[block_size];
+            auto bi = elems >> BL;
+            impl_.blocks[bi].decode(buf, elems & block_mask);
+            impl_.tail.take(0);
+            for (auto i = size_type{}; i < (elems & block_mask); ++i)
+                impl_.tail.push_back(buf[i]);
+            impl_.blocks.take(bi);
+        }
+    }
+
+    /*!
+     * Returns an @a immutable form of this container, an
+     * `immer::compressed_vector`.
+     */
+    IMMER_NODISCARD persistent_type persistent() &
+    {
+        return impl_t{impl_.blocks.persistent(), impl_.tail.persistent()};
+    }
+    IMMER_NODISCARD persistent_type persistent() &&
+    {
+        return impl_t{std::move(impl_.blocks).persistent(),
+                      std::move(impl_.tail).persistent()};
+    }
+
+private:
+    friend persistent_type;
+
+    compressed_vector_transient(impl_t impl)
+        : impl_{std::move(impl.blocks).transient(),
+                std::move(impl.tail).transient()}
+    {
+    }
+
+    t_impl_t impl_ = {};
+};
+
+} // namespace immer
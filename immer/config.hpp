@@ -129,6 +129,14 @@
 #endif
 #endif
 
+#ifndef IMMER_ENABLE_COUNTING_HEAP
+#define IMMER_ENABLE_COUNTING_HEAP 0
+#endif
+
+#ifndef IMMER_CACHE_LINE_SIZE
+#define IMMER_CACHE_LINE_SIZE 64
+#endif
+
 #ifndef IMMER_THROW_ON_INVALID_STATE
 #define IMMER_THROW_ON_INVALID_STATE 0
 #endif
@@ -0,0 +1,140 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/config.hpp>
+#include <immer/detail/rbts/cursor.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace immer {
+
+/*!
+ * Provides random access to the elements of an `immer::vector` or
+ * `immer::flex_vector` that is fast when consecutive accesses are close to
+ * each other.
+ *
+ * Indexing a vector descends from the root of the tree every time.  A cursor
+ * remembers the leaf containing the last accessed element and the path of
+ * inner nodes leading to it.  Accessing another element in the same leaf is
+ * @f$ O(1) @f$, and accessing an element further away only descends from the
+ * lowest common ancestor of both elements, which is @f$ O(1) @f$ amortized
+ * for sequential and mostly local access patterns.
+ *
+ * The cursor holds a copy of the vector, so it remains valid no matter what
+ * happens to the original.  Unlike the vector, seeking mutates the cursor, so
+ * a cursor can not be shared between threads without synchronization.
+ *
+ * @tparam Vector An `immer::vector` or `immer::flex_vector`.
+ *
+ * @rst
+ *
+ * **Example**
+ *   .. literalinclude:: ../example/vector/cursor.cpp
+ *      :language: c++
+ *      :dedent: 8
+ *      :start-after: cursor/start
+ *      :end-before:  cursor/end
+ *
+ * @endrst
+ */
+template <typename Vector>
+class cursor
+{
+    using impl_t  = std::decay_t<decltype(std::declval<Vector>().impl())>;
+    using state_t = detail::rbts::cursor_state<typename impl_t::node_t>;
+
+public:
+    using container_type  = Vector;
+    using value_type      = typename Vector::value_type;
+    using reference       = const value_type&;
+    using size_type       = typename Vector::size_type;
+    using difference_type = std::ptrdiff_t;
+
+    /*!
+     * Default constructor.  It creates a cursor over an empty vector.
+     */
+    cursor() = default;
+
+    /*!
+     * Creates a cursor over the vector `v`, initially at index 0.  It does
+     * not allocate memory and its complexity is @f$ O(log(size)) @f$, since
+     * it descends to the first leaf when `v` is not empty.
+     */
+    explicit cursor(Vector v)
+        : v_{std::move(v)}
+    {
+        if (!v_.empty())
+            seek(0);
+    }
+
+    /*!
+     * Returns the vector that this cursor traverses.
+     */
+    IMMER_NODISCARD const Vector& container() const { return v_; }
+
+    /*!
+     * Returns the number of elements in the container.
+     */
+    IMMER_NODISCARD size_type size() const { return v_.size(); }
+
+    /*!
+     * Returns the index of the current element.
+     */
+    IMMER_NODISCARD size_type index() const { return i_; }
+
+    /*!
+     * Moves the cursor to the element at `index`, which must be lower than
+     * `size()`.
+     */
+    void seek(size_type index)
+    {
+        ptr_ = state_.seek(v_.impl(), index);
+        i_   = index;
+    }
+
+    /*!
+     * Moves the cursor `n` positions forward, or backwards when negative.
+     */
+    void advance(difference_type n) { seek(i_ + n); }
+
+    /*!
+     * Returns the element at `index()`.  It is undefined when the container
+     * is empty.
+     */
+    IMMER_NODISCARD reference get() const { return *ptr_; }
+
+    /*!
+     * Moves the cursor to `index` and returns the element there.
+     */
+    reference operator[](size_type index)
+    {
+        seek(index);
+        return *ptr_;
+    }
+
+private:
+    Vector v_              = {};
+    size_type i_           = 0;
+    const value_type* ptr_ = nullptr;
+    state_t state_         = {};
+};
+
+/*!
+ * Returns a `cursor` over the vector `v`.
+ */
+template <typename Vector>
+cursor<Vector> make_cursor(Vector v)
+{
+    return cursor<Vector>{std::move(v)};
+}
+
+} // namespace immer
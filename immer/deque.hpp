@@ -0,0 +1,386 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/config.hpp>
+#include <immer/detail/deque/deque_impl.hpp>
+#include <immer/memory_policy.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+namespace immer {
+
+template <typename T,
+          typename MemoryPolicy,
+          detail::rbts::bits_t B,
+          detail::rbts::bits_t BL>
+class deque_transient;
+
+/*!
+ * Immutable sequential container supporting random access and efficient
+ * insertion and removal at both ends.
+ *
+ * @tparam T The type of the values to be stored in the container.
+ * @tparam MemoryPolicy Memory management policy. See @ref
+ *         memory_policy.
+ *
+ * @rst
+ *
+ * This is a ``flex_vector`` with an extra buffer for the elements at the
+ * front, similar to the ``tail`` that vectors keep for the elements at the
+ * back.  The buffer holds up to :math:`2^{BL}` elements in reverse order.
+ * Adding or removing elements at the front just changes the end of the
+ * buffer, and only when it becomes full or empty half of its capacity is
+ * moved between the buffer and the ``flex_vector``.  Since at least that
+ * many operations happen between two moves, even when alternating at the
+ * boundary, ``push_front`` and ``pop_front`` are *effectively*
+ * :math:`O(1)` amortized, while
+ * ``flex_vector::push_front`` concatenates a new vector and creates new
+ * relaxed nodes every time.
+ *
+ * **Example**
+ *   .. literalinclude:: ../example/deque/intro.cpp
+ *      :language: c++
+ *      :start-after: intro/start
+ *      :end-before:  intro/end
+ *
+ * @endrst
+ */
+template <typename T,
+          typename MemoryPolicy  = default_memory_policy,
+          detail::rbts::bits_t B = default_bits,
+          detail::rbts::bits_t BL =
+              detail::rbts::derive_bits_leaf<T, MemoryPolicy, B>>
+class deque
+{
+    using impl_t = detail::deque::deque_impl<T, MemoryPolicy, B, BL>;
+
+    using move_t =
+        std::integral_constant<bool, MemoryPolicy::use_transient_rvalues>;
+
+public:
+    static constexpr auto bits      = B;
+    static constexpr auto bits_leaf = BL;
+    using memory_policy             = MemoryPolicy;
+
+    using value_type      = T;
+    using reference       = const T&;
+    using size_type       = detail::rbts::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = const T&;
+
+    using iterator = detail::deque::deque_iterator<T, MemoryPolicy, B, BL>;
+    using const_iterator   = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using transient_type   = deque_transient<T, MemoryPolicy, B, BL>;
+    using flex_vector_type = flex_vector<T, MemoryPolicy, B, BL>;
+
+    /*!
+     * Default constructor.  It creates a deque of `size() == 0`.  It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    deque() = default;
+
+    /*!
+     * Constructs a deque containing the elements in `values`.
+     */
+    deque(std::initializer_list<T> values)
+        : impl_{{}, flex_vector_type(values)}
+    {
+    }
+
+    /*!
+     * Constructs a deque containing the elements in the range
+     * defined by the input iterator `first` and range sentinel `last`.
+     */
+    template <typename Iter,
+              typename Sent,
+              std::enable_if_t<detail::compatible_sentinel_v<Iter, Sent>,
+                               bool> = true>
+    deque(Iter first, Sent last)
+        : impl_{{}, flex_vector_type(first, last)}
+    {
+    }
+
+    /*!
+     * Constructs a deque containing the element `val` repeated `n`
+     * times.
+     */
+    deque(size_type n, T v = {})
+        : impl_{{}, flex_vector_type(n, v)}
+    {
+    }
+
+    /*!
+     * Constructs a deque with the elements of `v`.  It does not allocate
+     * memory and its complexity is @f$ O(1) @f$.
+     */
+    deque(flex_vector_type v)
+        : impl_{{}, std::move(v)}
+    {
+    }
+
+    /*!
+     * Returns an iterator pointing at the first element of the
+     * collection. It does not allocate memory and its complexity is
+     * @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD iterator begin() const { return {impl_}; }
+
+    /*!
+     * Returns an iterator pointing just after the last element of the
+     * collection. It does not allocate and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD iterator end() const
+    {
+        return {impl_, typename iterator::end_t{}};
+    }
+
+    /*!
+     * Returns an iterator that traverses the collection backwards,
+     * pointing at the first element of the reversed collection. It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD reverse_iterator rbegin() const
+    {
+        return reverse_iterator{end()};
+    }
+
+    /*!
+     * Returns an iterator that traverses the collection backwards,
+     * pointing after the last element of the reversed collection. It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD reverse_iterator rend() const
+    {
+        return reverse_iterator{begin()};
+    }
+
+    /*!
+     * Returns the number of elements in the container.  It does
+     * not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD size_type size() const { return impl_.size(); }
+
+    /*!
+     * Returns `true` if there are no elements in the container.  It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD bool empty() const { return size() == 0; }
+
+    /*!
+     * Access the first element.
+     */
+    IMMER_NODISCARD const T& front() const { return impl_.front(); }
+
+    /*!
+     * Access the last element.
+     */
+    IMMER_NODISCARD const T& back() const { return impl_.back(); }
+
+    /*!
+     * Returns a `const` reference to the element at position `index`.
+     * It is undefined when @f$ 0 index \geq size() @f$.  It does not
+     * allocate memory and its complexity is *effectively* @f$ O(1)
+     * @f$.
+     */
+    IMMER_NODISCARD reference operator[](size_type index) const
+    {
+        return impl_.get(index);
+    }
+
+    /*!
+     * Returns a `const` reference to the element at position
+     * `index`. It throws an `std::out_of_range` exception when @f$
+     * index \geq size() @f$.  It does not allocate memory and its
+     * complexity is *effectively* @f$ O(1) @f$.
+     */
+    reference at(size_type index) const { return impl_.get_check(index); }
+
+    /*!
+     * Returns whether the deques are equal.
+     */
+    IMMER_NODISCARD bool operator==(const deque& other) const
+    {
+        return size() == other.size() &&
+               (impl_.head == other.impl_.head
+                    ? impl_.body == other.impl_.body
+                    : std::equal(begin(), end(), other.begin()));
+    }
+    IMMER_NODISCARD bool operator!=(const deque& other) const
+    {
+        return !(*this == other);
+    }
+
+    /*!
+     * Returns a deque with `value` inserted at the front.  It may
+     * allocate memory and its complexity is *effectively* @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD deque push_front(value_type value) const&
+    {
+        auto r = *this;
+        r.impl_.push_front_mut(std::move(value));
+        return r;
+    }
+
+    IMMER_NODISCARD decltype(auto) push_front(value_type value) &&
+    {
+        return modify_move(move_t{}, [&](impl_t& impl) {
+            impl.push_front_mut(std::move(value));
+        });
+    }
+
+    /*!
+     * Returns a deque with `value` inserted at the end.  It may
+     * allocate memory and its complexity is *effectively* @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD deque push_back(value_type value) const&
+    {
+        auto r = *this;
+        r.impl_.push_back_mut(std::move(value));
+        return r;
+    }
+
+    IMMER_NODISCARD decltype(auto) push_back(value_type value) &&
+    {
+        return modify_move(move_t{}, [&](impl_t& impl) {
+            impl.push_back_mut(std::move(value));
+        });
+    }
+
+    /*!
+     * Returns a deque without the first element.  It is undefined when
+     * the deque is empty.  It may allocate memory and its complexity is
+     * *effectively* @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD deque pop_front() const&
+    {
+        auto r = *this;
+        r.impl_.pop_front_mut();
+        return r;
+    }
+
+    IMMER_NODISCARD decltype(auto) pop_front() &&
+    {
+        return modify_move(move_t{},
+                           [&](impl_t& impl) { impl.pop_front_mut(); });
+    }
+
+    /*!
+     * Returns a deque without the last element.  It is undefined when the
+     * deque is empty.  It may allocate memory and its complexity is
+     * *effectively* @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD deque pop_back() const&
+    {
+        auto r = *this;
+        r.impl_.pop_back_mut();
+        return r;
+    }
+
+    IMMER_NODISCARD decltype(auto) pop_back() &&
+    {
+        return modify_move(move_t{},
+                           [&](impl_t& impl) { impl.pop_back_mut(); });
+    }
+
+    /*!
+     * Returns a deque containing value `value` at position `idx`.
+     * Undefined for `index >= size()`.  It may allocate memory and its
+     * complexity is *effectively* @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD deque set(size_type index, value_type value) const&
+    {
+        auto r = *this;
+        r.impl_.assoc_mut(index, std::move(value));
+        return r;
+    }
+
+    IMMER_NODISCARD decltype(auto) set(size_type index, value_type value) &&
+    {
+        return modify_move(move_t{}, [&](impl_t& impl) {
+            impl.assoc_mut(index, std::move(value));
+        });
+    }
+
+    /*!
+     * Returns a deque containing the result of the expression
+     * `fn((*this)[idx])` at position `idx`.  Undefined for `index >=
+     * size()`.  It may allocate memory and its complexity is
+     * *effectively* @f$ O(1) @f$.
+     */
+    template <typename FnT>
+    IMMER_NODISCARD deque update(size_type index, FnT&& fn) const&
+    {
+        auto r = *this;
+        r.impl_.update_mut(index, std::forward<FnT>(fn));
+        return r;
+    }
+
+    template <typename FnT>
+    IMMER_NODISCARD decltype(auto) update(size_type index, FnT&& fn) &&
+    {
+        return modify_move(move_t{}, [&](impl_t& impl) {
+            impl.update_mut(index, std::forward<FnT>(fn));
+        });
+    }
+
+    /*!
+     * Returns a `flex_vector` with the elements of the deque.  It may
+     * allocate memory and its complexity is @f$ O(log(size)) @f$.
+     */
+    IMMER_NODISCARD flex_vector_type flex() const
+    {
+        if (impl_.head.empty())
+            return impl_.body;
+        auto r = impl_;
+        r.flush_head();
+        return r.body;
+    }
+
+    /*!
+     * Returns an @a transient form of this container, an
+     * `immer::deque_transient`.
+     */
+    IMMER_NODISCARD transient_type transient() const& { return impl_; }
+    IMMER_NODISCARD transient_type transient() && { return std::move(impl_); }
+
+    // Semi-private
+    const impl_t& impl() const { return impl_; }
+
+private:
+    friend transient_type;
+
+    deque(impl_t impl)
+        : impl_(std::move(impl))
+    {
+    }
+
+    template <typename Fn>
+    deque&& modify_move(std::true_type, Fn&& fn)
+    {
+        fn(impl_);
+        return std::move(*this);
+    }
+    template <typename Fn>
+    deque modify_move(std::false_type, Fn&& fn)
+    {
+        auto r = *this;
+        fn(r.impl_);
+        return r;
+    }
+
+    impl_t impl_ = {};
+};
+
+} // namespace immer
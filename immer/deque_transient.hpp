@@ -0,0 +1,226 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/array_transient.hpp>
+#include <immer/detail/deque/deque_impl.hpp>
+#include <immer/flex_vector_transient.hpp>
+#include <immer/memory_policy.hpp>
+
+#include <iterator>
+
+namespace immer {
+
+template <typename T,
+          typename MemoryPolicy,
+          detail::rbts::bits_t B,
+          detail::rbts::bits_t BL>
+class deque;
+
+/*!
+ * Mutable version of `immer::deque`.
+ *
+ * @rst
+ *
+ * Refer to :doc:`transients` to learn more about when and how to use
+ * the mutable versions of immutable containers.
+ *
+ * @endrst
+ */
+template <typename T,
+          typename MemoryPolicy  = default_memory_policy,
+          detail::rbts::bits_t B = default_bits,
+          detail::rbts::bits_t BL =
+              detail::rbts::derive_bits_leaf<T, MemoryPolicy, B>>
+class deque_transient
+{
+    using impl_t = detail::deque::deque_impl<T, MemoryPolicy, B, BL>;
+    using head_t = typename impl_t::head_t::transient_type;
+    using body_t = typename impl_t::body_t::transient_type;
+
+    static constexpr auto head_capacity = impl_t::head_capacity;
+    static constexpr auto head_chunk    = impl_t::head_chunk;
+
+public:
+    static constexpr auto bits      = B;
+    static constexpr auto bits_leaf = BL;
+    using memory_policy             = MemoryPolicy;
+
+    using value_type      = T;
+    using reference       = const T&;
+    using size_type       = detail::rbts::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = const T&;
+
+    using persistent_type = deque<T, MemoryPolicy, B, BL>;
+
+    /*!
+     * Default constructor.  It creates a mutable deque of `size() ==
+     * 0`.  It does not allocate memory and its complexity is
+     * @f$ O(1) @f$.
+     */
+    deque_transient() = default;
+
+    /*!
+     * Returns the number of elements in the container.  It does
+     * not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD size_type size() const
+    {
+        return head_.size() + body_.size();
+    }
+
+    /*!
+     * Returns `true` if there are no elements in the container.  It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD bool empty() const { return size() == 0; }
+
+    /*!
+     * Returns a `const` reference to the element at position `index`.
+     * It is undefined when @f$ 0 index \geq size() @f$.  It does not
+     * allocate memory and its complexity is *effectively* @f$ O(1)
+     * @f$.
+     */
+    reference operator[](size_type index) const
+    {
+        auto hs = head_.size();
+        return index < hs ? head_.data()[hs - 1 - index] : body_[index - hs];
+    }
+
+    /*!
+     * Returns a `const` reference to the element at position
+     * `index`. It throws an `std::out_of_range` exception when @f$
+     * index \geq size() @f$.
+     */
+    reference at(size_type index) const
+    {
+        if (index >= size())
+            IMMER_THROW(std::out_of_range{"index out of range"});
+        return (*this)[index];
+    }
+
+    /*!
+     * Inserts `value` at the front.  It may allocate memory and its
+     * complexity is *effectively* @f$ O(1) @f$.
+     */
+    void push_front(value_type value)
+    {
+        if (head_.size() == head_capacity) {
+            // only the half closest to the body is moved, so that popping
+            // right after does not have to refill the head
+            auto first = head_.begin();
+            auto chunk =
+                typename impl_t::body_t(
+                    std::make_reverse_iterator(first + head_chunk),
+                    std::make_reverse_iterator(first))
+                    .transient();
+            chunk.append(std::move(body_));
+            body_ = std::move(chunk);
+            head_ = typename impl_t::head_t(first + head_chunk, head_.end())
+                        .transient();
+        }
+        head_.push_back(std::move(value));
+    }
+
+    /*!
+     * Inserts `value` at the end.  It may allocate memory and its
+     * complexity is *effectively* @f$ O(1) @f$.
+     */
+    void push_back(value_type value) { body_.push_back(std::move(value)); }
+
+    /*!
+     * Removes the first element.  It is undefined when the deque is
+     * empty.  Its complexity is *effectively* @f$ O(1) @f$.
+     */
+    void pop_front()
+    {
+        assert(size() > 0);
+        if (!head_.empty()) {
+            head_.take(head_.size() - 1);
+        } else {
+            auto n = std::min(body_.size(), size_type{head_chunk});
+            for (auto i = n; i > 1; --i)
+                head_.push_back(body_[i - 1]);
+            body_.drop(n);
+        }
+    }
+
+    /*!
+     * Removes the last element.  It is undefined when the deque is
+     * empty.  Its complexity is *effectively* @f$ O(1) @f$.
+     */
+    void pop_back()
+    {
+        assert(size() > 0);
+        if (!body_.empty())
+            body_.take(body_.size() - 1);
+        else
+            head_ = typename impl_t::head_t(head_.begin() + 1, head_.end())
+                        .transient();
+    }
+
+    /*!
+     * Sets to the value `value` at position `idx`.  Undefined for
+     * `index >= size()`.  It may allocate memory and its complexity is
+     * *effectively* @f$ O(1) @f$.
+     */
+    void set(size_type index, value_type value)
+    {
+        auto hs = head_.size();
+        if (index < hs)
+            head_.set(hs - 1 - index, std::move(value));
+        else
+            body_.set(index - hs, std::move(value));
+    }
+
+    /*!
+     * Updates the deque to contain the result of the expression
+     * `fn((*this)[idx])` at position `idx`.  Undefined for `index >=
+     * size()`.  It may allocate memory and its complexity is
+     * *effectively* @f$ O(1) @f$.
+     */
+    template <typename FnT>
+    void update(size_type index, FnT&& fn)
+    {
+        auto hs = head_.size();
+        if (index < hs)
+            head_.update(hs - 1 - index, std::forward<FnT>(fn));
+        else
+            body_.update(index - hs, std::forward<FnT>(fn));
+    }
+
+    /*!
+     * Returns an @a immutable form of this container, an
+     * `immer::deque`.
+     */
+    IMMER_NODISCARD persistent_type persistent() &
+    {
+        return impl_t{head_.persistent(), body_.persistent()};
+    }
+    IMMER_NODISCARD persistent_type persistent() &&
+    {
+        return impl_t{std::move(head_).persistent(),
+                      std::move(body_).persistent()};
+    }
+
+private:
+    friend persistent_type;
+
+    deque_transient(impl_t impl)
+        : head_(std::move(impl.head).transient())
+        , body_(std::move(impl.body).transient())
+    {
+    }
+
+    head_t head_ = {};
+    body_t body_ = {};
+};
+
+} // namespace immer
@@ -99,6 +99,8 @@ struct no_capacity
     {
         if (!ptr->can_mutate(e))
             ptr = node_t::copy_e(e, size, ptr, size);
+        else
+            node_t::trace::on_mutate();
         return data();
     }
 
@@ -12,6 +12,7 @@
 #include <immer/detail/combine_standard_layout.hpp>
 #include <immer/detail/type_traits.hpp>
 #include <immer/detail/util.hpp>
+#include <immer/heap/traced_heap.hpp>
 
 #include <cstddef>
 #include <limits>
@@ -24,7 +25,8 @@ template <typename T, typename MemoryPolicy>
 struct node
 {
     using memory     = MemoryPolicy;
-    using heap       = typename MemoryPolicy::heap::type;
+    using trace      = get_trace_policy_t<memory>;
+    using heap = detail::traced_heap_t<trace, typename memory::heap::type>;
     using transience = typename memory::transience_t;
     using refs_t     = typename memory::refcount;
     using ownee_t    = typename transience::ownee;
@@ -109,6 +111,7 @@ struct node
 
     static node_t* copy_n(size_t n, node_t* p, size_t count)
     {
+        trace::on_copy(count);
         return copy_n(n, p->data(), p->data() + count);
     }
 
@@ -122,6 +125,7 @@ struct node
 
     static node_t* copy_e(edit_t e, size_t n, node_t* p, size_t count)
     {
+        trace::on_copy(count);
         return copy_e(e, n, p->data(), p->data() + count);
     }
 };
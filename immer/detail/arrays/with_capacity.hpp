@@ -108,6 +108,8 @@ struct with_capacity
             auto p = node_t::copy_e(e, capacity, ptr, size);
             dec();
             ptr = p;
+        } else {
+            node_t::trace::on_mutate();
         }
         return data();
     }
@@ -210,6 +212,7 @@ struct with_capacity
     void push_back_mut(edit_t e, T value)
     {
         if (ptr->can_mutate(e) && capacity > size) {
+            node_t::trace::on_mutate();
             new (data() + size) T(std::move(value));
             ++size;
         } else {
@@ -242,6 +245,7 @@ struct with_capacity
     void assoc_mut(edit_t e, std::size_t idx, T value)
     {
         if (ptr->can_mutate(e)) {
+            node_t::trace::on_mutate();
             data()[idx] = std::move(value);
         } else {
             auto p = node_t::copy_n(capacity, ptr, size);
@@ -275,6 +279,7 @@ struct with_capacity
     void update_mut(edit_t e, std::size_t idx, Fn&& op)
     {
         if (ptr->can_mutate(e)) {
+            node_t::trace::on_mutate();
             auto& elem = data()[idx];
             elem       = std::forward<Fn>(op)(std::move(elem));
         } else {
@@ -303,6 +308,7 @@ struct with_capacity
     {
         assert(sz <= size);
         if (ptr->can_mutate(e)) {
+            node_t::trace::on_mutate();
             detail::destroy_n(data() + size, size - sz);
             size = sz;
         } else {
@@ -0,0 +1,167 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/array.hpp>
+#include <immer/array_transient.hpp>
+#include <immer/detail/util.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace immer {
+namespace detail {
+namespace compressed {
+
+using word_t = std::uint64_t;
+
+constexpr unsigned word_bits = 64;
+
+inline unsigned bit_width(word_t x)
+{
+    return x ? static_cast<unsigned>(log2(x)) + 1 : 0;
+}
+
+inline word_t unpack(const word_t* words, std::size_t bit, unsigned width)
+{
+    auto idx = bit / word_bits;
+    auto off = static_cast<unsigned>(bit % word_bits);
+    auto x   = words[idx] >> off;
+    if (off + width > word_bits)
+        x |= words[idx + 1] << (word_bits - off);
+    return width == word_bits ? x : x & ((word_t{1} << width) - 1);
+}
+
+inline void pack(word_t* words, std::size_t bit, unsigned width, word_t x)
+{
+    auto idx = bit / word_bits;
+    auto off = static_cast<unsigned>(bit % word_bits);
+    words[idx] |= x << off;
+    if (off + width > word_bits)
+        words[idx + 1] |= x >> (word_bits - off);
+}
+
+/*!
+ * Immutable run of integers stored as the first value followed by the
+ * differences between consecutive values.  The differences are stored
+ * relative to the smallest of them (frame of reference) using only as many
+ * bits as needed for the largest one.  Monotonic sequences with a regular
+ * step thus use very few bits per element.
+ *
+ * Values are converted to 64 bit unsigned integers, so that differences can
+ * be computed with wrap around arithmetic for every integral `T`.
+ */
+template <typename T, typename MemoryPolicy>
+struct block
+{
+    static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(word_t),
+                  "compressed blocks only support integers up to 64 bits");
+
+    using words_t = array<word_t, MemoryPolicy>;
+
+    word_t first     = 0;
+    word_t min_delta = 0;
+    unsigned width   = 0;
+    words_t words    = {};
+
+    static word_t to_word(T x) { return static_cast<word_t>(x); }
+    static T from_word(word_t x) { return static_cast<T>(x); }
+
+    static block encode(const T* data, std::size_t n)
+    {
+        assert(n > 0);
+        auto b  = block{};
+        b.first = to_word(data[0]);
+        if (n == 1)
+            return b;
+        // differences are compared as signed so that a sequence that
+        // decreases now and then does not need the full 64 bits
+        auto lo = std::numeric_limits<std::int64_t>::max();
+        auto hi = std::numeric_limits<std::int64_t>::min();
+        for (auto i = std::size_t{1}; i < n; ++i) {
+            auto d = static_cast<std::int64_t>(to_word(data[i]) -
+                                               to_word(data[i - 1]));
+            lo     = std::min(lo, d);
+            hi     = std::max(hi, d);
+        }
+        b.min_delta = static_cast<word_t>(lo);
+        b.width =
+            bit_width(static_cast<word_t>(hi) - static_cast<word_t>(lo));
+        if (b.width) {
+            auto bits = (n - 1) * b.width;
+            auto ws   = words_t((bits + word_bits - 1) / word_bits, 0)
+                          .transient();
+            auto w    = ws.data_mut();
+            for (auto i = std::size_t{1}; i < n; ++i) {
+                auto d = to_word(data[i]) - to_word(data[i - 1]);
+                pack(w, (i - 1) * b.width, b.width, d - b.min_delta);
+            }
+            b.words = ws.persistent();
+        }
+        return b;
+    }
+
+    /*!
+     * Writes the first `n` values of the block into `out`.
+     */
+    void decode(T* out, std::size_t n) const
+    {
+        auto v = first;
+        if (width == 0) {
+            for (auto i = std::size_t{}; i < n; ++i, v += min_delta)
+                out[i] = from_word(v);
+        } else {
+            auto w = words.data();
+            out[0] = from_word(v);
+            for (auto i = std::size_t{1}; i < n; ++i) {
+                v += min_delta + unpack(w, (i - 1) * width, width);
+                out[i] = from_word(v);
+            }
+        }
+    }
+
+    T get(std::size_t idx) const { return from_word(get_word(idx)); }
+
+    word_t get_word(std::size_t idx) const
+    {
+        auto v = first + idx * min_delta;
+        if (width) {
+            auto w = words.data();
+            for (auto i = std::size_t{}; i < idx; ++i)
+                v += unpack(w, i * width, width);
+        }
+        return v;
+    }
+
+    /*!
+     * Difference between the values at `idx` and `idx - 1`, as words.
+     */
+    word_t delta(std::size_t idx) const
+    {
+        assert(idx > 0);
+        return width ? min_delta +
+                           unpack(words.data(), (idx - 1) * width, width)
+                     : min_delta;
+    }
+
+    /*!
+     * Number of bytes used by the block, including the packed words.
+     */
+    std::size_t bytes() const
+    {
+        return sizeof(block) + words.size() * sizeof(word_t);
+    }
+};
+
+} // namespace compressed
+} // namespace detail
+} // namespace immer
@@ -0,0 +1,340 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/array.hpp>
+#include <immer/config.hpp>
+#include <immer/detail/compressed/block.hpp>
+#include <immer/detail/iterator_facade.hpp>
+#include <immer/detail/rbts/bits.hpp>
+#include <immer/vector.hpp>
+#include <immer/vector_transient.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+namespace immer {
+namespace detail {
+namespace compressed {
+
+using rbts::bits_t;
+
+template <typename T, typename MemoryPolicy>
+bool operator==(const block<T, MemoryPolicy>& a,
+                const block<T, MemoryPolicy>& b)
+{
+    // the encoding is deterministic, so equal values have equal blocks
+    return a.first == b.first && a.min_delta == b.min_delta &&
+           a.width == b.width && a.words == b.words;
+}
+
+template <typename T, typename MemoryPolicy>
+bool operator!=(const block<T, MemoryPolicy>& a,
+                const block<T, MemoryPolicy>& b)
+{
+    return !(a == b);
+}
+
+/*!
+ * A persistent vector of compressed blocks of @f$ 2^{BL} @f$ elements, plus
+ * an uncompressed tail with the last elements.  The tail is compressed as
+ * soon as it is full, so that equal vectors always have the same blocks.
+ */
+template <typename T, typename MemoryPolicy, bits_t B, bits_t BL>
+struct tree
+{
+    using value_type = T;
+    using block_t    = block<T, MemoryPolicy>;
+    using blocks_t   = vector<block_t, MemoryPolicy, B>;
+    using tail_t     = array<T, MemoryPolicy>;
+
+    static constexpr auto bits_leaf  = BL;
+    static constexpr auto block_size = std::size_t{1} << BL;
+    static constexpr auto block_mask = block_size - 1;
+
+    blocks_t blocks;
+    tail_t tail;
+
+    template <typename Iter, typename Sent>
+    static tree from_range(Iter first, Sent last)
+    {
+        auto bs   = blocks_t{}.transient();
+        auto buf  = std::array<T, block_size>{};
+        auto size = std::size_t{};
+        for (; first != last; ++first) {
+            buf[size++] = *first;
+            if (size == block_size) {
+                bs.push_back(block_t::encode(buf.data(), size));
+                size = 0;
+            }
+        }
+        return {bs.persistent(), tail_t(buf.data(), buf.data() + size)};
+    }
+
+    std::size_t size() const { return tail_offset() + tail.size(); }
+
+    std::size_t tail_offset() const { return blocks.size() * block_size; }
+
+    T get(std::size_t idx) const
+    {
+        auto off = tail_offset();
+        return idx >= off ? tail[idx - off]
+                          : blocks[idx >> BL].get(idx & block_mask);
+    }
+
+    T get_check(std::size_t idx) const
+    {
+        if (idx >= size())
+            IMMER_THROW(std::out_of_range{"index out of range"});
+        return get(idx);
+    }
+
+    template <typename Fn>
+    void for_each_chunk(Fn&& fn) const
+    {
+        for_each_chunk(0, size(), std::forward<Fn>(fn));
+    }
+
+    template <typename Fn>
+    void for_each_chunk(std::size_t first, std::size_t last, Fn&& fn) const
+    {
+        for_each_chunk_p(first, last, [&](auto f, auto l) {
+            fn(f, l);
+            return true;
+        });
+    }
+
+    template <typename Fn>
+    bool for_each_chunk_p(Fn&& fn) const
+    {
+        return for_each_chunk_p(0, size(), std::forward<Fn>(fn));
+    }
+
+    template <typename Fn>
+    bool for_each_chunk_p(std::size_t first, std::size_t last, Fn&& fn) const
+    {
+        T buf[block_size];
+        auto off = tail_offset();
+        while (first < last && first < off) {
+            auto base = first & ~block_mask;
+            auto end  = std::min(last, base + block_size) - base;
+            blocks[first >> BL].decode(buf, end);
+            if (!fn(as_const(buf) + (first - base), as_const(buf) + end))
+                return false;
+            first = base + end;
+        }
+        return first >= last ||
+               fn(tail.data() + (first - off), tail.data() + (last - off));
+    }
+
+    bool equals(const tree& other) const
+    {
+        return blocks.size() == other.blocks.size() &&
+               tail == other.tail && blocks == other.blocks;
+    }
+
+    void push_back_mut(T value)
+    {
+        tail = std::move(tail).push_back(value);
+        if (tail.size() == block_size) {
+            blocks = std::move(blocks).push_back(
+                block_t::encode(tail.data(), block_size));
+            tail = tail_t{};
+        }
+    }
+
+    void assoc_mut(std::size_t idx, T value)
+    {
+        auto off = tail_offset();
+        if (idx >= off) {
+            tail = std::move(tail).set(idx - off, value);
+        } else {
+            T buf[block_size];
+            auto bi = idx >> BL;
+            blocks[bi].decode(buf, block_size);
+            buf[idx & block_mask] = value;
+            blocks                = std::move(blocks).set(
+                bi, block_t::encode(buf, block_size));
+        }
+    }
+
+    void take_mut(std::size_t n)
+    {
+        auto off = tail_offset();
+        if (n >= size()) {
+            return;
+        } else if (n >= off) {
+            tail = std::move(tail).take(n - off);
+        } else {
+            T buf[block_size];
+            auto bi = n >> BL;
+            blocks[bi].decode(buf, n & block_mask);
+            tail   = tail_t(buf, buf + (n & block_mask));
+            blocks = std::move(blocks).take(bi);
+        }
+    }
+
+    /*!
+     * Bytes used by the compressed blocks and the tail, not counting the
+     * inner nodes of the vector of blocks.
+     */
+    std::size_t bytes() const
+    {
+        auto r = tail.size() * sizeof(T);
+        for (auto& b : blocks)
+            r += b.bytes();
+        return r;
+    }
+};
+
+/*!
+ * The blocks and the tail of a `compressed_vector_transient`.  It has the
+ * same interface as `tree` for reading, so that it can be iterated in the
+ * same way.
+ */
+template <typename T, typename MemoryPolicy, bits_t B, bits_t BL>
+struct transient_tree
+{
+    using persistent_t = tree<T, MemoryPolicy, B, BL>;
+    using value_type   = T;
+    using block_t      = typename persistent_t::block_t;
+    using blocks_t     = typename persistent_t::blocks_t::transient_type;
+    using tail_t       = typename persistent_t::tail_t::transient_type;
+
+    static constexpr auto bits_leaf  = BL;
+    static constexpr auto block_size = persistent_t::block_size;
+    static constexpr auto block_mask = persistent_t::block_mask;
+
+    blocks_t blocks;
+    tail_t tail;
+
+    std::size_t size() const { return tail_offset() + tail.size(); }
+
+    std::size_t tail_offset() const { return blocks.size() * block_size; }
+};
+
+/*!
+ * Iterator over a `tree` or a `transient_tree`.
+ */
+template <typename Tree>
+struct tree_iterator
+    : iterator_facade<tree_iterator<Tree>,
+                      std::random_access_iterator_tag,
+                      typename Tree::value_type,
+                      typename Tree::value_type,
+                      std::ptrdiff_t,
+                      const typename Tree::value_type*>
+{
+    using tree_t  = Tree;
+    using T       = typename tree_t::value_type;
+    using block_t = typename tree_t::block_t;
+
+    static constexpr auto BL = tree_t::bits_leaf;
+
+    struct end_t
+    {};
+
+    tree_iterator() = default;
+
+    tree_iterator(const tree_t& v)
+        : v_{&v}
+        , i_{0}
+    {
+    }
+
+    tree_iterator(const tree_t& v, end_t)
+        : v_{&v}
+        , i_{v.size()}
+    {
+    }
+
+    const tree_t& impl() const { return *v_; }
+    std::size_t index() const { return i_; }
+
+private:
+    friend iterator_core_access;
+
+    const tree_t* v_ = nullptr;
+    std::size_t i_   = 0;
+    // The value at `cached_` is kept so that moving to a nearby element of
+    // the same block only needs to add or subtract the deltas in between,
+    // without decoding the block into the iterator, keeping it small and
+    // cheap to copy.
+    mutable const block_t* block_ = nullptr;
+    mutable std::size_t cached_   = ~std::size_t{};
+    mutable word_t value_         = 0;
+
+    void increment()
+    {
+        assert(i_ < v_->size());
+        ++i_;
+        seek();
+    }
+
+    void decrement()
+    {
+        assert(i_ > 0);
+        --i_;
+        seek();
+    }
+
+    void advance(std::ptrdiff_t n)
+    {
+        assert(n <= 0 || i_ + static_cast<std::size_t>(n) <= v_->size());
+        assert(n >= 0 || static_cast<std::size_t>(-n) <= i_);
+        i_ += n;
+    }
+
+    bool equal(const tree_iterator& other) const { return i_ == other.i_; }
+
+    std::ptrdiff_t distance_to(const tree_iterator& other) const
+    {
+        return other.i_ > i_ ? static_cast<std::ptrdiff_t>(other.i_ - i_)
+                             : -static_cast<std::ptrdiff_t>(i_ - other.i_);
+    }
+
+    // Moves the cached value to the current element.  Stepping by one is
+    // thus amortized O(1) in both directions, also for the copies that
+    // `std::reverse_iterator` decrements on every dereference.
+    void seek() const
+    {
+        if (i_ >= v_->tail_offset() || cached_ == i_)
+            return;
+        auto idx = i_ & tree_t::block_mask;
+        if (cached_ >> BL != i_ >> BL) {
+            block_ = &v_->blocks[i_ >> BL];
+            value_ = block_->get_word(idx);
+        } else if (cached_ < i_) {
+            for (auto j = (cached_ & tree_t::block_mask) + 1; j <= idx; ++j)
+                value_ += block_->delta(j);
+        } else if (cached_ - i_ <= idx) {
+            for (auto j = cached_ & tree_t::block_mask; j > idx; --j)
+                value_ -= block_->delta(j);
+        } else {
+            value_ = block_->get_word(idx);
+        }
+        cached_ = i_;
+    }
+
+    T dereference() const
+    {
+        auto off = v_->tail_offset();
+        if (i_ >= off)
+            return v_->tail[i_ - off];
+        seek();
+        return block_t::from_word(value_);
+    }
+};
+
+} // namespace compressed
+} // namespace detail
+} // namespace immer
@@ -0,0 +1,266 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/array.hpp>
+#include <immer/config.hpp>
+#include <immer/detail/iterator_facade.hpp>
+#include <immer/flex_vector.hpp>
+
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace immer {
+namespace detail {
+namespace deque {
+
+using rbts::bits_t;
+
+/*!
+ * A `flex_vector` with the first elements kept apart in a small array in
+ * reverse order, so that they can be added and removed at its end.  The
+ * array holds at most a leaf worth of elements.  When it is full, the half
+ * that is closest to the vector is moved into it with a single
+ * concatenation, and when it is empty it is refilled with half a leaf, so
+ * at least half a leaf of operations happen between two moves.
+ */
+template <typename T, typename MemoryPolicy, bits_t B, bits_t BL>
+struct deque_impl
+{
+    using head_t = array<T, MemoryPolicy>;
+    using body_t = flex_vector<T, MemoryPolicy, B, BL>;
+
+    static constexpr auto head_capacity = std::size_t{1} << BL;
+    // Elements moved at once between the head and the body
+    static constexpr auto head_chunk =
+        head_capacity > 1 ? head_capacity / 2 : std::size_t{1};
+
+    head_t head;
+    body_t body;
+
+    std::size_t size() const { return head.size() + body.size(); }
+
+    const T& get(std::size_t idx) const
+    {
+        auto hs = head.size();
+        return idx < hs ? head[hs - 1 - idx] : body[idx - hs];
+    }
+
+    const T& get_check(std::size_t idx) const
+    {
+        if (idx >= size())
+            IMMER_THROW(std::out_of_range{"index out of range"});
+        return get(idx);
+    }
+
+    const T& front() const
+    {
+        return head.empty() ? body.front() : head.back();
+    }
+
+    const T& back() const
+    {
+        return body.empty() ? head.front() : body.back();
+    }
+
+    template <typename Fn>
+    bool for_each_chunk_p(std::size_t first, std::size_t last, Fn&& fn) const
+    {
+        // the head is reversed, so its elements are passed one by one
+        auto hs = head.size();
+        for (; first < last && first < hs; ++first) {
+            auto p = head.data() + (hs - 1 - first);
+            if (!fn(p, p + 1))
+                return false;
+        }
+        return first >= last ||
+               body.impl().for_each_chunk_p(first - hs, last - hs, fn);
+    }
+
+    template <typename Fn>
+    bool for_each_chunk_p(Fn&& fn) const
+    {
+        return for_each_chunk_p(0, size(), std::forward<Fn>(fn));
+    }
+
+    template <typename Fn>
+    void for_each_chunk(std::size_t first, std::size_t last, Fn&& fn) const
+    {
+        for_each_chunk_p(first, last, [&](auto f, auto l) {
+            fn(f, l);
+            return true;
+        });
+    }
+
+    template <typename Fn>
+    void for_each_chunk(Fn&& fn) const
+    {
+        for_each_chunk(0, size(), std::forward<Fn>(fn));
+    }
+
+    // moves the whole head into the body
+    void flush_head()
+    {
+        auto chunk = body_t(std::make_move_iterator(head.rbegin()),
+                            std::make_move_iterator(head.rend()));
+        body       = std::move(chunk) + std::move(body);
+        head       = head_t{};
+    }
+
+    // moves the `n` elements of the head that are closest to the body
+    void flush_head(std::size_t n)
+    {
+        auto first = head.begin();
+        auto chunk = body_t(std::make_reverse_iterator(first + n),
+                            std::make_reverse_iterator(first));
+        body       = std::move(chunk) + std::move(body);
+        head       = head_t(first + n, head.end());
+    }
+
+    void push_front_mut(T value)
+    {
+        if (head.size() == head_capacity)
+            flush_head(head_chunk);
+        head = std::move(head).push_back(std::move(value));
+    }
+
+    void push_back_mut(T value)
+    {
+        body = std::move(body).push_back(std::move(value));
+    }
+
+    void pop_front_mut()
+    {
+        assert(size() > 0);
+        if (!head.empty()) {
+            head = std::move(head).take(head.size() - 1);
+        } else {
+            // refill the head with the next elements, but the first one
+            auto n = std::min(body.size(), std::size_t{head_chunk});
+            auto b = body.begin();
+            head   = head_t(std::make_reverse_iterator(b + n),
+                          std::make_reverse_iterator(b + 1));
+            body   = std::move(body).drop(n);
+        }
+    }
+
+    void pop_back_mut()
+    {
+        assert(size() > 0);
+        if (!body.empty())
+            body = std::move(body).take(body.size() - 1);
+        else
+            head = head_t(head.begin() + 1, head.end());
+    }
+
+    void assoc_mut(std::size_t idx, T value)
+    {
+        auto hs = head.size();
+        if (idx < hs)
+            head = std::move(head).set(hs - 1 - idx, std::move(value));
+        else
+            body = std::move(body).set(idx - hs, std::move(value));
+    }
+
+    template <typename Fn>
+    void update_mut(std::size_t idx, Fn&& fn)
+    {
+        auto hs = head.size();
+        if (idx < hs)
+            head = std::move(head).update(hs - 1 - idx, std::forward<Fn>(fn));
+        else
+            body = std::move(body).update(idx - hs, std::forward<Fn>(fn));
+    }
+};
+
+template <typename T, typename MemoryPolicy, bits_t B, bits_t BL>
+struct deque_iterator
+    : iterator_facade<deque_iterator<T, MemoryPolicy, B, BL>,
+                      std::random_access_iterator_tag,
+                      T,
+                      const T&,
+                      std::ptrdiff_t,
+                      const T*>
+{
+    using impl_t      = deque_impl<T, MemoryPolicy, B, BL>;
+    using body_iter_t = typename impl_t::body_t::iterator;
+
+    struct end_t
+    {};
+
+    deque_iterator() = default;
+
+    deque_iterator(const impl_t& v)
+        : v_{&v}
+        , i_{0}
+        , it_{v.body.begin()}
+    {
+    }
+
+    deque_iterator(const impl_t& v, end_t)
+        : v_{&v}
+        , i_{v.size()}
+        , it_{v.body.end()}
+    {
+    }
+
+    const impl_t& impl() const { return *v_; }
+    std::size_t index() const { return i_; }
+
+private:
+    friend iterator_core_access;
+
+    const impl_t* v_ = nullptr;
+    std::size_t i_   = 0;
+    // position in the body, it stays at its beginning while in the head
+    body_iter_t it_ = {};
+
+    void increment()
+    {
+        assert(i_ < v_->size());
+        if (i_++ >= v_->head.size())
+            ++it_;
+    }
+
+    void decrement()
+    {
+        assert(i_ > 0);
+        if (--i_ >= v_->head.size())
+            --it_;
+    }
+
+    void advance(std::ptrdiff_t n)
+    {
+        assert(n <= 0 || i_ + static_cast<std::size_t>(n) <= v_->size());
+        assert(n >= 0 || static_cast<std::size_t>(-n) <= i_);
+        auto hs = v_->head.size();
+        i_ += n;
+        it_ = v_->body.begin() + (i_ > hs ? i_ - hs : 0);
+    }
+
+    bool equal(const deque_iterator& other) const { return i_ == other.i_; }
+
+    std::ptrdiff_t distance_to(const deque_iterator& other) const
+    {
+        return other.i_ > i_ ? static_cast<std::ptrdiff_t>(other.i_ - i_)
+                             : -static_cast<std::ptrdiff_t>(i_ - other.i_);
+    }
+
+    const T& dereference() const
+    {
+        auto hs = v_->head.size();
+        return i_ < hs ? v_->head[hs - 1 - i_] : *it_;
+    }
+};
+
+} // namespace deque
+} // namespace detail
+} // namespace immer
@@ -651,6 +651,7 @@ struct champ
             for (; fst != lst; ++fst)
                 if (Equal{}(*fst, v)) {
                     if (node->can_mutate(e)) {
+                        node_t::trace::on_mutate();
                         *fst = std::move(v);
                         return {node, false, true};
                     } else {
@@ -670,6 +671,7 @@ struct champ
                 auto offset = node->children_count(bit);
                 auto child  = node->children()[offset];
                 if (node->can_mutate(e)) {
+                    node_t::trace::on_mutate();
                     auto result =
                         do_add_mut(e, child, std::move(v), hash, shift + B);
                     node->children()[offset] = result.node;
@@ -695,6 +697,7 @@ struct champ
                 auto val    = node->values() + offset;
                 if (Equal{}(*val, v)) {
                     if (node->can_mutate(e)) {
+                        node_t::trace::on_mutate();
                         auto vals    = node->ensure_mutable_values(e);
                         vals[offset] = std::move(v);
                         return {node, false, true};
@@ -936,6 +939,7 @@ struct champ
             for (; fst != lst; ++fst)
                 if (Equal{}(*fst, k)) {
                     if (node->can_mutate(e)) {
+                        node_t::trace::on_mutate();
                         *fst = Combine{}(
                             std::forward<K>(k),
                             std::forward<Fn>(fn)(Project{}(std::move(*fst))));
@@ -963,6 +967,7 @@ struct champ
                 auto offset = node->children_count(bit);
                 auto child  = node->children()[offset];
                 if (node->can_mutate(e)) {
+                    node_t::trace::on_mutate();
                     auto result = do_update_mut<Project, Default, Combine>(
                         e, child, k, std::forward<Fn>(fn), hash, shift + B);
                     node->children()[offset] = result.node;
@@ -988,6 +993,7 @@ struct champ
                 auto val    = node->values() + offset;
                 if (Equal{}(*val, k)) {
                     if (node->can_mutate(e)) {
+                        node_t::trace::on_mutate();
                         auto vals    = node->ensure_mutable_values(e);
                         vals[offset] = Combine{}(std::forward<K>(k),
                                                  std::forward<Fn>(fn)(Project{}(
@@ -1075,6 +1081,7 @@ struct champ
             for (; fst != lst; ++fst)
                 if (Equal{}(*fst, k)) {
                     if (node->can_mutate(e)) {
+                        node_t::trace::on_mutate();
                         *fst = Combine{}(
                             std::forward<K>(k),
                             std::forward<Fn>(fn)(Project{}(std::move(*fst))));
@@ -1100,6 +1107,7 @@ struct champ
                     auto result = do_update_if_exists_mut<Project, Combine>(
                         e, child, k, std::forward<Fn>(fn), hash, shift + B);
                     if (result.node) {
+                        node_t::trace::on_mutate();
                         node->children()[offset] = result.node;
                         if (!result.mutated && child->dec())
                             node_t::delete_deep_shift(child, shift + B);
@@ -1130,6 +1138,7 @@ struct champ
                 auto val    = node->values() + offset;
                 if (Equal{}(*val, k)) {
                     if (node->can_mutate(e)) {
+                        node_t::trace::on_mutate();
                         auto vals    = node->ensure_mutable_values(e);
                         vals[offset] = Combine{}(std::forward<K>(k),
                                                  std::forward<Fn>(fn)(Project{}(
@@ -1358,6 +1367,7 @@ struct champ
                 if (Equal{}(*cur, k)) {
                     if (node->collision_count() <= 2) {
                         if (mutate) {
+                            node_t::trace::on_mutate();
                             auto r = new (store)
                                 T{std::move(node->collisions()[cur == fst])};
                             node_t::delete_collision(node);
@@ -1419,6 +1429,7 @@ struct champ
                     }
                 case sub_result::tree:
                     if (mutate) {
+                        node_t::trace::on_mutate();
                         children[offset] = result.data.tree;
                         if (!result.mutated && child->dec())
                             node_t::delete_deep_shift(child, shift + B);
@@ -1451,6 +1462,7 @@ struct champ
                     } else if (nv == 2) {
                         if (shift > 0) {
                             if (mutate_values) {
+                                node_t::trace::on_mutate();
                                 auto r = new (store)
                                     T{std::move(node->values()[!offset])};
                                 node_t::delete_inner(node);
@@ -12,6 +12,7 @@
 #include <immer/detail/combine_standard_layout.hpp>
 #include <immer/detail/hamts/bits.hpp>
 #include <immer/detail/util.hpp>
+#include <immer/heap/traced_heap.hpp>
 
 #include <cassert>
 #include <cstddef>
@@ -50,7 +51,8 @@ struct node
 
     using memory      = MemoryPolicy;
     using heap_policy = typename memory::heap;
-    using heap        = typename heap_policy::type;
+    using trace       = get_trace_policy_t<memory>;
+    using heap = detail::traced_heap_t<trace, typename heap_policy::type>;
     using transience  = typename memory::transience_t;
     using refs_t      = typename memory::refcount;
     using ownee_t     = typename transience::ownee;
@@ -374,6 +376,7 @@ struct node
             deallocate_collision(p, 2);
             IMMER_RETHROW;
         }
+        trace::on_collision(2);
         return p;
     }
 
@@ -406,6 +409,7 @@ struct node
     static node_t* copy_collision_insert(node_t* src, T v)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::collision);
+        trace::on_copy(src->collision_count());
         auto n    = src->collision_count();
         auto dst  = make_collision_n(n + 1);
         auto srcp = src->collisions();
@@ -424,12 +428,14 @@ struct node
             deallocate_collision(dst, n + 1);
             IMMER_RETHROW;
         }
+        trace::on_collision(n + 1);
         return dst;
     }
 
     static node_t* move_collision_insert(node_t* src, T v)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::collision);
+        trace::on_mutate();
         auto n    = src->collision_count();
         auto dst  = make_collision_n(n + 1);
         auto srcp = src->collisions();
@@ -449,12 +455,14 @@ struct node
             IMMER_RETHROW;
         }
         delete_collision(src);
+        trace::on_collision(n + 1);
         return dst;
     }
 
     static node_t* copy_collision_remove(node_t* src, T* v)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::collision);
+        trace::on_copy(src->collision_count());
         assert(src->collision_count() > 1);
         auto n    = src->collision_count();
         auto dst  = make_collision_n(n - 1);
@@ -480,6 +488,7 @@ struct node
     static node_t* move_collision_remove(node_t* src, T* v)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::collision);
+        trace::on_mutate();
         assert(src->collision_count() > 1);
         auto n    = src->collision_count();
         auto dst  = make_collision_n(n - 1);
@@ -506,6 +515,7 @@ struct node
     static node_t* copy_collision_replace(node_t* src, T* pos, T v)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::collision);
+        trace::on_copy(src->collision_count());
         auto n    = src->collision_count();
         auto dst  = make_collision_n(n);
         auto srcp = src->collisions();
@@ -539,6 +549,7 @@ struct node
     copy_inner_replace(node_t* src, count_t offset, node_t* child)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
+        trace::on_copy(src->children_count());
         auto n    = src->children_count();
         auto dst  = make_inner_n(n, src->impl.d.data.inner.values);
         auto srcp = src->children();
@@ -576,6 +587,7 @@ struct node
     static node_t* copy_inner_replace_value(node_t* src, count_t offset, T v)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
+        trace::on_copy(src->children_count() + src->data_count());
         assert(offset < src->data_count());
         auto n                         = src->children_count();
         auto nv                        = src->data_count();
@@ -608,6 +620,7 @@ struct node
                                              node_t* node)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
+        trace::on_copy(src->children_count() + src->data_count());
         assert(!(src->nodemap() & bit));
         assert(src->datamap() & bit);
         assert(voffset == src->data_count(bit));
@@ -649,6 +662,7 @@ struct node
         edit_t e, node_t* src, bitmap_t bit, count_t voffset, node_t* node)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
+        trace::on_mutate();
         assert(!(src->nodemap() & bit));
         assert(src->datamap() & bit);
         assert(voffset == src->data_count(bit));
@@ -703,6 +717,7 @@ struct node
                                              T value)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
+        trace::on_copy(src->children_count() + src->data_count());
         assert(!(src->datamap() & bit));
         assert(src->nodemap() & bit);
         assert(noffset == src->children_count(bit));
@@ -751,6 +766,7 @@ struct node
         edit_t e, node_t* src, bitmap_t bit, count_t noffset, T value)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
+        trace::on_mutate();
         assert(!(src->datamap() & bit));
         assert(src->nodemap() & bit);
         assert(noffset == src->children_count(bit));
@@ -813,6 +829,7 @@ struct node
     copy_inner_remove_value(node_t* src, bitmap_t bit, count_t voffset)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
+        trace::on_copy(src->children_count() + src->data_count());
         assert(!(src->nodemap() & bit));
         assert(src->datamap() & bit);
         assert(voffset == src->data_count(bit));
@@ -851,6 +868,7 @@ struct node
                                            count_t voffset)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
+        trace::on_mutate();
         assert(!(src->nodemap() & bit));
         assert(src->datamap() & bit);
         assert(voffset == src->data_count(bit));
@@ -907,6 +925,7 @@ struct node
     static node_t* copy_inner_insert_value(node_t* src, bitmap_t bit, T v)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
+        trace::on_copy(src->children_count() + src->data_count());
         auto n                         = src->children_count();
         auto nv                        = src->data_count();
         auto offset                    = src->data_count(bit);
@@ -948,6 +967,7 @@ struct node
     move_inner_insert_value(edit_t e, node_t* src, bitmap_t bit, T v)
     {
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
+        trace::on_mutate();
         auto n                         = src->children_count();
         auto nv                        = src->data_count();
         auto offset                    = src->data_count(bit);
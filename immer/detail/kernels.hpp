@@ -0,0 +1,91 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+// Loops over the contiguous chunks of the containers, written so that the
+// compiler can turn them into SIMD code for the target architecture.  The
+// standard algorithms that keep track of positions, like `std::min_element`
+// or `std::count_if` with an iterator difference type, are not vectorized by
+// current compilers.  Floating point accumulations are never reordered,
+// since that would change the results.
+
+namespace immer {
+namespace detail {
+
+template <typename T>
+struct is_kernel_integral
+    : std::integral_constant<bool,
+                             std::is_integral<T>::value &&
+                                 !std::is_same<T, bool>::value>
+{};
+
+template <typename T, typename Pred>
+std::size_t count_if_chunk(const T* first, const T* last, Pred& p)
+{
+    auto r = std::size_t{};
+    for (; first != last; ++first)
+        r += p(*first) ? 1 : 0;
+    return r;
+}
+
+template <typename T, typename U>
+const T* find_chunk(const T* first, const T* last, const U& value)
+{
+    return std::find(first, last, value);
+}
+
+template <typename T, typename Compare>
+const T* min_chunk(const T* first, const T* last, Compare& cmp)
+{
+    return std::min_element(first, last, cmp);
+}
+
+template <typename T, typename Compare>
+const T* max_chunk(const T* first, const T* last, Compare& cmp)
+{
+    return std::max_element(first, last, cmp);
+}
+
+template <typename T, typename Fn>
+T reduce_chunk(const T* first, const T* last, Fn fn)
+{
+    auto r = *first++;
+    for (; first != last; ++first)
+        r = fn(r, *first);
+    return r;
+}
+
+template <typename T,
+          std::enable_if_t<is_kernel_integral<T>::value, int> = 0>
+const T* min_chunk(const T* first, const T* last, std::less<>&)
+{
+    if (first == last)
+        return last;
+    // find the value with a branchless reduction and then its position
+    auto m = reduce_chunk(first, last, [](T a, T b) { return b < a ? b : a; });
+    return std::find(first, last, m);
+}
+
+template <typename T,
+          std::enable_if_t<is_kernel_integral<T>::value, int> = 0>
+const T* max_chunk(const T* first, const T* last, std::less<>&)
+{
+    if (first == last)
+        return last;
+    auto m = reduce_chunk(first, last, [](T a, T b) { return a < b ? b : a; });
+    return std::find(first, last, m);
+}
+
+} // namespace detail
+} // namespace immer
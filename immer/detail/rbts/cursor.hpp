@@ -0,0 +1,111 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/detail/rbts/bits.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace immer {
+namespace detail {
+namespace rbts {
+
+/*!
+ * Remembers the leaf that contains the last accessed element of a `rbtree` or
+ * `rrbtree`, together with the path of inner nodes that leads to it.  Seeking
+ * to an index in the same leaf is @f$ O(1) @f$, otherwise it only descends
+ * from the lowest node in the path that contains the index.
+ */
+template <typename NodeT>
+struct cursor_state
+{
+    using node_t = NodeT;
+    using T      = typename node_t::value_t;
+
+    static constexpr auto B         = node_t::bits;
+    static constexpr auto BL        = node_t::bits_leaf;
+    static constexpr auto max_depth = sizeof(size_t) * 8 / B + 1;
+
+    struct level
+    {
+        node_t* node;
+        size_t first;
+        size_t last;
+        shift_t shift;
+    };
+
+    const T* leaf = nullptr;
+    size_t first  = 0;
+    size_t last   = 0;
+    count_t depth = 0;
+    level path[max_depth];
+
+    static bool contains(size_t first, size_t last, size_t idx)
+    {
+        return idx - first < last - first;
+    }
+
+    template <typename Tree>
+    const T* seek(const Tree& tree, size_t idx)
+    {
+        assert(idx < tree.size);
+        if (!contains(first, last, idx)) {
+            auto tail_off = tree.tail_offset();
+            if (idx >= tail_off) {
+                leaf  = tree.tail->leaf();
+                first = tail_off;
+                last  = tree.size;
+            } else {
+                while (depth && !contains(path[depth - 1].first,
+                                          path[depth - 1].last,
+                                          idx))
+                    --depth;
+                if (!depth)
+                    path[depth++] = {tree.root, 0, tail_off, tree.shift};
+                descend(idx);
+            }
+        }
+        return leaf + (idx - first);
+    }
+
+    void descend(size_t idx)
+    {
+        auto l = path[depth - 1];
+        while (true) {
+            auto local       = idx - l.first;
+            auto offset      = static_cast<count_t>(local >> l.shift);
+            auto child_first = l.first;
+            auto child_last  = l.last;
+            if (auto r = l.node->relaxed()) {
+                while (r->d.sizes[offset] <= local)
+                    ++offset;
+                child_first = l.first + (offset ? r->d.sizes[offset - 1] : 0);
+                child_last  = l.first + r->d.sizes[offset];
+            } else {
+                child_first = l.first + (size_t{offset} << l.shift);
+                child_last =
+                    std::min(l.last, child_first + (size_t{1} << l.shift));
+            }
+            auto child = l.node->inner()[offset];
+            if (l.shift == BL) {
+                leaf  = child->leaf();
+                first = child_first;
+                last  = child_last;
+                return;
+            }
+            l             = {child, child_first, child_last, l.shift - B};
+            path[depth++] = l;
+        }
+    }
+};
+
+} // namespace rbts
+} // namespace detail
+} // namespace immer
@@ -13,6 +13,7 @@
 #include <immer/detail/rbts/bits.hpp>
 #include <immer/detail/util.hpp>
 #include <immer/heap/tags.hpp>
+#include <immer/heap/traced_heap.hpp>
 
 #include <cassert>
 #include <cstddef>
@@ -43,6 +44,7 @@ struct node
     using node_t      = node;
     using memory      = MemoryPolicy;
     using heap_policy = typename memory::heap;
+    using trace       = get_trace_policy_t<memory>;
     using transience  = typename memory::transience_t;
     using refs_t      = typename memory::refcount;
     using ownee_t     = typename transience::ownee;
@@ -161,8 +163,9 @@ struct node
         return keep_headroom ? max_sizeof_leaf : sizeof_packed_leaf_n(n);
     }
 
-    using heap =
-        typename heap_policy::template optimized<max_sizeof_inner>::type;
+    using heap = detail::traced_heap_t<
+        trace,
+        typename heap_policy::template optimized<max_sizeof_inner>::type>;
 
 #if IMMER_TAGGED_NODE
     kind_t kind() const { return impl.d.kind; }
@@ -535,7 +538,8 @@ struct node
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
         auto dst = make_inner_n(n);
         inc_nodes(src->inner(), n);
-        std::copy(src->inner(), src->inner() + n, dst->inner());
+        detail::copy_trivially(src->inner(), src->inner() + n, dst->inner());
+        trace::on_copy(n);
         return dst;
     }
 
@@ -560,7 +564,8 @@ struct node
         IMMER_ASSERT_TAGGED(src->kind() == kind_t::inner);
         auto p = src->inner();
         inc_nodes(p, n);
-        std::copy(p, p + n, dst->inner());
+        detail::copy_trivially(p, p + n, dst->inner());
+        trace::on_copy(n);
         return dst;
     }
 
@@ -572,8 +577,9 @@ struct node
         auto p = src->inner();
         inc_nodes(p, offset);
         inc_nodes(p + offset + 1, n - offset - 1);
-        std::copy(p, p + n, dst->inner());
+        detail::copy_trivially(p, p + n, dst->inner());
         dst->inner()[offset] = child;
+        trace::on_copy(n);
         return dst;
     }
 
@@ -613,9 +619,11 @@ struct node
         auto src_r = src->relaxed();
         auto dst_r = dst->relaxed();
         inc_nodes(src->inner(), n);
-        std::copy(src->inner(), src->inner() + n, dst->inner());
-        std::copy(src_r->d.sizes, src_r->d.sizes + n, dst_r->d.sizes);
+        detail::copy_trivially(src->inner(), src->inner() + n, dst->inner());
+        detail::copy_trivially(
+            src_r->d.sizes, src_r->d.sizes + n, dst_r->d.sizes);
         dst_r->d.count = n;
+        trace::on_copy(n);
         return dst;
     }
 
@@ -629,10 +637,12 @@ struct node
         auto p     = src->inner();
         inc_nodes(p, offset);
         inc_nodes(p + offset + 1, n - offset - 1);
-        std::copy(src->inner(), src->inner() + n, dst->inner());
-        std::copy(src_r->d.sizes, src_r->d.sizes + n, dst_r->d.sizes);
+        detail::copy_trivially(src->inner(), src->inner() + n, dst->inner());
+        detail::copy_trivially(
+            src_r->d.sizes, src_r->d.sizes + n, dst_r->d.sizes);
         dst_r->d.count       = n;
         dst->inner()[offset] = child;
+        trace::on_copy(n);
         return dst;
     }
 
@@ -642,7 +652,9 @@ struct node
             return do_copy_inner_r(dst, src, n);
         else {
             inc_nodes(src->inner(), n);
-            std::copy(src->inner(), src->inner() + n, dst->inner());
+            detail::copy_trivially(
+                src->inner(), src->inner() + n, dst->inner());
+            trace::on_copy(n);
             return dst;
         }
     }
@@ -656,8 +668,9 @@ struct node
             auto p = src->inner();
             inc_nodes(p, offset);
             inc_nodes(p + offset + 1, n - offset - 1);
-            std::copy(p, p + n, dst->inner());
+            detail::copy_trivially(p, p + n, dst->inner());
             dst->inner()[offset] = child;
+            trace::on_copy(n);
             return dst;
         }
     }
@@ -674,6 +687,7 @@ struct node
             heap::deallocate(node_t::sizeof_leaf_n(n), dst);
             IMMER_RETHROW;
         }
+        trace::on_copy(n);
         return dst;
     }
 
@@ -689,6 +703,7 @@ struct node
             heap::deallocate(node_t::max_sizeof_leaf, dst);
             IMMER_RETHROW;
         }
+        trace::on_copy(n);
         return dst;
     }
 
@@ -705,6 +720,7 @@ struct node
             heap::deallocate(node_t::sizeof_leaf_n(allocn), dst);
             IMMER_RETHROW;
         }
+        trace::on_copy(n);
         return dst;
     }
 
@@ -730,6 +746,7 @@ struct node
             heap::deallocate(node_t::sizeof_leaf_n(n1 + n2), dst);
             IMMER_RETHROW;
         }
+        trace::on_copy(n1 + n2);
         return dst;
     }
 
@@ -756,6 +773,7 @@ struct node
             heap::deallocate(max_sizeof_leaf, dst);
             IMMER_RETHROW;
         }
+        trace::on_copy(n1 + n2);
         return dst;
     }
 
@@ -771,6 +789,7 @@ struct node
             heap::deallocate(max_sizeof_leaf, dst);
             IMMER_RETHROW;
         }
+        trace::on_copy(last - idx);
         return dst;
     }
 
@@ -786,6 +805,7 @@ struct node
             heap::deallocate(node_t::sizeof_leaf_n(last - idx), dst);
             IMMER_RETHROW;
         }
+        trace::on_copy(last - idx);
         return dst;
     }
 
@@ -887,7 +907,7 @@ struct node
                         new (heap::allocate(max_sizeof_relaxed)) relaxed_t;
                     if (src_r) {
                         auto n = dst_r->d.count = src_r->d.count;
-                        std::copy(
+                        detail::copy_trivially(
                             src_r->d.sizes, src_r->d.sizes + n, dst_r->d.sizes);
                         if (node_t::refs(src_r).dec())
                             heap::deallocate(node_t::sizeof_inner_r_n(n),
@@ -914,7 +934,7 @@ struct node
                         new (heap::allocate(max_sizeof_relaxed)) relaxed_t;
                     if (src_r) {
                         auto n = dst_r->d.count = src_r->d.count;
-                        std::copy(
+                        detail::copy_trivially(
                             src_r->d.sizes, src_r->d.sizes + n, dst_r->d.sizes);
                         if (node_t::refs(src_r).dec())
                             heap::deallocate(node_t::sizeof_inner_r_n(n),
@@ -939,7 +959,7 @@ struct node
                     auto dst_r =
                         new (heap::allocate(max_sizeof_relaxed)) relaxed_t;
                     if (src_r) {
-                        std::copy(
+                        detail::copy_trivially(
                             src_r->d.sizes, src_r->d.sizes + n, dst_r->d.sizes);
                         if (node_t::refs(src_r).dec())
                             heap::deallocate(node_t::sizeof_inner_r_n(n),
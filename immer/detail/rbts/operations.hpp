@@ -13,6 +13,7 @@
 #include <memory>
 #include <numeric>
 #include <utility>
+#include <vector>
 
 #include <immer/config.hpp>
 #include <immer/detail/rbts/position.hpp>
@@ -317,6 +318,143 @@ struct for_each_chunk_p_i_visitor : visitor_base<for_each_chunk_p_i_visitor>
     }
 };
 
+struct for_each_leaf_visitor : visitor_base<for_each_leaf_visitor>
+{
+    using this_t = for_each_leaf_visitor;
+
+    template <typename Pos, typename Fn>
+    static void visit_inner(Pos&& pos, Fn&& fn)
+    {
+        pos.each(this_t{}, fn);
+    }
+
+    template <typename Pos, typename Fn>
+    static void visit_leaf(Pos&& pos, Fn&& fn)
+    {
+        if (pos.count())
+            fn(pos.node(), pos.count());
+    }
+};
+
+/*!
+ * Describes how densely packed the nodes of a tree are.  Trees built by
+ * appending or removing elements at the end have only regular inner nodes and
+ * full leaves, while concatenation, insertion and erasure introduce relaxed
+ * inner nodes and underfull leaves, which make lookups slower.  It is also
+ * meant to be sampled from running programs, to find out about usage
+ * patterns that degrade the tree, like repeated concatenations of small
+ * vectors.  Unlike the hash tries' debug statistics, it is available
+ * regardless of `IMMER_DEBUG_STATS`.
+ */
+struct fill_stats
+{
+    /*!
+     * Nodes at one level of the tree, where the root is level 0.
+     */
+    struct level_stats
+    {
+        size_t nodes = 0;
+        //! Children, or elements in the leaves, in the nodes of this level.
+        size_t used = 0;
+        //! Children, or elements, that the nodes of this level can hold.
+        size_t capacity = 0;
+
+        /*!
+         * Average fraction of the slots that are used, from 0 to 1.
+         */
+        double fill() const { return capacity ? double(used) / capacity : 1; }
+    };
+
+    size_t bits      = 0;
+    size_t bits_leaf = 0;
+    size_t size      = 0;
+
+    //! Number of levels, including the leaves but not the tail.
+    size_t depth         = 0;
+    size_t inner_nodes   = 0;
+    size_t relaxed_nodes = 0;
+    size_t leaves        = 0;
+    size_t leaf_slots    = 0;
+    size_t elements      = 0;
+
+    //! Bytes used by the size tables of the relaxed nodes.
+    size_t relaxed_bytes = 0;
+
+    size_t tail_size     = 0;
+    size_t tail_capacity = 0;
+
+    //! From the root to the leaves.
+    std::vector<level_stats> levels;
+
+    /*!
+     * Fraction of inner nodes that are relaxed, from 0 to 1.
+     */
+    double relaxed_ratio() const
+    {
+        return inner_nodes ? double(relaxed_nodes) / inner_nodes : 0;
+    }
+
+    /*!
+     * Average fraction of the slots of the leaves that are used, from 0 to 1.
+     */
+    double leaf_fill() const
+    {
+        return leaf_slots ? double(elements) / leaf_slots : 1;
+    }
+
+    /*!
+     * Fraction of the tail that is used, from 0 to 1.
+     */
+    double tail_fill() const
+    {
+        return tail_capacity ? double(tail_size) / tail_capacity : 0;
+    }
+};
+
+struct fill_stats_visitor : visitor_base<fill_stats_visitor>
+{
+    using this_t = fill_stats_visitor;
+
+    template <typename Pos>
+    static void visit_relaxed(Pos&& pos, fill_stats& stats, size_t level)
+    {
+        using node_t = node_type<Pos>;
+        ++stats.relaxed_nodes;
+        stats.relaxed_bytes += node_t::sizeof_relaxed_n(pos.count());
+        visit_regular(pos, stats, level);
+    }
+
+    template <typename Pos>
+    static void visit_regular(Pos&& pos, fill_stats& stats, size_t level)
+    {
+        using node_t = node_type<Pos>;
+        ++stats.inner_nodes;
+        add(stats, level, pos.count(), branches<node_t::bits>);
+        pos.each(this_t{}, stats, level + 1);
+    }
+
+    template <typename Pos>
+    static void visit_leaf(Pos&& pos, fill_stats& stats, size_t level)
+    {
+        using node_t = node_type<Pos>;
+        ++stats.leaves;
+        stats.leaf_slots += branches<node_t::bits_leaf>;
+        stats.elements += pos.count();
+        add(stats, level, pos.count(), branches<node_t::bits_leaf>);
+    }
+
+    static void
+    add(fill_stats& stats, size_t level, size_t used, size_t capacity)
+    {
+        if (stats.levels.size() <= level)
+            stats.levels.resize(level + 1);
+        auto& l = stats.levels[level];
+        ++l.nodes;
+        l.used += used;
+        l.capacity += capacity;
+    }
+};
+
 struct equals_visitor : visitor_base<equals_visitor>
 {
     using this_t = equals_visitor;
@@ -597,6 +735,7 @@ struct get_mut_visitor : visitor_base<get_mut_visitor<NodeT>>
         auto count  = pos.count();
         auto node   = pos.node();
         if (node->can_mutate(e)) {
+            node_t::trace::on_mutate();
             return pos.towards_oh(
                 this_t{}, idx, offset, e, &node->inner()[offset]);
         } else {
@@ -624,6 +763,7 @@ struct get_mut_visitor : visitor_base<get_mut_visitor<NodeT>>
         auto count  = pos.count();
         auto node   = pos.node();
         if (node->can_mutate(e)) {
+            node_t::trace::on_mutate();
             return pos.towards_oh_ch(
                 this_t{}, idx, offset, count, e, &node->inner()[offset]);
         } else {
@@ -653,6 +793,7 @@ struct get_mut_visitor : visitor_base<get_mut_visitor<NodeT>>
         assert(pos.node() == *location);
         auto node = pos.node();
         if (node->can_mutate(e)) {
+            node_t::trace::on_mutate();
             return node->leaf()[pos.index(idx)];
         } else {
             auto new_node = node_t::copy_leaf_e(e, pos.node(), pos.count());
@@ -704,6 +845,7 @@ struct push_tail_mut_visitor
             new_child = node_t::make_path_e(e, level - B, tail);
 
         if (mutate) {
+            node_t::trace::on_mutate();
             auto count             = new_idx + 1;
             auto relaxed           = node->ensure_mutable_relaxed_n(e, new_idx);
             node->inner()[new_idx] = new_child;
@@ -745,6 +887,7 @@ struct push_tail_mut_visitor
         auto new_idx = pos.index(pos.size() + branches<BL> - 1);
         auto mutate  = Mutating && node->can_mutate(e);
         if (mutate) {
+            node_t::trace::on_mutate();
             node->inner()[new_idx] =
                 idx == new_idx ? pos.last_oh(this_t{}, idx, e, tail)
                                /* otherwise */
@@ -931,6 +1074,7 @@ struct slice_right_mut_visitor
             IMMER_TRY {
                 if (next) {
                     if (mutate) {
+                        node_t::trace::on_mutate();
                         auto nodr = node->ensure_mutable_relaxed_n(e, idx);
                         pos.each_right(dec_visitor{}, idx + 1);
                         node->inner()[idx] = next;
@@ -962,6 +1106,7 @@ struct slice_right_mut_visitor
                     return std::make_tuple(pos.shift() - B, newn, ts, tail);
                 } else {
                     if (mutate) {
+                        node_t::trace::on_mutate();
                         pos.each_right(dec_visitor{}, idx + 1);
                         node->ensure_mutable_relaxed_n(e, idx)->d.count = idx;
                         return std::make_tuple(pos.shift(), node, ts, tail);
@@ -1009,6 +1154,7 @@ struct slice_right_mut_visitor
             IMMER_TRY {
                 if (next) {
                     if (mutate) {
+                        node_t::trace::on_mutate();
                         node->inner()[idx] = next;
                         pos.each_right(dec_visitor{}, idx + 1);
                         return std::make_tuple(pos.shift(), node, ts, tail);
@@ -1032,6 +1178,7 @@ struct slice_right_mut_visitor
                     return std::make_tuple(pos.shift() - B, newn, ts, tail);
                 } else {
                     if (mutate) {
+                        node_t::trace::on_mutate();
                         pos.each_right(dec_visitor{}, idx + 1);
                         return std::make_tuple(pos.shift(), node, ts, tail);
                     } else {
@@ -1066,6 +1213,7 @@ struct slice_right_mut_visitor
                 node->inc();
             return std::make_tuple(0, nullptr, new_tail_size, node);
         } else if (mutate) {
+            node_t::trace::on_mutate();
             detail::destroy_n(node->leaf() + new_tail_size,
                               old_tail_size - new_tail_size);
             return std::make_tuple(0, nullptr, new_tail_size, node);
@@ -1262,6 +1410,8 @@ struct slice_left_mut_visitor
             return r;
         } else {
             using std::get;
+            if (mutate)
+                node_t::trace::on_mutate();
             auto newn     = mutate ? (node->ensure_mutable_relaxed(e), node)
                                    : node_t::make_inner_r_e(e);
             auto newr     = newn->relaxed();
@@ -1327,6 +1477,8 @@ struct slice_left_mut_visitor
             // allocating a `relaxed_t` size table for it... maybe some of this
             // magic should be moved as a `node<...>` static method...
             auto newcount = count - idx;
+            if (mutate)
+                node_t::trace::on_mutate();
             auto newn =
                 mutate ? (node->impl.d.data.inner.relaxed = new (
                               node_t::heap::allocate(node_t::max_sizeof_relaxed,
@@ -1382,6 +1534,7 @@ struct slice_left_mut_visitor
                       std::is_nothrow_move_constructible<value_t>::value &&
                       node->can_mutate(e);
         if (mutate) {
+            node_t::trace::on_mutate();
             auto data     = node->leaf();
             auto newcount = count - idx;
             std::move(data + idx, data + count, data);
@@ -1530,8 +1683,9 @@ struct concat_center_pos
                 auto result = node_t::make_inner_r_n(count_);
                 auto r      = result->relaxed();
                 r->d.count  = count_;
-                std::copy(nodes_, nodes_ + count_, result->inner());
-                std::copy(sizes_, sizes_ + count_, r->d.sizes);
+                detail::copy_trivially(
+                    nodes_, nodes_ + count_, result->inner());
+                detail::copy_trivially(sizes_, sizes_ + count_, r->d.sizes);
                 return {result, shift_, r};
             }
             IMMER_CATCH (...) {
@@ -1550,8 +1704,8 @@ struct concat_center_pos
             auto result = node_t::make_inner_r_e(e);
             auto r      = result->relaxed();
             r->d.count  = count_;
-            std::copy(nodes_, nodes_ + count_, result->inner());
-            std::copy(sizes_, sizes_ + count_, r->d.sizes);
+            detail::copy_trivially(nodes_, nodes_ + count_, result->inner());
+            detail::copy_trivially(sizes_, sizes_ + count_, r->d.sizes);
             return {result, shift_, r};
         } else {
             assert(shift_ >= B + BL);
@@ -1665,9 +1819,9 @@ struct concat_merger
                 auto data = to_->inner();
                 auto to_copy =
                     std::min(from_count - from_offset, *curr_ - to_offset_);
-                std::copy(from_data + from_offset,
-                          from_data + from_offset + to_copy,
-                          data + to_offset_);
+                detail::copy_trivially(from_data + from_offset,
+                                       from_data + from_offset + to_copy,
+                                       data + to_offset_);
                 node_t::inc_nodes(from_data + from_offset, to_copy);
                 auto sizes = to_->relaxed()->d.sizes;
                 p.copy_sizes(
@@ -1823,7 +1977,9 @@ concat_center_pos<Node> concat_rebalance(LPos&& lpos, CPos&& cpos, RPos&& rpos)
 {
     auto plan = concat_rebalance_plan<Node::bits, Node::bits_leaf>{};
     plan.fill(lpos, cpos, rpos);
+    auto n = plan.n;
     plan.shuffle(cpos.shift());
+    Node::trace::on_rebalance(n, plan.n);
     IMMER_TRY {
         return plan.merge(lpos, cpos, rpos);
     }
@@ -2043,6 +2199,7 @@ struct concat_merger_mut
         , result_{shift + B, nullptr, 0}
     {
         if (candidate) {
+            node_t::trace::on_mutate();
             candidate->ensure_mutable_relaxed_e(candidate_e, ec);
             result_.nodes_[0] = candidate;
         } else {
@@ -2071,6 +2228,7 @@ struct concat_merger_mut
             assert(result_.count_ < result_t::max_children);
             n_ -= branches<B>;
             if (candidate_) {
+                node_t::trace::on_mutate();
                 parent = candidate_;
                 parent->ensure_mutable_relaxed_e(candidate_e_, ec_);
                 candidate_ = nullptr;
@@ -2109,6 +2267,7 @@ struct concat_merger_mut
             do {
                 if (!to_) {
                     if (from_mutate) {
+                        node_t::trace::on_mutate();
                         node_t::ownee(from) = ec_;
                         to_                 = from->inc();
                         assert(from_count);
@@ -2163,6 +2322,7 @@ struct concat_merger_mut
             do {
                 if (!to_) {
                     if (from_mutate) {
+                        node_t::trace::on_mutate();
                         node_t::ownee(from) = ec_;
                         from->ensure_mutable_relaxed_e(e, ec_);
                         to_ = from;
@@ -2280,7 +2440,9 @@ concat_center_pos<Node> concat_rebalance_mut(edit_type<Node> ec,
 {
     auto plan = concat_rebalance_plan_mut<Node::bits, Node::bits_leaf>{};
     plan.fill(lpos, cpos, rpos);
+    auto n = plan.n;
     plan.shuffle(cpos.shift());
+    Node::trace::on_rebalance(n, plan.n);
     return plan.merge(ec, el, lpos, cpos, er, rpos);
 }
 
@@ -265,6 +265,35 @@ struct rbtree
             auto new_tail = node_t::copy_leaf_e(e, tail, n);
             dec_leaf(tail, n);
             tail = new_tail;
+        } else {
+            node_t::trace::on_mutate();
+        }
+    }
+
+    void push_tail_mut(edit_t e, size_t tail_off, node_t* tail)
+    {
+        if (tail_off == size_t{branches<B>} << shift) {
+            auto new_root = node_t::make_inner_e(e);
+            IMMER_TRY {
+                auto path            = node_t::make_path_e(e, shift, tail);
+                new_root->inner()[0] = root;
+                new_root->inner()[1] = path;
+                root                 = new_root;
+                shift += B;
+            }
+            IMMER_CATCH (...) {
+                node_t::delete_inner_e(new_root);
+                IMMER_RETHROW;
+            }
+        } else if (tail_off) {
+            auto new_root = make_regular_sub_pos(root, shift, tail_off)
+                                .visit(push_tail_mut_visitor<node_t>{}, e, tail);
+            root          = new_root;
+        } else {
+            auto new_root = node_t::make_path_e(e, shift, tail);
+            assert(tail_off == 0);
+            dec_empty_regular(root);
+            root = new_root;
         }
     }
 
@@ -278,33 +307,8 @@ struct rbtree
         } else {
             auto new_tail = node_t::make_leaf_e(e, std::move(value));
             IMMER_TRY {
-                if (tail_off == size_t{branches<B>} << shift) {
-                    auto new_root = node_t::make_inner_e(e);
-                    IMMER_TRY {
-                        auto path = node_t::make_path_e(e, shift, tail);
-                        new_root->inner()[0] = root;
-                        new_root->inner()[1] = path;
-                        root                 = new_root;
-                        tail                 = new_tail;
-                        shift += B;
-                    }
-                    IMMER_CATCH (...) {
-                        node_t::delete_inner_e(new_root);
-                        IMMER_RETHROW;
-                    }
-                } else if (tail_off) {
-                    auto new_root =
-                        make_regular_sub_pos(root, shift, tail_off)
-                            .visit(push_tail_mut_visitor<node_t>{}, e, tail);
-                    root = new_root;
-                    tail = new_tail;
-                } else {
-                    auto new_root = node_t::make_path_e(e, shift, tail);
-                    assert(tail_off == 0);
-                    dec_empty_regular(root);
-                    root = new_root;
-                    tail = new_tail;
-                }
+                push_tail_mut(e, tail_off, tail);
+                tail = new_tail;
             }
             IMMER_CATCH (...) {
                 node_t::delete_leaf(new_tail, 1);
@@ -314,6 +318,24 @@ struct rbtree
         ++size;
     }
 
+    // Appends the `count` elements of `leaf`, sharing the node when it is
+    // full and it would start at a leaf boundary of this tree.
+    void push_leaf_mut(edit_t e, node_t* leaf, count_t count)
+    {
+        auto ts = tail_size();
+        if (count == branches<BL> && (ts == branches<BL> || size == 0)) {
+            if (size)
+                push_tail_mut(e, tail_offset(), tail);
+            else
+                dec_leaf(tail, ts);
+            tail = leaf->inc();
+            size += count;
+        } else {
+            for (auto i = count_t{}; i < count; ++i)
+                push_back_mut(e, leaf->leaf()[i]);
+        }
+    }
+
     rbtree push_back(T value) const
     {
         auto tail_off = tail_offset();
@@ -465,6 +487,7 @@ struct rbtree
             auto ts    = size - tail_off;
             auto newts = new_size - tail_off;
             if (tail->can_mutate(e)) {
+                node_t::trace::on_mutate();
                 detail::destroy_n(tail->leaf() + newts, ts - newts);
             } else {
                 auto new_tail = node_t::copy_leaf_e(e, tail, newts);
@@ -495,6 +518,22 @@ struct rbtree
         }
     }
 
+    fill_stats get_fill_stats() const
+    {
+        auto stats      = fill_stats{};
+        auto tail_off   = tail_offset();
+        stats.bits      = B;
+        stats.bits_leaf = BL;
+        stats.size      = size;
+        if (tail_off)
+            make_regular_sub_pos(root, shift, tail_off)
+                .visit(fill_stats_visitor{}, stats, size_t{});
+        stats.depth         = stats.levels.size();
+        stats.tail_size     = size - tail_off;
+        stats.tail_capacity = branches<BL>;
+        return stats;
+    }
+
     bool check_tree() const
     {
 #if IMMER_DEBUG_DEEP_CHECK
@@ -471,6 +471,8 @@ struct rrbtree
             auto new_tail = node_t::copy_leaf_e(e, tail, n);
             dec_leaf(tail, n);
             tail = new_tail;
+        } else {
+            node_t::trace::on_mutate();
         }
     }
 
@@ -520,6 +522,64 @@ struct rrbtree
         }
     }
 
+    // Appends the `count` elements of `leaf`, sharing the node when it is
+    // full and it would start at a leaf boundary of this tree.
+    void push_leaf_mut(edit_t e, node_t* leaf, count_t count)
+    {
+        auto ts = tail_size();
+        if (count == branches<BL> && (ts == branches<BL> || size == 0)) {
+            if (size)
+                push_tail_mut(e, tail_offset(), tail, ts);
+            else
+                dec_leaf(tail, ts);
+            tail = leaf->inc();
+            size += count;
+        } else {
+            for (auto i = count_t{}; i < count; ++i)
+                push_back_mut(e, leaf->leaf()[i]);
+        }
+    }
+
+    rrbtree compact_into(edit_t e) const
+    {
+        auto result = rrbtree{};
+        traverse(for_each_leaf_visitor{}, [&](node_t* leaf, count_t count) {
+            result.push_leaf_mut(e, leaf, count);
+        });
+        return result;
+    }
+
+    void compact_mut(edit_t e)
+    {
+        if (root->relaxed()) {
+            auto result = compact_into(e);
+            swap(*this, result);
+        }
+    }
+
+    rrbtree compact() const
+    {
+        // Regular nodes only have regular children, so the tree is already
+        // as dense as it gets when the root is not relaxed.
+        return root->relaxed() ? compact_into(owner_t{}) : *this;
+    }
+
+    fill_stats get_fill_stats() const
+    {
+        auto stats      = fill_stats{};
+        auto tail_off   = tail_offset();
+        stats.bits      = B;
+        stats.bits_leaf = BL;
+        stats.size      = size;
+        if (tail_off)
+            visit_maybe_relaxed_sub(
+                root, shift, tail_off, fill_stats_visitor{}, stats, size_t{});
+        stats.depth         = stats.levels.size();
+        stats.tail_size     = size - tail_off;
+        stats.tail_capacity = branches<BL>;
+        return stats;
+    }
+
     std::tuple<const T*, size_t, size_t> region_for(size_t idx) const
     {
         using std::get;
@@ -613,6 +673,7 @@ struct rrbtree
             auto ts    = size - tail_off;
             auto newts = new_size - tail_off;
             if (tail->can_mutate(e)) {
+                node_t::trace::on_mutate();
                 detail::destroy_n(tail->leaf() + newts, ts - newts);
             } else {
                 auto new_tail = node_t::copy_leaf_e(e, tail, newts);
@@ -1100,11 +1161,12 @@ struct rrbtree
                 return;
             } else if (tail_size + r.size <= branches<BL>) {
                 l.ensure_mutable_tail(el, tail_size);
-                if (r.tail->can_mutate(er))
+                if (r.tail->can_mutate(er)) {
+                    node_t::trace::on_mutate();
                     detail::uninitialized_move(r.tail->leaf(),
                                                r.tail->leaf() + r.size,
                                                l.tail->leaf() + tail_size);
-                else
+                } else
                     detail::uninitialized_copy(r.tail->leaf(),
                                                r.tail->leaf() + r.size,
                                                l.tail->leaf() + tail_size);
@@ -1113,11 +1175,12 @@ struct rrbtree
             } else {
                 auto remaining = branches<BL> - tail_size;
                 l.ensure_mutable_tail(el, tail_size);
-                if (r.tail->can_mutate(er))
+                if (r.tail->can_mutate(er)) {
+                    node_t::trace::on_mutate();
                     detail::uninitialized_move(r.tail->leaf(),
                                                r.tail->leaf() + remaining,
                                                l.tail->leaf() + tail_size);
-                else
+                } else
                     detail::uninitialized_copy(r.tail->leaf(),
                                                r.tail->leaf() + remaining,
                                                l.tail->leaf() + tail_size);
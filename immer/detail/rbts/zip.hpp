@@ -0,0 +1,142 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/config.hpp>
+#include <immer/detail/rbts/operations.hpp>
+#include <immer/detail/rbts/rbtree.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace immer {
+namespace detail {
+namespace rbts {
+
+/*!
+ * Combines elementwise two regular trees of the same size and shape.  When
+ * `share` is true, `fn(x, x) == x` is assumed and subtrees that are the same
+ * node in both trees are reused instead of being traversed.
+ */
+template <typename NodeT, typename Fn>
+struct zip_regular_op
+{
+    using node_t = NodeT;
+
+    static constexpr auto B  = node_t::bits;
+    static constexpr auto BL = node_t::bits_leaf;
+
+    Fn& fn;
+    bool share;
+
+    node_t* leaf(node_t* a, node_t* b, count_t n)
+    {
+        if (share && a == b)
+            return a->inc();
+        auto r  = node_t::make_leaf_n(n);
+        auto al = a->leaf();
+        auto bl = b->leaf();
+        auto rl = r->leaf();
+        auto i  = count_t{};
+        IMMER_TRY {
+            for (; i < n; ++i)
+                new (rl + i) typename node_t::value_t(fn(al[i], bl[i]));
+        }
+        IMMER_CATCH (...) {
+            detail::destroy_n(rl, i);
+            node_t::heap::deallocate(node_t::sizeof_leaf_n(n), r);
+            IMMER_RETHROW;
+        }
+        return r;
+    }
+
+    node_t* inner(node_t* a, node_t* b, shift_t shift, size_t size)
+    {
+        if (share && a == b)
+            return a->inc();
+        auto n = static_cast<count_t>(((size - 1) >> shift) + 1);
+        auto r = node_t::make_inner_n(n);
+        auto i = count_t{};
+        IMMER_TRY {
+            for (; i < n; ++i) {
+                auto sub  = size - (size_t{i} << shift);
+                auto full = size_t{1} << shift;
+                r->inner()[i] =
+                    shift == BL
+                        ? leaf(a->inner()[i], b->inner()[i], count_t{1} << BL)
+                        : inner(a->inner()[i],
+                                b->inner()[i],
+                                shift - B,
+                                std::min(sub, full));
+            }
+        }
+        IMMER_CATCH (...) {
+            for (auto j = count_t{}; j < i; ++j) {
+                if (shift == BL)
+                    dec_leaf(r->inner()[j], count_t{1} << BL);
+                else
+                    dec_regular(r->inner()[j],
+                                shift - B,
+                                std::min(size - (size_t{j} << shift),
+                                         size_t{1} << shift));
+            }
+            node_t::delete_inner(r, n);
+            IMMER_RETHROW;
+        }
+        return r;
+    }
+};
+
+/*!
+ * Returns a tree with `fn(a[i], b[i])` at every position `i`.  It is
+ * undefined unless both trees have the same size.  Trees with the same size
+ * built with regular operations have the same shape, otherwise the result
+ * is built with `push_back`.
+ */
+template <typename T, typename MemoryPolicy, bits_t B, bits_t BL, typename Fn>
+rbtree<T, MemoryPolicy, B, BL>
+zip_regular(const rbtree<T, MemoryPolicy, B, BL>& a,
+            const rbtree<T, MemoryPolicy, B, BL>& b,
+            Fn&& fn,
+            bool share)
+{
+    using tree_t = rbtree<T, MemoryPolicy, B, BL>;
+    using node_t = typename tree_t::node_t;
+    using op_t   = zip_regular_op<node_t, std::decay_t<Fn>>;
+
+    assert(a.size == b.size);
+    if (a.shift != b.shift) {
+        auto e = typename tree_t::owner_t{};
+        auto r = tree_t{};
+        for (auto i = size_t{}; i < a.size; ++i)
+            r.push_back_mut(e, fn(a.get(i), b.get(i)));
+        return r;
+    }
+
+    auto f        = std::decay_t<Fn>{std::forward<Fn>(fn)};
+    auto op       = op_t{f, share};
+    auto tail_off = a.tail_offset();
+    auto root     = tail_off ? op.inner(a.root, b.root, a.shift, tail_off)
+                             : tree_t::empty_root();
+    IMMER_TRY {
+        auto tail = op.leaf(a.tail, b.tail, a.tail_size());
+        return {a.size, a.shift, root, tail};
+    }
+    IMMER_CATCH (...) {
+        if (tail_off)
+            dec_regular(root, a.shift, tail_off);
+        else
+            dec_empty_regular(root);
+        IMMER_RETHROW;
+    }
+}
+
+} // namespace rbts
+} // namespace detail
+} // namespace immer
@@ -0,0 +1,376 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/array.hpp>
+#include <immer/box.hpp>
+#include <immer/config.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace immer {
+namespace detail {
+namespace text {
+
+/*!
+ * Node of a rope: either a leaf with a chunk of bytes, or an inner node with
+ * exactly two children.  Every node caches the number of bytes, newlines
+ * and UTF-8 code points below it, so that positions can be found descending
+ * from the root.
+ */
+template <typename MemoryPolicy>
+struct rope_node
+{
+    using node_ptr   = box<rope_node, MemoryPolicy>;
+    using chunk_t    = array<char, MemoryPolicy>;
+    using children_t = array<node_ptr, MemoryPolicy>;
+
+    std::size_t bytes      = 0;
+    std::size_t lines      = 0;
+    std::size_t codepoints = 0;
+    std::size_t height     = 0;
+    chunk_t chunk          = {};
+    children_t children    = {};
+
+    static bool is_codepoint_start(char c)
+    {
+        return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+    }
+
+    static rope_node leaf(chunk_t chunk)
+    {
+        auto r       = rope_node{};
+        r.bytes      = chunk.size();
+        r.lines      = std::count(chunk.begin(), chunk.end(), '\n');
+        r.codepoints = std::count_if(
+            chunk.begin(), chunk.end(), &rope_node::is_codepoint_start);
+        r.chunk      = std::move(chunk);
+        return r;
+    }
+
+    static rope_node inner(node_ptr l, node_ptr r)
+    {
+        auto n       = rope_node{};
+        n.bytes      = l->bytes + r->bytes;
+        n.lines      = l->lines + r->lines;
+        n.codepoints = l->codepoints + r->codepoints;
+        n.height     = std::max(l->height, r->height) + 1;
+        n.children   = {std::move(l), std::move(r)};
+        return n;
+    }
+
+    bool is_leaf() const { return children.empty(); }
+    const node_ptr& left() const { return children[0]; }
+    const node_ptr& right() const { return children[1]; }
+};
+
+/*!
+ * Persistent rope of bytes, implemented as an AVL tree of chunks.  It is
+ * built with the join based algorithms: `concat` joins two trees of any
+ * height in @f$ O(log(size)) @f$ and every other update is expressed as
+ * splits and concatenations.  Small adjacent leaves are merged when they
+ * are joined, so that repeated small insertions do not fragment the rope.
+ */
+template <typename MemoryPolicy, std::size_t ChunkSize>
+struct rope
+{
+    using node_t   = rope_node<MemoryPolicy>;
+    using node_ptr = typename node_t::node_ptr;
+    using chunk_t  = typename node_t::chunk_t;
+
+    static constexpr auto chunk_size = ChunkSize;
+
+    node_ptr root = empty();
+
+    static const node_ptr& empty()
+    {
+        static const auto empty_ = node_ptr{node_t{}};
+        return empty_;
+    }
+
+    static node_ptr make_leaf(const char* first, const char* last)
+    {
+        return node_t::leaf(chunk_t(first, last));
+    }
+
+    static node_ptr make_inner(node_ptr l, node_ptr r)
+    {
+        return node_t::inner(std::move(l), std::move(r));
+    }
+
+    static rope from_range(const char* first, const char* last)
+    {
+        auto n = static_cast<std::size_t>(last - first);
+        return {n ? build(first, (n + chunk_size - 1) / chunk_size, n)
+                  : empty()};
+    }
+
+    // builds a balanced tree for `n` bytes split in `leaves` chunks
+    static node_ptr build(const char* first, std::size_t leaves, std::size_t n)
+    {
+        if (leaves == 1)
+            return make_leaf(first, first + n);
+        auto lleaves = leaves / 2;
+        auto lsize   = std::min(n, lleaves * chunk_size);
+        return make_inner(build(first, lleaves, lsize),
+                          build(first + lsize, leaves - lleaves, n - lsize));
+    }
+
+    static std::size_t height(const node_ptr& p) { return p->height; }
+
+    static node_ptr rotate_left(const node_ptr& p)
+    {
+        auto& r = p->right();
+        return make_inner(make_inner(p->left(), r->left()), r->right());
+    }
+
+    static node_ptr rotate_right(const node_ptr& p)
+    {
+        auto& l = p->left();
+        return make_inner(l->left(), make_inner(l->right(), p->right()));
+    }
+
+    // joins two trees whose heights differ at most by two
+    static node_ptr balance(node_ptr l, node_ptr r)
+    {
+        if (height(l) > height(r) + 1) {
+            if (height(l->right()) > height(l->left()))
+                l = rotate_left(l);
+            return rotate_right(make_inner(std::move(l), std::move(r)));
+        } else if (height(r) > height(l) + 1) {
+            if (height(r->left()) > height(r->right()))
+                r = rotate_right(r);
+            return rotate_left(make_inner(std::move(l), std::move(r)));
+        } else {
+            return make_inner(std::move(l), std::move(r));
+        }
+    }
+
+    static node_ptr concat(const node_ptr& l, const node_ptr& r)
+    {
+        if (l->bytes == 0)
+            return r;
+        else if (r->bytes == 0)
+            return l;
+        else if (l->is_leaf() && r->is_leaf() &&
+                 l->bytes + r->bytes <= chunk_size)
+            return merge_leaves(l, r);
+        else if (height(l) > height(r) + 1)
+            return balance(l->left(), concat(l->right(), r));
+        else if (height(r) > height(l) + 1)
+            return balance(concat(l, r->left()), r->right());
+        else
+            return make_inner(l, r);
+    }
+
+    static node_ptr merge_leaves(const node_ptr& l, const node_ptr& r)
+    {
+        char buf[chunk_size];
+        auto last = std::copy(l->chunk.begin(), l->chunk.end(), buf);
+        last      = std::copy(r->chunk.begin(), r->chunk.end(), last);
+        return make_leaf(buf, last);
+    }
+
+    static std::pair<node_ptr, node_ptr> split(const node_ptr& p,
+                                               std::size_t k)
+    {
+        if (k == 0)
+            return {empty(), p};
+        else if (k >= p->bytes)
+            return {p, empty()};
+        else if (p->is_leaf()) {
+            auto d = p->chunk.data();
+            return {make_leaf(d, d + k), make_leaf(d + k, d + p->bytes)};
+        } else {
+            auto& l = p->left();
+            auto& r = p->right();
+            if (k < l->bytes) {
+                auto s = split(l, k);
+                return {std::move(s.first), concat(s.second, r)};
+            } else {
+                auto s = split(r, k - l->bytes);
+                return {concat(l, s.first), std::move(s.second)};
+            }
+        }
+    }
+
+    std::size_t size() const { return root->bytes; }
+
+    char get(std::size_t idx) const
+    {
+        auto p = &root;
+        while (!(*p)->is_leaf()) {
+            auto& l = (*p)->left();
+            if (idx < l->bytes) {
+                p = &l;
+            } else {
+                idx -= l->bytes;
+                p = &(*p)->right();
+            }
+        }
+        return (*p)->chunk[idx];
+    }
+
+    char get_check(std::size_t idx) const
+    {
+        if (idx >= size())
+            IMMER_THROW(std::out_of_range{"index out of range"});
+        return get(idx);
+    }
+
+    // offset just after the `k`-th newline, with `k > 0`
+    std::size_t newline_end(std::size_t k) const
+    {
+        assert(k > 0 && k <= root->lines);
+        auto offset = std::size_t{};
+        auto p      = &root;
+        while (!(*p)->is_leaf()) {
+            auto& l = (*p)->left();
+            if (k <= l->lines) {
+                p = &l;
+            } else {
+                k -= l->lines;
+                offset += l->bytes;
+                p = &(*p)->right();
+            }
+        }
+        auto& chunk = (*p)->chunk;
+        auto it     = chunk.begin();
+        for (;; ++it)
+            if (*it == '\n' && --k == 0)
+                break;
+        return offset + (it - chunk.begin()) + 1;
+    }
+
+    std::size_t line_to_offset(std::size_t line) const
+    {
+        return line == 0 ? 0 : newline_end(line);
+    }
+
+    std::size_t offset_to_line(std::size_t offset) const
+    {
+        auto line = std::size_t{};
+        auto p    = &root;
+        while (!(*p)->is_leaf()) {
+            auto& l = (*p)->left();
+            if (offset < l->bytes) {
+                p = &l;
+            } else {
+                line += l->lines;
+                offset -= l->bytes;
+                p = &(*p)->right();
+            }
+        }
+        auto& chunk = (*p)->chunk;
+        auto last   = chunk.begin() + std::min(offset, chunk.size());
+        return line + std::count(chunk.begin(), last, '\n');
+    }
+
+    template <typename Fn>
+    static bool for_each_chunk_p(const node_ptr& p,
+                                 std::size_t first,
+                                 std::size_t last,
+                                 Fn& fn)
+    {
+        if (p->is_leaf()) {
+            auto d = p->chunk.data();
+            return fn(d + first, d + last);
+        }
+        auto& l = p->left();
+        auto& r = p->right();
+        auto lb = l->bytes;
+        return (first >= lb ||
+                for_each_chunk_p(l, first, std::min(last, lb), fn)) &&
+               (last <= lb ||
+                for_each_chunk_p(r,
+                                 first > lb ? first - lb : 0,
+                                 last - lb,
+                                 fn));
+    }
+
+    template <typename Fn>
+    bool for_each_chunk_p(std::size_t first, std::size_t last, Fn&& fn) const
+    {
+        return first >= last || for_each_chunk_p(root, first, last, fn);
+    }
+
+    template <typename Fn>
+    bool for_each_chunk_p(Fn&& fn) const
+    {
+        return for_each_chunk_p(0, size(), std::forward<Fn>(fn));
+    }
+
+    template <typename Fn>
+    void for_each_chunk(std::size_t first, std::size_t last, Fn&& fn) const
+    {
+        for_each_chunk_p(first, last, [&](auto f, auto l) {
+            fn(f, l);
+            return true;
+        });
+    }
+
+    template <typename Fn>
+    void for_each_chunk(Fn&& fn) const
+    {
+        for_each_chunk(0, size(), std::forward<Fn>(fn));
+    }
+
+    bool equals(const rope& other) const
+    {
+        if (root.impl() == other.root.impl())
+            return true;
+        if (size() != other.size())
+            return false;
+        auto offset = std::size_t{};
+        return for_each_chunk_p([&](auto f, auto l) {
+            auto first = offset;
+            offset += l - f;
+            return other.for_each_chunk_p(first, offset, [&](auto f2, auto l2) {
+                auto eq = std::equal(f2, l2, f);
+                f += l2 - f2;
+                return eq;
+            });
+        });
+    }
+
+    rope concat(const rope& other) const
+    {
+        return {concat(root, other.root)};
+    }
+
+    rope take(std::size_t n) const { return {split(root, n).first}; }
+
+    rope drop(std::size_t n) const { return {split(root, n).second}; }
+
+    rope slice(std::size_t first, std::size_t last) const
+    {
+        return {split(split(root, last).first, first).second};
+    }
+
+    rope insert(std::size_t offset, const rope& other) const
+    {
+        auto s = split(root, offset);
+        return {concat(concat(s.first, other.root), s.second)};
+    }
+
+    rope erase(std::size_t first, std::size_t last) const
+    {
+        auto l = split(root, first).first;
+        auto r = split(root, last).second;
+        return {concat(l, r)};
+    }
+};
+
+} // namespace text
+} // namespace detail
+} // namespace immer
@@ -10,7 +10,9 @@
 
 #include <immer/config.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <memory>
 #include <new>
 #include <type_traits>
@@ -204,11 +206,34 @@ constexpr bool can_trivially_copy =
     std::is_trivially_copyable<
         typename std::iterator_traits<Iter1>::value_type>::value;
 
+template <typename Iter1, typename Iter2>
+Iter2 copy_trivially(Iter1 first, Iter1 last, Iter2 out) noexcept
+{
+    return std::copy(first, last, out);
+}
+
+// Copies into uninitialized memory never overlap with the source, so they do
+// not need the memmove that std::copy falls back to.
+template <typename T>
+T* copy_trivially(const T* first, const T* last, T* out) noexcept
+{
+    auto n = static_cast<std::size_t>(last - first);
+    if (n)
+        std::memcpy(static_cast<void*>(out), first, n * sizeof(T));
+    return out + n;
+}
+
+template <typename T>
+T* copy_trivially(T* first, T* last, T* out) noexcept
+{
+    return detail::copy_trivially(as_const(first), as_const(last), out);
+}
+
 template <typename Iter1, typename Iter2>
 auto uninitialized_move(Iter1 first, Iter1 last, Iter2 out) noexcept
     -> std::enable_if_t<can_trivially_copy<Iter1, Iter2>, Iter2>
 {
-    return std::copy(first, last, out);
+    return detail::copy_trivially(first, last, out);
 }
 template <typename Iter1, typename Iter2>
 auto uninitialized_move(Iter1 first, Iter1 last, Iter2 out)
@@ -234,7 +259,7 @@ template <typename SourceIter, typename Sent, typename SinkIter>
 auto uninitialized_copy(SourceIter first, Sent last, SinkIter out) noexcept
     -> std::enable_if_t<can_trivially_copy<SourceIter, SinkIter>, SinkIter>
 {
-    return std::copy(first, last, out);
+    return detail::copy_trivially(first, last, out);
 }
 template <typename SourceIter, typename Sent, typename SinkIter>
 auto uninitialized_copy(SourceIter first, Sent last, SinkIter out)
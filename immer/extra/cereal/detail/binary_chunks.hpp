@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cereal/cereal.hpp>
+#include <immer/algorithm.hpp>
+#include <immer/config.hpp>
+#include <immer/detail/rbts/operations.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+namespace cereal {
+namespace immer_detail {
+
+/*!
+ * Whether the elements of a container of `T` can be saved to `Archive` as raw
+ * blocks of memory, like `cereal` does for `std::vector` of arithmetic types.
+ * This is only the case for binary archives.
+ */
+template <typename Archive, typename T>
+struct is_binary_output_chunkable
+    : std::integral_constant<
+          bool,
+          traits::is_output_serializable<BinaryData<T>, Archive>::value &&
+              std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>
+{};
+
+template <typename Archive, typename T>
+struct is_binary_input_chunkable
+    : std::integral_constant<
+          bool,
+          traits::is_input_serializable<BinaryData<T>, Archive>::value &&
+              std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>
+{};
+
+/*!
+ * Saves the size of the container followed by one block of binary data per
+ * contiguous chunk of its elements, usually one per leaf.
+ */
+template <typename Archive, typename Container>
+void save_binary_chunks(Archive& ar, const Container& m)
+{
+    using T = typename Container::value_type;
+    ar(make_size_tag(static_cast<size_type>(m.size())));
+    immer::for_each_chunk(m, [&](const T* first, const T* last) {
+        const auto n = static_cast<std::size_t>(last - first);
+        ar(binary_data(first, n * sizeof(T)));
+    });
+}
+
+/*!
+ * Loads a container saved with `save_binary_chunks`.  The elements are read
+ * straight into freshly allocated leaves, one leaf at a time, and the full
+ * leaves are then linked into the tree without copying their elements.
+ */
+template <typename Archive, typename Container>
+void load_binary_chunks(Archive& ar, Container& m)
+{
+    using T      = typename Container::value_type;
+    using impl_t = std::decay_t<decltype(m.impl())>;
+    using node_t = typename impl_t::node_t;
+
+    size_type size;
+    ar(make_size_tag(size));
+
+    constexpr auto chunk = immer::detail::rbts::branches<node_t::bits_leaf>;
+    auto owner           = typename impl_t::owner_t{};
+    auto impl            = impl_t{};
+    while (size) {
+        const auto n = static_cast<immer::detail::rbts::count_t>(
+            std::min(size, static_cast<size_type>(chunk)));
+        auto leaf = node_t::make_leaf_n(n);
+        IMMER_TRY {
+            ar(binary_data(leaf->leaf(), n * sizeof(T)));
+            impl.push_leaf_mut(owner, leaf, n);
+        }
+        IMMER_CATCH (...) {
+            node_t::delete_leaf(leaf, n);
+            IMMER_RETHROW;
+        }
+        immer::detail::rbts::dec_leaf(leaf, n);
+        size -= n;
+    }
+    m = Container{std::move(impl)};
+}
+
+} // namespace immer_detail
+} // namespace cereal
@@ -2,11 +2,14 @@
 
 #include <cereal/cereal.hpp>
 #include <immer/array.hpp>
+#include <immer/array_transient.hpp>
+#include <immer/extra/cereal/detail/binary_chunks.hpp>
 
 namespace cereal {
 
 template <typename Archive, typename T, typename MemoryPolicy>
-void CEREAL_LOAD_FUNCTION_NAME(Archive& ar, immer::array<T, MemoryPolicy>& m)
+std::enable_if_t<!immer_detail::is_binary_input_chunkable<Archive, T>::value>
+CEREAL_LOAD_FUNCTION_NAME(Archive& ar, immer::array<T, MemoryPolicy>& m)
 {
     size_type size;
     ar(make_size_tag(size));
@@ -20,12 +23,34 @@ void CEREAL_LOAD_FUNCTION_NAME(Archive& ar, immer::array<T, MemoryPolicy>& m)
 }
 
 template <typename Archive, typename T, typename MemoryPolicy>
-void CEREAL_SAVE_FUNCTION_NAME(Archive& ar,
-                               const immer::array<T, MemoryPolicy>& m)
+std::enable_if_t<immer_detail::is_binary_input_chunkable<Archive, T>::value>
+CEREAL_LOAD_FUNCTION_NAME(Archive& ar, immer::array<T, MemoryPolicy>& m)
+{
+    size_type size;
+    ar(make_size_tag(size));
+
+    // The array is contiguous, so it can be read in a single block
+    auto t = immer::array<T, MemoryPolicy>(static_cast<std::size_t>(size))
+                 .transient();
+    ar(binary_data(t.data_mut(), static_cast<std::size_t>(size) * sizeof(T)));
+    m = std::move(t).persistent();
+}
+
+template <typename Archive, typename T, typename MemoryPolicy>
+std::enable_if_t<!immer_detail::is_binary_output_chunkable<Archive, T>::value>
+CEREAL_SAVE_FUNCTION_NAME(Archive& ar, const immer::array<T, MemoryPolicy>& m)
 {
     ar(make_size_tag(static_cast<size_type>(m.size())));
     for (auto&& v : m)
         ar(v);
 }
 
+template <typename Archive, typename T, typename MemoryPolicy>
+std::enable_if_t<immer_detail::is_binary_output_chunkable<Archive, T>::value>
+CEREAL_SAVE_FUNCTION_NAME(Archive& ar, const immer::array<T, MemoryPolicy>& m)
+{
+    ar(make_size_tag(static_cast<size_type>(m.size())));
+    ar(binary_data(m.data(), m.size() * sizeof(T)));
+}
+
 } // namespace cereal
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <cereal/cereal.hpp>
+#include <immer/extra/cereal/detail/binary_chunks.hpp>
+#include <immer/flex_vector.hpp>
+#include <immer/flex_vector_transient.hpp>
 #include <immer/vector.hpp>
+#include <immer/vector_transient.hpp>
 
 namespace cereal {
 
@@ -10,8 +14,8 @@ template <typename Archive,
           typename MemoryPolicy,
           immer::detail::rbts::bits_t B,
           immer::detail::rbts::bits_t BL>
-void CEREAL_LOAD_FUNCTION_NAME(Archive& ar,
-                               immer::vector<T, MemoryPolicy, B, BL>& m)
+std::enable_if_t<!immer_detail::is_binary_input_chunkable<Archive, T>::value>
+CEREAL_LOAD_FUNCTION_NAME(Archive& ar, immer::vector<T, MemoryPolicy, B, BL>& m)
 {
     size_type size;
     ar(make_size_tag(size));
@@ -29,8 +33,20 @@ template <typename Archive,
           typename MemoryPolicy,
           immer::detail::rbts::bits_t B,
           immer::detail::rbts::bits_t BL>
-void CEREAL_SAVE_FUNCTION_NAME(Archive& ar,
-                               const immer::vector<T, MemoryPolicy, B, BL>& m)
+std::enable_if_t<immer_detail::is_binary_input_chunkable<Archive, T>::value>
+CEREAL_LOAD_FUNCTION_NAME(Archive& ar, immer::vector<T, MemoryPolicy, B, BL>& m)
+{
+    immer_detail::load_binary_chunks(ar, m);
+}
+
+template <typename Archive,
+          typename T,
+          typename MemoryPolicy,
+          immer::detail::rbts::bits_t B,
+          immer::detail::rbts::bits_t BL>
+std::enable_if_t<!immer_detail::is_binary_output_chunkable<Archive, T>::value>
+CEREAL_SAVE_FUNCTION_NAME(Archive& ar,
+                          const immer::vector<T, MemoryPolicy, B, BL>& m)
 {
     ar(make_size_tag(static_cast<size_type>(m.size())));
     for (auto&& v : m)
@@ -42,8 +58,21 @@ template <typename Archive,
           typename MemoryPolicy,
           immer::detail::rbts::bits_t B,
           immer::detail::rbts::bits_t BL>
-void CEREAL_LOAD_FUNCTION_NAME(Archive& ar,
-                               immer::flex_vector<T, MemoryPolicy, B, BL>& m)
+std::enable_if_t<immer_detail::is_binary_output_chunkable<Archive, T>::value>
+CEREAL_SAVE_FUNCTION_NAME(Archive& ar,
+                          const immer::vector<T, MemoryPolicy, B, BL>& m)
+{
+    immer_detail::save_binary_chunks(ar, m);
+}
+
+template <typename Archive,
+          typename T,
+          typename MemoryPolicy,
+          immer::detail::rbts::bits_t B,
+          immer::detail::rbts::bits_t BL>
+std::enable_if_t<!immer_detail::is_binary_input_chunkable<Archive, T>::value>
+CEREAL_LOAD_FUNCTION_NAME(Archive& ar,
+                          immer::flex_vector<T, MemoryPolicy, B, BL>& m)
 {
     size_type size;
     ar(make_size_tag(size));
@@ -61,12 +90,37 @@ template <typename Archive,
           typename MemoryPolicy,
           immer::detail::rbts::bits_t B,
           immer::detail::rbts::bits_t BL>
-void CEREAL_SAVE_FUNCTION_NAME(
-    Archive& ar, const immer::flex_vector<T, MemoryPolicy, B, BL>& m)
+std::enable_if_t<immer_detail::is_binary_input_chunkable<Archive, T>::value>
+CEREAL_LOAD_FUNCTION_NAME(Archive& ar,
+                          immer::flex_vector<T, MemoryPolicy, B, BL>& m)
+{
+    immer_detail::load_binary_chunks(ar, m);
+}
+
+template <typename Archive,
+          typename T,
+          typename MemoryPolicy,
+          immer::detail::rbts::bits_t B,
+          immer::detail::rbts::bits_t BL>
+std::enable_if_t<!immer_detail::is_binary_output_chunkable<Archive, T>::value>
+CEREAL_SAVE_FUNCTION_NAME(Archive& ar,
+                          const immer::flex_vector<T, MemoryPolicy, B, BL>& m)
 {
     ar(make_size_tag(static_cast<size_type>(m.size())));
     for (auto&& v : m)
         ar(v);
 }
 
+template <typename Archive,
+          typename T,
+          typename MemoryPolicy,
+          immer::detail::rbts::bits_t B,
+          immer::detail::rbts::bits_t BL>
+std::enable_if_t<immer_detail::is_binary_output_chunkable<Archive, T>::value>
+CEREAL_SAVE_FUNCTION_NAME(Archive& ar,
+                          const immer::flex_vector<T, MemoryPolicy, B, BL>& m)
+{
+    immer_detail::save_binary_chunks(ar, m);
+}
+
 } // namespace cereal
@@ -190,11 +190,63 @@ auto hana_struct_auto_member_name_policy(const T& value)
     return hana_struct_auto_member_name_policy_t<std::decay_t<T>>{};
 }
 
+/**
+ * @brief Policy mixin that makes the pools identify the nodes of the `immer`
+ * containers by their content instead of by their address in memory.
+ *
+ * By default, two structurally identical subtrees are only written once if
+ * they are the same object in memory.  With this mixin, equal leaves and
+ * inner nodes are detected using a hash of their values and of the ids of
+ * their children, computed with `xxHash`, and collapse into a single entry of
+ * the pool.  This is useful for containers that were built independently, for
+ * example after loading and saving them again, and reduces both the size of
+ * the output and the memory used by the loaded containers, since the loaded
+ * nodes are shared again.
+ *
+ * Nodes are only merged when their values compare equal, so the values must
+ * be equality comparable and hashable, either via an `xx_hash_value`
+ * function, `std::hash` or because they have a unique object representation.
+ * Otherwise the leaves of the container are saved as usual.
+ *
+ * Currently supported by the pools of vectors, flex vectors and the
+ * champ-based containers (maps, sets and tables).
+ *
+ * @ingroup persist-policy
+ */
+struct content_dedup_t
+{
+    static constexpr bool content_dedup = true;
+};
+
+/**
+ * @brief Policy mixin that stores the values of the pools using a compact
+ * binary encoding, when they are of arithmetic types.
+ *
+ * The values of every leaf are written as a block of 64-bit words using
+ * frame-of-reference or delta encoding, whichever is smaller, followed by
+ * bit-packing, and saved as a single base64 string.  This works well for
+ * sorted or clustered integers, like ids or timestamps, and is lossless for
+ * every arithmetic type, including floating point numbers.  The values of `std::pair`s of arithmetic types, like the
+ * ones stored in an `immer::map<std::uint32_t, double>`, are also encoded,
+ * one column per element of the pair.
+ *
+ * The values of other types are saved as usual.  The same policy must be used
+ * to load the pools.
+ *
+ * @ingroup persist-policy
+ */
+struct compress_values_t
+{
+    static constexpr bool compress_values = true;
+};
+
 using default_policy = via_get_pools_types_policy;
 
 template <class Policy>
 struct get_pool_name_fn_t
 {
+    using policy_t = Policy;
+
     template <class T>
     auto operator()(const T& value) const
     {
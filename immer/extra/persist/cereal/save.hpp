@@ -28,7 +28,7 @@ void cereal_save_with_pools(std::ostream& os,
                             Args&&... args)
 {
     const auto types = boost::hana::to_set(policy.get_pool_types(value0));
-    auto pools       = detail::generate_output_pools(types);
+    auto pools       = detail::generate_output_pools(types, policy);
     const auto wrap  = detail::wrap_known_types(types, detail::wrap_for_saving);
     using Pools      = std::decay_t<decltype(pools)>;
     auto ar          = immer::persist::output_pools_cereal_archive_wrapper<
@@ -5,9 +5,14 @@
 #include <immer/extra/persist/detail/common/pool.hpp>
 #include <immer/extra/persist/detail/traits.hpp>
 #include <immer/extra/persist/errors.hpp>
+#include <immer/extra/persist/parallel.hpp>
+
+#include <immer/array_transient.hpp>
 
 #include <boost/hana/functional/id.hpp>
 
+#include <vector>
+
 namespace immer::persist::array {
 
 template <typename T, typename MemoryPolicy>
@@ -153,17 +158,45 @@ public:
             if (auto* b = arrays_.find(id)) {
                 return *b;
             }
-            const auto& old_array = pool_.arrays[id.value];
-            auto new_array        = immer::array<T, MemoryPolicy>{};
-            for (const auto& item : old_array) {
-                new_array = std::move(new_array).push_back(transform_(item));
-            }
-            arrays_ = std::move(arrays_).set(id, new_array);
+            auto new_array = transform_array(pool_.arrays[id.value]);
+            arrays_        = std::move(arrays_).set(id, new_array);
             return new_array;
         }
     }
 
+    /**
+     * Transforms all the arrays of the pool using multiple threads.
+     */
+    void precompute_transform(const parallel_options& options)
+    {
+        if constexpr (!std::is_same_v<TransformF, boost::hana::id_t>) {
+            auto arrays = std::vector<immer::array<T, MemoryPolicy>>(
+                pool_.arrays.size());
+            persist::detail::parallel_for(
+                arrays.size(), options, [&](std::size_t i) {
+                    arrays[i] = transform_array(pool_.arrays[i]);
+                });
+            for (auto i = std::size_t{}; i < arrays.size(); ++i) {
+                const auto id = container_id{i};
+                if (!arrays_.count(id)) {
+                    arrays_ = std::move(arrays_).set(id, std::move(arrays[i]));
+                }
+            }
+        }
+    }
+
 private:
+    template <class OldArray>
+    immer::array<T, MemoryPolicy>
+    transform_array(const OldArray& old_array) const
+    {
+        auto new_array = immer::array<T, MemoryPolicy>{}.transient();
+        for (const auto& item : old_array) {
+            new_array.push_back(transform_(item));
+        }
+        return new_array.persistent();
+    }
+
     const Pool pool_{};
     const TransformF transform_{};
     immer::map<container_id, immer::array<T, MemoryPolicy>> arrays_;
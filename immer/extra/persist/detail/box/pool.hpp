@@ -3,6 +3,7 @@
 #include <immer/extra/persist/detail/common/pool.hpp>
 #include <immer/extra/persist/detail/traits.hpp>
 #include <immer/extra/persist/errors.hpp>
+#include <immer/extra/persist/parallel.hpp>
 
 #include <immer/box.hpp>
 #include <immer/map.hpp>
@@ -12,6 +13,8 @@
 
 #include <boost/hana/functional/id.hpp>
 
+#include <optional>
+
 namespace immer::persist::box {
 
 template <typename T, typename MemoryPolicy>
@@ -177,6 +180,28 @@ public:
         }
     }
 
+    /**
+     * Transforms the values of all the boxes of the pool using multiple
+     * threads.
+     */
+    void precompute_transform(const parallel_options& options)
+    {
+        if constexpr (!std::is_same_v<TransformF, boost::hana::id_t>) {
+            auto values = std::vector<std::optional<T>>(pool_.boxes.size());
+            persist::detail::parallel_for(
+                values.size(), options, [&](std::size_t i) {
+                    values[i].emplace(transform_(pool_.boxes[i].get()));
+                });
+            for (auto i = std::size_t{}; i < values.size(); ++i) {
+                const auto id = container_id{i};
+                if (!boxes_.count(id)) {
+                    boxes_ = std::move(boxes_).set(
+                        id, immer::box<T, MemoryPolicy>{std::move(*values[i])});
+                }
+            }
+        }
+    }
+
 private:
     const Pool pool_{};
     const TransformF transform_{};
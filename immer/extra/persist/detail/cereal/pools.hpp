@@ -5,10 +5,13 @@
 #include <immer/extra/persist/detail/names.hpp>
 #include <immer/extra/persist/detail/traits.hpp>
 #include <immer/extra/persist/errors.hpp>
+#include <immer/extra/persist/parallel.hpp>
+#include <immer/extra/persist/xxhash/xxhash.hpp>
 
 #include <boost/hana.hpp>
 
 #include <optional>
+#include <type_traits>
 
 namespace immer::persist::detail {
 
@@ -291,7 +294,11 @@ public:
         hana::for_each(keys_t{}, [&](auto key) {
             using Container  = typename decltype(key)::type;
             const auto& name = pool_name_fn{}(Container{});
-            ar(cereal::make_nvp(name, storage()[key].pool));
+            try {
+                ar(cereal::make_nvp(name, storage()[key].pool));
+            } catch (const invalid_compressed_values& e) {
+                throw invalid_compressed_values{e.id(), name};
+            }
         });
     }
 
@@ -409,6 +416,38 @@ public:
         return input_pools<decltype(holder)>{std::move(holder)};
     }
 
+    /**
+     * Eagerly transforms the values of the pools produced by
+     * `transform_recursive` using multiple threads.
+     *
+     * Only the pools converted by functions of one argument are transformed
+     * here.  Functions that take the second argument may load other
+     * containers while converting, which is not thread-safe, so they keep
+     * being applied lazily.
+     */
+    template <class ConversionMap>
+    void precompute_transform(const ConversionMap& conversion_map,
+                              const parallel_options& options)
+    {
+        hana::for_each(hana::keys(storage()), [&](auto key) {
+            using TypeLoad     = std::decay_t<decltype(storage()[key])>;
+            using OldContainer = typename TypeLoad::old_container_t;
+            const auto old_key = hana::type_c<OldContainer>;
+            using needs_conversion_t =
+                decltype(hana::contains(conversion_map, old_key));
+            if constexpr (needs_conversion_t::value) {
+                using Func = decltype(conversion_map[old_key]);
+                if constexpr (std::is_invocable_v<
+                                  Func,
+                                  const typename OldContainer::value_type&>) {
+                    storage()[key]
+                        .get_loader_from_per_type_pool()
+                        .precompute_transform(options);
+                }
+            }
+        });
+    }
+
     void merge_previous(const input_pools& original)
     {
         auto& s                = storage();
@@ -449,6 +488,40 @@ auto generate_output_pools(T types)
     return output_pools<Storage>{storage};
 }
 
+template <class Policy, class = void>
+struct policy_content_dedup : std::false_type
+{};
+
+template <class Policy>
+struct policy_content_dedup<Policy,
+                            std::void_t<decltype(Policy::content_dedup)>>
+    : std::bool_constant<Policy::content_dedup>
+{};
+
+/**
+ * Generates the output pools and configures them according to the policy.
+ */
+template <class T, class Policy>
+auto generate_output_pools(T types, const Policy&)
+{
+    auto pools = generate_output_pools(types);
+    if constexpr (policy_content_dedup<Policy>::value) {
+        constexpr auto has_hash = hana::is_valid(
+            [](auto& pool) -> decltype((void) pool.content_hash) {});
+        constexpr auto has_nodes_hash = hana::is_valid(
+            [](auto& pool) -> decltype((void) pool.nodes.content_hash) {});
+        hana::for_each(hana::keys(pools.storage()), [&](auto key) {
+            auto& pool = pools.storage()[key];
+            if constexpr (decltype(has_hash(pool))::value) {
+                pool.content_hash = &xx_hash_bytes;
+            } else if constexpr (decltype(has_nodes_hash(pool))::value) {
+                pool.nodes.content_hash = &xx_hash_bytes;
+            }
+        });
+    }
+    return pools;
+}
+
 template <class T>
 auto generate_input_pools(T types)
 {
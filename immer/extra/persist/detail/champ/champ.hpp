@@ -143,6 +143,16 @@ public:
         return impl;
     }
 
+    /**
+     * Transforms the values of all the nodes in parallel.  When the hash of
+     * the values changes, the containers are still rebuilt one value at a
+     * time, but from the already transformed values.
+     */
+    void precompute_transform(const parallel_options& options)
+    {
+        nodes_.precompute_transform(options);
+    }
+
 private:
     const Pool pool_;
     nodes_loader<typename node_t::value_t,
@@ -165,7 +175,20 @@ std::pair<container_output_pool<Container>, node_id>
 add_to_pool(Container container, container_output_pool<Container> pool)
 {
     const auto& impl = container.impl();
-    auto root_id     = node_id{};
+    if (pool.nodes.content_hash) {
+        // The ids of the nodes depend on their content, so they are known
+        // only once the nodes have been saved.  The container is kept alive
+        // even when all its nodes were already in the pool, since their
+        // addresses are remembered.
+        if (!pool.nodes.node_ptr_to_id.count(impl.root)) {
+            pool.nodes      = save_nodes(impl, std::move(pool.nodes));
+            pool.containers = std::move(pool.containers).push_back(container);
+        }
+        const auto root_id = *pool.nodes.node_ptr_to_id.find(impl.root);
+        return {std::move(pool), root_id};
+    }
+
+    auto root_id = node_id{};
     std::tie(pool.nodes, root_id) =
         get_node_id(std::move(pool.nodes), impl.root);
 
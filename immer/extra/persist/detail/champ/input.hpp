@@ -3,12 +3,16 @@
 #include <immer/extra/persist/detail/champ/pool.hpp>
 #include <immer/extra/persist/detail/node_ptr.hpp>
 #include <immer/extra/persist/errors.hpp>
+#include <immer/extra/persist/parallel.hpp>
 
 #include <immer/flex_vector.hpp>
 
 #include <boost/hana/functional/id.hpp>
 #include <boost/range/adaptor/indexed.hpp>
 
+#include <optional>
+#include <vector>
+
 namespace immer::persist::champ {
 
 class children_count_corrupted_exception : public pool_exception
@@ -88,7 +92,7 @@ public:
         }
 
         const auto& node_info = pool_[id.value];
-        const auto values     = get_values(node_info.values.data);
+        const auto values     = get_values(id, node_info.values.data);
 
         const auto n = values.size();
         auto node    = node_ptr{node_t::make_collision_n(n),
@@ -134,7 +138,7 @@ public:
             }
         }
 
-        const auto node_values = get_values(node_info.values.data);
+        const auto node_values = get_values(id, node_info.values.data);
 
         auto values = values_t{};
 
@@ -224,20 +228,54 @@ public:
         return {std::move(children), std::move(values)};
     }
 
+    /**
+     * Applies the transformation to the values of all the nodes of the pool
+     * using multiple threads.  Every node is transformed independently, so
+     * the structure of the pool is preserved.
+     */
+    void precompute_transform(const parallel_options& options)
+    {
+        if constexpr (!std::is_same_v<TransformF, boost::hana::id_t>) {
+            transformed_values_.resize(pool_.size());
+            persist::detail::parallel_for(
+                pool_.size(), options, [&](std::size_t i) {
+                    const auto id = node_id{i};
+                    if (!transformed_values_[i] && !inners_.count(id) &&
+                        !collisions_.count(id)) {
+                        transformed_values_[i] =
+                            transform_values(pool_[i].values.data);
+                    }
+                });
+        }
+    }
+
 private:
     template <class Array>
-    immer::array<T> get_values(const Array& array) const
+    immer::array<T> get_values(node_id id, const Array& array)
     {
         if constexpr (std::is_same_v<TransformF, boost::hana::id_t>) {
             return array;
         } else {
-            auto transformed_values = std::vector<T>{};
-            for (const auto& item : array) {
-                transformed_values.push_back(transform_(item));
+            if (id.value < transformed_values_.size()) {
+                if (auto& values = transformed_values_[id.value]) {
+                    auto result = std::move(*values);
+                    values.reset();
+                    return result;
+                }
             }
-            return immer::array<T>{transformed_values.begin(),
-                                   transformed_values.end()};
+            return transform_values(array);
+        }
+    }
+
+    template <class Array>
+    immer::array<T> transform_values(const Array& array) const
+    {
+        auto transformed_values = std::vector<T>{};
+        for (const auto& item : array) {
+            transformed_values.push_back(transform_(item));
         }
+        return immer::array<T>{transformed_values.begin(),
+                               transformed_values.end()};
     }
 
 private:
@@ -245,6 +283,9 @@ private:
     const TransformF transform_{};
     immer::map<node_id, std::pair<node_ptr, values_t>> collisions_;
     immer::map<node_id, std::pair<node_ptr, values_t>> inners_;
+    // Values computed by `precompute_transform()`, indexed by node id.  Each
+    // one is released once its node is loaded.
+    std::vector<std::optional<immer::array<T>>> transformed_values_;
 };
 
 } // namespace immer::persist::champ
@@ -2,8 +2,23 @@
 
 #include <immer/extra/persist/detail/champ/pool.hpp>
 
+#include <algorithm>
+
 namespace immer::persist::champ {
 
+template <class Node>
+struct node_hash;
+
+template <typename T,
+          typename Hash,
+          typename Equal,
+          typename MemoryPolicy,
+          immer::detail::hamts::bits_t B>
+struct node_hash<immer::detail::hamts::node<T, Hash, Equal, MemoryPolicy, B>>
+{
+    using type = Hash;
+};
+
 template <class T, immer::detail::hamts::bits_t B>
 struct output_pool_builder
 {
@@ -12,6 +27,11 @@ struct output_pool_builder
     template <class Node, class Depth>
     void visit_inner(const Node* node, Depth depth)
     {
+        if (pool.content_hash) {
+            visit_inner_by_content(node, depth);
+            return;
+        }
+
         auto id = get_node_id(node);
         if (pool.inners.count(id)) {
             return;
@@ -42,19 +62,123 @@ struct output_pool_builder
     template <class Node>
     void visit_collision(const Node* node)
     {
+        if (pool.content_hash) {
+            if (!pool.node_ptr_to_id.count(node)) {
+                save_by_content(node, collision_info(node));
+            }
+            return;
+        }
+
         auto id = get_node_id(node);
         if (pool.inners.count(id)) {
             return;
         }
 
-        pool.inners = std::move(pool.inners)
-                          .set(id,
-                               inner_node_save<T, B>{
-                                   .values     = {node->collisions(),
-                                                  node->collisions() +
-                                                      node->collision_count()},
-                                   .collisions = true,
-                               });
+        pool.inners = std::move(pool.inners).set(id, collision_info(node));
+    }
+
+    template <class Node>
+    static inner_node_save<T, B> collision_info(const Node* node)
+    {
+        return {
+            .values     = {node->collisions(),
+                           node->collisions() + node->collision_count()},
+            .collisions = true,
+        };
+    }
+
+    /**
+     * Saves the node after its children, identifying it by a hash of its
+     * values and of the ids of its children.  Equal subtrees collapse into a
+     * single entry of the pool.
+     */
+    template <class Node, class Depth>
+    void visit_inner_by_content(const Node* node, Depth depth)
+    {
+        if (pool.node_ptr_to_id.count(node)) {
+            return;
+        }
+
+        auto node_info = inner_node_save<T, B>{
+            .nodemap = node->nodemap(),
+            .datamap = node->datamap(),
+        };
+
+        if (node->datamap()) {
+            node_info.values = {node->values(),
+                                node->values() + node->data_count()};
+        }
+        if (node->nodemap()) {
+            auto fst = node->children();
+            auto lst = fst + node->children_count();
+            for (; fst != lst; ++fst) {
+                visit(*fst, depth + 1);
+                auto* child_id = pool.node_ptr_to_id.find(*fst);
+                assert(child_id);
+                node_info.children =
+                    std::move(node_info.children).push_back(*child_id);
+            }
+        }
+
+        save_by_content(node, std::move(node_info));
+    }
+
+    template <class Node>
+    void save_by_content(const Node* node, inner_node_save<T, B> node_info)
+    {
+        using hash_t = typename node_hash<Node>::type;
+
+        auto hasher = persist::detail::content_hasher{
+            pool.content_hash, persist::detail::content_hash_inner_seed};
+        hasher.add(static_cast<std::uint64_t>(node_info.nodemap));
+        hasher.add(static_cast<std::uint64_t>(node_info.datamap));
+        hasher.add(std::uint64_t{node_info.collisions});
+        if constexpr (persist::detail::is_content_hashable_v<T>) {
+            hasher.add_values(node_info.values.begin, node_info.values.end);
+        } else {
+            // The hash of the container may only cover part of the value,
+            // like the key of a map, so more nodes collide.  They are still
+            // compared before being merged.
+            hasher.add_values(
+                node_info.values.begin, node_info.values.end, hash_t{});
+        }
+        for (const auto& child : node_info.children) {
+            hasher.add(child);
+        }
+        const auto hash = hasher.finish();
+
+        if constexpr (persist::detail::is_equality_comparable<T>::value) {
+            if (auto* id = pool.content_to_id.find(hash)) {
+                auto* other = pool.inners.find(*id);
+                assert(other);
+                if (same_content(*other, node_info)) {
+                    pool.node_ptr_to_id = std::move(pool.node_ptr_to_id)
+                                              .set(node, *id);
+                    return;
+                }
+            }
+        }
+
+        // Ids are only assigned to the nodes that are actually stored, so
+        // they stay consecutive.  Nodes that collide with an already known
+        // hash are stored without deduplication.
+        const auto id = node_id{pool.inners.size()};
+        if (!pool.content_to_id.count(hash)) {
+            pool.content_to_id = std::move(pool.content_to_id).set(hash, id);
+        }
+        pool.inners = std::move(pool.inners).set(id, std::move(node_info));
+        pool.node_ptr_to_id = std::move(pool.node_ptr_to_id).set(node, id);
+    }
+
+    static bool same_content(const inner_node_save<T, B>& a,
+                             const inner_node_save<T, B>& b)
+    {
+        return a.nodemap == b.nodemap && a.datamap == b.datamap &&
+               a.collisions == b.collisions && a.children == b.children &&
+               std::equal(a.values.begin,
+                          a.values.end,
+                          b.values.begin,
+                          b.values.end);
     }
 
     template <class Node>
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <immer/extra/persist/detail/common/content_hash.hpp>
 #include <immer/extra/persist/detail/common/pool.hpp>
+#include <immer/extra/persist/errors.hpp>
 
 #include <immer/map.hpp>
 #include <immer/set.hpp>
@@ -89,6 +91,11 @@ struct nodes_save
 
     immer::map<const void*, node_id> node_ptr_to_id;
 
+    // When set, nodes with the same content share one id even when they are
+    // different objects in memory, see `content_dedup_t`.
+    persist::detail::content_hash_fn content_hash = nullptr;
+    immer::map<std::uint64_t, node_id> content_to_id;
+
     friend bool operator==(const nodes_save& left, const nodes_save& right)
     {
         return left.inners == right.inners;
@@ -196,6 +203,11 @@ struct container_input_pool
     {
         using cereal::load;
         load(ar, nodes);
+        for (auto i = std::size_t{}; i < nodes.size(); ++i) {
+            if (nodes[i].values.malformed) {
+                throw invalid_compressed_values{node_id{i}};
+            }
+        }
     }
 
     void merge_previous(const container_input_pool& other) {}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <immer/extra/persist/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace immer::persist::detail {
+
+/**
+ * Seeds used to hash the different kinds of nodes, so that a leaf and an
+ * inner node with the same serialized content don't collide.
+ */
+constexpr auto content_hash_leaf_seed  = std::uint64_t{0x6c656166};
+constexpr auto content_hash_inner_seed = std::uint64_t{0x696e6e72};
+
+template <class T, class = void>
+struct has_xx_hash_value : std::false_type
+{};
+
+template <class T>
+struct has_xx_hash_value<
+    T,
+    std::void_t<decltype(xx_hash_value(std::declval<const T&>()))>>
+    : std::true_type
+{};
+
+template <class T, class = void>
+struct has_std_hash : std::false_type
+{};
+
+template <class T>
+struct has_std_hash<
+    T,
+    std::void_t<decltype(std::hash<T>{}(std::declval<const T&>()))>>
+    : std::true_type
+{};
+
+template <class T, class = void>
+struct is_equality_comparable : std::false_type
+{};
+
+template <class T>
+struct is_equality_comparable<
+    T,
+    std::void_t<decltype(bool(std::declval<const T&>() ==
+                              std::declval<const T&>()))>> : std::true_type
+{};
+
+// The comparison of std::pair is not constrained on the comparison of its
+// members.
+template <class First, class Second>
+struct is_equality_comparable<std::pair<First, Second>>
+    : std::bool_constant<is_equality_comparable<First>::value &&
+                         is_equality_comparable<Second>::value>
+{};
+
+template <class T>
+struct is_content_hashable
+    : std::bool_constant<is_equality_comparable<T>::value &&
+                         (std::has_unique_object_representations_v<T> ||
+                          has_xx_hash_value<T>::value ||
+                          has_std_hash<T>::value)>
+{};
+
+template <>
+struct is_content_hashable<std::string> : std::true_type
+{};
+
+template <class First, class Second>
+struct is_content_hashable<std::pair<First, Second>>
+    : std::bool_constant<is_content_hashable<First>::value &&
+                         is_content_hashable<Second>::value>
+{};
+
+template <class T>
+constexpr bool is_content_hashable_v = is_content_hashable<T>::value;
+
+/**
+ * Function used to hash blocks of memory, `xx_hash_bytes` when the pools
+ * deduplicate the nodes by content.  It is stored in the pools, instead of
+ * being called directly, so that only the users of `content_dedup_t` need to
+ * link the `xxHash` implementation.
+ */
+using content_hash_fn = std::uint64_t (*)(const void*,
+                                          std::size_t,
+                                          std::uint64_t);
+
+/**
+ * Accumulates the hash of the contents of a node: its values, the ids of its
+ * children and any other flags that distinguish it.  The hash only needs to
+ * be stable within one save, nodes with the same hash are still compared for
+ * equality before being merged.
+ */
+class content_hasher
+{
+public:
+    content_hasher(content_hash_fn hash_bytes, std::uint64_t seed)
+        : hash_bytes_{hash_bytes}
+        , seed_{seed}
+    {
+    }
+
+    void add(std::uint64_t word) { words_.push_back(word); }
+
+    void add(node_id id) { add(static_cast<std::uint64_t>(id.value)); }
+
+    // The hash is taken by value, since the hash functions of some
+    // containers, like `immer::map::hash_key`, are not `const`.
+    template <class T, class Hash>
+    void add_values(const T* first, const T* last, Hash hash)
+    {
+        add(static_cast<std::uint64_t>(last - first));
+        for (; first != last; ++first) {
+            add(static_cast<std::uint64_t>(hash(*first)));
+        }
+    }
+
+    template <class T>
+    void add_values(const T* first, const T* last)
+    {
+        if constexpr (std::has_unique_object_representations_v<T>) {
+            const auto size = static_cast<std::size_t>(last - first);
+            add(size);
+            add(hash_bytes_(first, size * sizeof(T), seed_));
+        } else {
+            add_values(first, last, [this](const T& x) { return value(x); });
+        }
+    }
+
+    std::uint64_t finish() const
+    {
+        return hash_bytes_(
+            words_.data(), words_.size() * sizeof(std::uint64_t), seed_);
+    }
+
+private:
+    template <class T>
+    std::uint64_t value(const T& x) const
+    {
+        if constexpr (std::has_unique_object_representations_v<T>) {
+            return hash_bytes_(&x, sizeof(T), 0);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return hash_bytes_(x.data(), x.size(), 0);
+        } else if constexpr (has_xx_hash_value<T>::value) {
+            return xx_hash_value(x);
+        } else {
+            return std::hash<T>{}(x);
+        }
+    }
+
+    template <class First, class Second>
+    std::uint64_t value(const std::pair<First, Second>& x) const
+    {
+        const std::uint64_t hashes[] = {value(x.first), value(x.second)};
+        return hash_bytes_(hashes, sizeof(hashes), 0);
+    }
+
+    content_hash_fn hash_bytes_;
+    std::uint64_t seed_;
+    std::vector<std::uint64_t> words_;
+};
+
+} // namespace immer::persist::detail
@@ -1,17 +1,29 @@
 #pragma once
 
+#include <immer/extra/persist/detail/common/value_codec.hpp>
 #include <immer/extra/persist/types.hpp>
 
 #include <immer/array.hpp>
 #include <immer/map.hpp>
 
+#include <cereal/details/helpers.hpp>
+#include <cereal/external/base64.hpp>
 #include <cereal/types/utility.hpp>
 
+#include <boost/endian/conversion.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
 namespace immer::persist::detail {
 
 /**
  * This type is used in container-specific pools to refer to the actual data
- * from the leaf nodes. The values are serialized as a list.
+ * from the leaf nodes. The values are serialized as a list, or as a string
+ * when they are compressed.
  */
 template <class T>
 struct values_save
@@ -29,12 +41,16 @@ struct values_save
 
 /**
  * This type is used in container-specific pools to contain the actual data for
- * the leaf nodes. The values are deserialized from a list.
+ * the leaf nodes. The values are deserialized from a list, or from a string
+ * when they are compressed.
  */
 template <class T>
 struct values_load
 {
     immer::array<T> data;
+    // Set when the compressed values could not be decoded.  The pool owning
+    // the node reports it, since only the pool knows the id of the node.
+    bool malformed = false;
 
     values_load() = default;
 
@@ -54,26 +70,120 @@ struct values_load
     }
 };
 
+/**
+ * Whether the archive belongs to a policy that requested the values of the
+ * pools to be compressed with the codec from `value_codec.hpp`.
+ */
+template <class Archive, class = void>
+struct archive_compresses_values : std::false_type
+{};
+
+template <class Archive>
+struct archive_compresses_values<
+    Archive,
+    std::void_t<decltype(Archive::pool_name_fn::policy_t::compress_values)>>
+    : std::bool_constant<Archive::pool_name_fn::policy_t::compress_values>
+{};
+
+template <class Archive, class T>
+constexpr bool use_value_codec =
+    archive_compresses_values<Archive>::value && is_codec_value_v<T>;
+
+/**
+ * Buffers for compressing the values of the leaves.  Pools are saved and
+ * loaded one leaf at a time, so they are kept per thread and reused by all
+ * the leaves instead of being allocated for every one of them.
+ */
+template <class T>
+struct value_codec_buffers
+{
+    codec_buffers codec;
+    std::vector<std::uint64_t> words;
+    std::vector<T> values;
+    std::string blob;
+};
+
+template <class T>
+value_codec_buffers<T>& get_value_codec_buffers()
+{
+    thread_local auto buffers = value_codec_buffers<T>{};
+    return buffers;
+}
+
+/**
+ * The compressed words of a node are saved as a single base64 string, in
+ * little endian.  Saving them one by one would turn every word into a
+ * separate number of up to 20 digits in text archives like JSON.
+ */
+inline std::string encode_words(const std::vector<std::uint64_t>& words,
+                                std::string& bytes)
+{
+    bytes.resize(words.size() * sizeof(std::uint64_t));
+    for (auto i = std::size_t{}; i < words.size(); ++i) {
+        const auto word = boost::endian::native_to_little(words[i]);
+        std::memcpy(&bytes[i * sizeof(word)], &word, sizeof(word));
+    }
+    return cereal::base64::encode(
+        reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+}
+
+inline bool decode_words(const std::string& str,
+                         std::vector<std::uint64_t>& words)
+{
+    const auto bytes = cereal::base64::decode(str);
+    if (bytes.size() % sizeof(std::uint64_t)) {
+        return false;
+    }
+    words.resize(bytes.size() / sizeof(std::uint64_t));
+    for (auto i = std::size_t{}; i < words.size(); ++i) {
+        std::memcpy(&words[i], &bytes[i * sizeof(words[i])], sizeof(words[i]));
+        boost::endian::little_to_native_inplace(words[i]);
+    }
+    return true;
+}
+
 template <class Archive, class T>
 void save(Archive& ar, const values_save<T>& value)
 {
-    ar(cereal::make_size_tag(
-        static_cast<cereal::size_type>(value.end - value.begin)));
-    for (auto p = value.begin; p != value.end; ++p) {
-        ar(*p);
+    if constexpr (use_value_codec<Archive, T>) {
+        auto& buffers = get_value_codec_buffers<T>();
+        buffers.words.clear();
+        encode_values(value.begin, value.end, buffers.codec, buffers.words);
+        ar(encode_words(buffers.words, buffers.blob));
+    } else {
+        ar(cereal::make_size_tag(
+            static_cast<cereal::size_type>(value.end - value.begin)));
+        for (auto p = value.begin; p != value.end; ++p) {
+            ar(*p);
+        }
     }
 }
 
 template <class Archive, class T>
 void load(Archive& ar, values_load<T>& m)
 {
-    cereal::size_type size;
-    ar(cereal::make_size_tag(size));
-
-    for (auto i = cereal::size_type{}; i < size; ++i) {
-        T x;
-        ar(x);
-        m.data = std::move(m.data).push_back(std::move(x));
+    if constexpr (use_value_codec<Archive, T>) {
+        auto& buffers = get_value_codec_buffers<T>();
+        auto& words   = buffers.words;
+        auto& values  = buffers.values;
+        auto& blob    = buffers.blob;
+        ar(blob);
+        values.clear();
+        m.malformed = !decode_words(blob, words) ||
+                      !decode_values(words.data(),
+                                     words.data() + words.size(),
+                                     buffers.codec,
+                                     values);
+        m.data = m.malformed ? immer::array<T>{}
+                             : immer::array<T>(values.begin(), values.end());
+    } else {
+        cereal::size_type size;
+        ar(cereal::make_size_tag(size));
+        for (auto i = cereal::size_type{}; i < size; ++i) {
+            T x;
+            ar(x);
+            m.data = std::move(m.data).push_back(std::move(x));
+        }
     }
 }
 
@@ -0,0 +1,372 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Lossless codec for the values stored in the leaves of the pools, when they
+ * are of arithmetic types.
+ *
+ * Every value is mapped to an unsigned 64-bit *lane*: unsigned integers are
+ * kept as they are, signed integers are zig-zag encoded so that small negative
+ * numbers stay small, and floating point numbers use their bit pattern.  The
+ * lanes of one leaf are then encoded with whichever of these two schemes
+ * needs fewer bits:
+ *
+ *   - frame-of-reference: the minimum lane is stored once and the rest are
+ *     stored as offsets from it.
+ *   - delta: the first lane is stored once and the rest are stored as the
+ *     zig-zag encoded difference with the previous lane.
+ *
+ * The resulting residuals are bit-packed using the width of the biggest one.
+ * Constant columns take no packed words at all, up to `max_constant_count`
+ * values, so that decoding never produces more values than the input can
+ * account for.
+ * A leaf is encoded as a sequence of words:
+ *
+ *     count, { header, base, packed residuals... } per column
+ *
+ * Pairs of arithmetic types, as stored in maps, use one column for the first
+ * element and another for the second.  All the loops are simple enough to be
+ * vectorized by the compiler.
+ */
+
+namespace immer::persist::detail {
+
+template <class T>
+struct is_codec_lane_type
+    : std::bool_constant<std::is_arithmetic_v<T> &&
+                         (!std::is_floating_point_v<T> ||
+                          sizeof(T) == sizeof(std::uint32_t) ||
+                          sizeof(T) == sizeof(std::uint64_t))>
+{};
+
+/**
+ * Whether values of type `T` can be stored in pools using the codec.
+ */
+template <class T>
+struct is_codec_value : is_codec_lane_type<T>
+{};
+
+template <class First, class Second>
+struct is_codec_value<std::pair<First, Second>>
+    : std::bool_constant<is_codec_lane_type<First>::value &&
+                         is_codec_lane_type<Second>::value>
+{};
+
+template <class T>
+constexpr bool is_codec_value_v = is_codec_value<T>::value;
+
+/**
+ * Buffers used by `encode_values` and `decode_values`.  Reusing them for
+ * every leaf means that they only allocate when a leaf is bigger than the
+ * ones before.
+ */
+struct codec_buffers
+{
+    std::vector<std::uint64_t> lanes;
+    std::vector<std::uint64_t> scratch;
+};
+
+namespace codec {
+
+enum class mode : std::uint64_t
+{
+    frame_of_reference = 0,
+    delta              = 1,
+};
+
+/**
+ * Maximum number of values in a column packed with zero bits.  Longer
+ * constant columns are packed with one bit per value instead.
+ */
+constexpr auto max_constant_count = std::size_t{1} << 10;
+
+inline std::uint64_t zigzag(std::uint64_t x)
+{
+    return (x << 1) ^ (0 - (x >> 63));
+}
+
+inline std::uint64_t unzigzag(std::uint64_t x)
+{
+    return (x >> 1) ^ (0 - (x & 1));
+}
+
+inline unsigned bit_width(std::uint64_t x)
+{
+    auto r = 0u;
+    for (; x; x >>= 1)
+        ++r;
+    return r;
+}
+
+template <class T>
+std::uint64_t to_lane(T x)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        using bits_t = std::conditional_t<sizeof(T) == sizeof(std::uint32_t),
+                                          std::uint32_t,
+                                          std::uint64_t>;
+        auto bits    = bits_t{};
+        std::memcpy(&bits, &x, sizeof(T));
+        return bits;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return x;
+    } else if constexpr (std::is_signed_v<T>) {
+        return zigzag(static_cast<std::uint64_t>(static_cast<std::int64_t>(x)));
+    } else {
+        return x;
+    }
+}
+
+template <class T>
+T from_lane(std::uint64_t x)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        using bits_t = std::conditional_t<sizeof(T) == sizeof(std::uint32_t),
+                                          std::uint32_t,
+                                          std::uint64_t>;
+        auto bits    = static_cast<bits_t>(x);
+        auto r       = T{};
+        std::memcpy(&r, &bits, sizeof(T));
+        return r;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return x != 0;
+    } else if constexpr (std::is_signed_v<T>) {
+        return static_cast<T>(static_cast<std::int64_t>(unzigzag(x)));
+    } else {
+        return static_cast<T>(x);
+    }
+}
+
+inline void pack(const std::uint64_t* in,
+                 std::size_t n,
+                 unsigned bits,
+                 std::vector<std::uint64_t>& out)
+{
+    if (!bits)
+        return;
+    const auto first = out.size();
+    out.resize(first + (n * bits + 63) / 64, 0);
+    auto* words = out.data() + first;
+    for (auto i = std::size_t{}; i < n; ++i) {
+        const auto bit   = i * bits;
+        const auto word  = bit / 64;
+        const auto shift = bit % 64;
+        words[word] |= in[i] << shift;
+        if (shift + bits > 64)
+            words[word + 1] |= in[i] >> (64 - shift);
+    }
+}
+
+inline void unpack(const std::uint64_t* words,
+                   std::size_t n,
+                   unsigned bits,
+                   std::uint64_t* out)
+{
+    if (!bits) {
+        for (auto i = std::size_t{}; i < n; ++i)
+            out[i] = 0;
+        return;
+    }
+    const auto mask =
+        bits == 64 ? ~std::uint64_t{} : (std::uint64_t{1} << bits) - 1;
+    for (auto i = std::size_t{}; i < n; ++i) {
+        const auto bit   = i * bits;
+        const auto word  = bit / 64;
+        const auto shift = bit % 64;
+        auto v           = words[word] >> shift;
+        if (shift + bits > 64)
+            v |= words[word + 1] << (64 - shift);
+        out[i] = v & mask;
+    }
+}
+
+inline std::size_t packed_words(std::size_t n, unsigned bits)
+{
+    const auto total = n * bits;
+    return total / 64 + (total % 64 != 0);
+}
+
+/**
+ * Whether a column of `n` lanes packing `count` residuals with `bits <= 64`
+ * each can be read from `words` words.
+ */
+inline bool column_fits(std::size_t n,
+                        std::size_t count,
+                        unsigned bits,
+                        std::size_t words)
+{
+    if (!bits)
+        return n <= max_constant_count;
+    return count <= std::numeric_limits<std::size_t>::max() / bits &&
+           packed_words(count, bits) <= words;
+}
+
+/**
+ * Encodes a column of lanes, appending the header, the base and the packed
+ * residuals to `out`.  The residuals are computed into `scratch`.
+ */
+inline void encode_column(const std::vector<std::uint64_t>& lanes,
+                          std::vector<std::uint64_t>& scratch,
+                          std::vector<std::uint64_t>& out)
+{
+    const auto n = lanes.size();
+    if (!n)
+        return;
+
+    auto min   = lanes[0];
+    auto max   = lanes[0];
+    auto delta = std::uint64_t{};
+    for (auto i = std::size_t{1}; i < n; ++i) {
+        min   = lanes[i] < min ? lanes[i] : min;
+        max   = lanes[i] > max ? lanes[i] : max;
+        delta = delta | zigzag(lanes[i] - lanes[i - 1]);
+    }
+
+    const auto min_bits   = n > max_constant_count ? 1u : 0u;
+    const auto for_bits   = std::max(bit_width(max - min), min_bits);
+    const auto delta_bits = std::max(bit_width(delta), min_bits);
+    scratch.resize(n);
+    if (packed_words(n - 1, delta_bits) < packed_words(n, for_bits)) {
+        for (auto i = std::size_t{1}; i < n; ++i)
+            scratch[i - 1] = zigzag(lanes[i] - lanes[i - 1]);
+        out.push_back(static_cast<std::uint64_t>(mode::delta) |
+                      (std::uint64_t{delta_bits} << 1));
+        out.push_back(lanes[0]);
+        pack(scratch.data(), n - 1, delta_bits, out);
+    } else {
+        for (auto i = std::size_t{}; i < n; ++i)
+            scratch[i] = lanes[i] - min;
+        out.push_back(static_cast<std::uint64_t>(mode::frame_of_reference) |
+                      (std::uint64_t{for_bits} << 1));
+        out.push_back(min);
+        pack(scratch.data(), n, for_bits, out);
+    }
+}
+
+/**
+ * Decodes a column of `n` lanes into `lanes`.  Returns a pointer past the
+ * consumed words, or `nullptr` if the input is malformed.  The column is
+ * validated before `lanes` is resized, so that a corrupt count can not make
+ * it allocate more than what the input can encode.
+ */
+inline const std::uint64_t* decode_column(const std::uint64_t* first,
+                                          const std::uint64_t* last,
+                                          std::size_t n,
+                                          std::vector<std::uint64_t>& lanes)
+{
+    if (!n) {
+        lanes.clear();
+        return first;
+    }
+    if (last - first < 2)
+        return nullptr;
+
+    const auto header = first[0];
+    const auto base   = first[1];
+    const auto bits   = header >> 1;
+    const auto delta  = (header & 1) == static_cast<std::uint64_t>(mode::delta);
+    const auto count  = delta ? n - 1 : n;
+    first += 2;
+    if (bits > 64 ||
+        !column_fits(n,
+                     count,
+                     static_cast<unsigned>(bits),
+                     static_cast<std::size_t>(last - first)))
+        return nullptr;
+
+    lanes.resize(n);
+
+    if (delta) {
+        unpack(first, count, static_cast<unsigned>(bits), lanes.data() + 1);
+        lanes[0] = base;
+        for (auto i = std::size_t{1}; i < n; ++i)
+            lanes[i] = lanes[i - 1] + unzigzag(lanes[i]);
+    } else {
+        unpack(first, count, static_cast<unsigned>(bits), lanes.data());
+        for (auto i = std::size_t{}; i < n; ++i)
+            lanes[i] += base;
+    }
+    return first + packed_words(count, static_cast<unsigned>(bits));
+}
+
+} // namespace codec
+
+/**
+ * Encodes the values in `[first, last)` into `out`.
+ */
+template <class T>
+void encode_values(const T* first,
+                   const T* last,
+                   codec_buffers& buffers,
+                   std::vector<std::uint64_t>& out)
+{
+    const auto n = static_cast<std::size_t>(last - first);
+    out.push_back(n);
+
+    auto& lanes   = buffers.lanes;
+    auto& scratch = buffers.scratch;
+    lanes.resize(n);
+    if constexpr (std::is_arithmetic_v<T>) {
+        for (auto i = std::size_t{}; i < n; ++i)
+            lanes[i] = codec::to_lane(first[i]);
+        codec::encode_column(lanes, scratch, out);
+    } else {
+        for (auto i = std::size_t{}; i < n; ++i)
+            lanes[i] = codec::to_lane(first[i].first);
+        codec::encode_column(lanes, scratch, out);
+        for (auto i = std::size_t{}; i < n; ++i)
+            lanes[i] = codec::to_lane(first[i].second);
+        codec::encode_column(lanes, scratch, out);
+    }
+}
+
+/**
+ * Decodes the values encoded by `encode_values` from the words in `[first,
+ * last)`, appending them to `out`.  Returns whether the input was valid and
+ * fully consumed.
+ */
+template <class T>
+bool decode_values(const std::uint64_t* first,
+                   const std::uint64_t* last,
+                   codec_buffers& buffers,
+                   std::vector<T>& out)
+{
+    if (first == last)
+        return false;
+    const auto n = static_cast<std::size_t>(*first++);
+
+    auto& lanes = buffers.lanes;
+    if constexpr (std::is_arithmetic_v<T>) {
+        first = codec::decode_column(first, last, n, lanes);
+        if (!first)
+            return false;
+        out.reserve(out.size() + n);
+        for (auto i = std::size_t{}; i < n; ++i)
+            out.push_back(codec::from_lane<T>(lanes[i]));
+    } else {
+        using first_t  = typename T::first_type;
+        using second_t = typename T::second_type;
+        auto& seconds  = buffers.scratch;
+        first          = codec::decode_column(first, last, n, lanes);
+        if (!first)
+            return false;
+        first = codec::decode_column(first, last, n, seconds);
+        if (!first)
+            return false;
+        out.reserve(out.size() + n);
+        for (auto i = std::size_t{}; i < n; ++i)
+            out.emplace_back(codec::from_lane<first_t>(lanes[i]),
+                             codec::from_lane<second_t>(seconds[i]));
+    }
+    return first == last;
+}
+
+} // namespace immer::persist::detail
@@ -4,12 +4,16 @@
 #include <immer/extra/persist/detail/rbts/pool.hpp>
 #include <immer/extra/persist/detail/rbts/traverse.hpp>
 #include <immer/extra/persist/errors.hpp>
+#include <immer/extra/persist/parallel.hpp>
 
 #include <boost/hana.hpp>
 #include <boost/range/adaptor/indexed.hpp>
 #include <immer/set.hpp>
 #include <immer/vector.hpp>
+
+#include <algorithm>
 #include <optional>
+#include <vector>
 
 namespace immer::persist::rbts {
 
@@ -176,7 +180,48 @@ public:
         return impl;
     }
 
+    /**
+     * Applies the transformation to the values of all the leaves of the pool
+     * using multiple threads.  The leaves are then built from the precomputed
+     * values when the containers are loaded.
+     */
+    void precompute_transform(const parallel_options& options)
+    {
+        if constexpr (!std::is_same_v<TransformF, boost::hana::id_t>) {
+            using values_t =
+                typename std::decay_t<decltype(pool_.leaves)>::mapped_type;
+            auto leaves = std::vector<std::pair<node_id, const values_t*>>{};
+            auto size   = transformed_leaves_.size();
+            for (const auto& [id, info] : pool_.leaves) {
+                const auto done = id.value < transformed_leaves_.size() &&
+                                  transformed_leaves_[id.value];
+                if (!done && !leaves_.count(id)) {
+                    leaves.emplace_back(id, &info);
+                    size = std::max(size, id.value + 1);
+                }
+            }
+            transformed_leaves_.resize(size);
+            persist::detail::parallel_for(
+                leaves.size(), options, [&](std::size_t i) {
+                    const auto& [id, info] = leaves[i];
+                    transformed_leaves_[id.value] =
+                        transform_values(info->data);
+                });
+        }
+    }
+
 private:
+    template <class Values>
+    immer::array<T> transform_values(const Values& values) const
+    {
+        auto result = std::vector<T>{};
+        result.reserve(values.size());
+        for (const auto& item : values) {
+            result.push_back(transform_(item));
+        }
+        return immer::array<T>{result.begin(), result.end()};
+    }
+
     node_ptr load_leaf(node_id id)
     {
         if (auto* p = leaves_.find(id)) {
@@ -205,10 +250,16 @@ private:
             loaded_leaves_ = std::move(loaded_leaves_).set(leaf.get(), id);
             return leaf;
         } else {
-            auto values = std::vector<T>{};
-            for (const auto& item : node_info->data) {
-                values.push_back(transform_(item));
-            }
+            const auto values = [&] {
+                if (id.value < transformed_leaves_.size()) {
+                    if (auto& p = transformed_leaves_[id.value]) {
+                        auto result = std::move(*p);
+                        p.reset();
+                        return result;
+                    }
+                }
+                return transform_values(node_info->data);
+            }();
             auto leaf =
                 node_ptr{n ? node_t::make_leaf_n(n) : rbtree::empty_tail(),
                          [n](auto* ptr) { node_t::delete_leaf(ptr, n); }};
@@ -521,6 +572,9 @@ private:
     immer::map<node_t*, node_id> loaded_inners_;
     immer::map<node_id, std::size_t> sizes_;
     immer::map<node_id, immer::detail::rbts::count_t> depths_;
+    // Leaves computed by `precompute_transform()`, indexed by node id.  Each
+    // one is released once the leaf is loaded.
+    std::vector<std::optional<immer::array<T>>> transformed_leaves_;
 };
 
 template <typename T,
@@ -544,6 +598,11 @@ public:
 
     auto load(container_id id) { return loader.load_vector(id); }
 
+    void precompute_transform(const parallel_options& options)
+    {
+        loader.precompute_transform(options);
+    }
+
 private:
     loader<T, MemoryPolicy, B, BL, Pool, TransformF> loader;
 };
@@ -580,6 +639,11 @@ public:
 
     auto load(container_id id) { return loader.load_flex_vector(id); }
 
+    void precompute_transform(const parallel_options& options)
+    {
+        loader.precompute_transform(options);
+    }
+
 private:
     loader<T, MemoryPolicy, B, BL, Pool, TransformF> loader;
 };
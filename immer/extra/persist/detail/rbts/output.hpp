@@ -2,6 +2,9 @@
 
 #include <immer/extra/persist/detail/rbts/traverse.hpp>
 
+#include <algorithm>
+#include <optional>
+
 namespace immer::persist::rbts {
 
 namespace detail {
@@ -103,6 +106,140 @@ struct pool_builder
     }
 };
 
+/**
+ * Builds the pool identifying the nodes by their content instead of by their
+ * address.  The nodes are saved after their children, so that an inner node
+ * can be hashed from the ids of its children, and equal subtrees collapse into
+ * a single entry of the pool.
+ */
+template <typename T,
+          typename MemoryPolicy,
+          immer::detail::rbts::bits_t B,
+          immer::detail::rbts::bits_t BL>
+struct content_pool_builder
+{
+    output_pool<T, MemoryPolicy, B, BL> pool;
+
+    template <class Pos, class VisitF>
+    void operator()(regular_pos_tag, Pos& pos, VisitF&& visit)
+    {
+        save_inner(pos, visit, false);
+    }
+
+    template <class Pos, class VisitF>
+    void operator()(relaxed_pos_tag, Pos& pos, VisitF&& visit)
+    {
+        save_inner(pos, visit, true);
+    }
+
+    template <class Pos, class VisitF>
+    void operator()(leaf_pos_tag, Pos& pos, VisitF&& visit)
+    {
+        auto* ptr = static_cast<const void*>(pos.node());
+        if (pool.node_ptr_to_id.count(ptr)) {
+            return;
+        }
+
+        T* first  = pos.node()->leaf();
+        auto info = persist::detail::values_save<T>{
+            .begin = first,
+            .end   = first + pos.count(),
+        };
+
+        const auto id = next_id();
+        if constexpr (persist::detail::is_content_hashable_v<T>) {
+            auto hasher = persist::detail::content_hasher{
+                pool.content_hash, persist::detail::content_hash_leaf_seed};
+            hasher.add_values(info.begin, info.end);
+            const auto hash  = hasher.finish();
+            const auto other = find_by_hash(hash, pool.leaves);
+            if (other && std::equal(info.begin,
+                                    info.end,
+                                    other->second.begin,
+                                    other->second.end)) {
+                pool.node_ptr_to_id =
+                    std::move(pool.node_ptr_to_id).set(ptr, other->first);
+                return;
+            }
+            remember_hash(hash, id);
+        }
+
+        pool.leaves         = std::move(pool.leaves).set(id, std::move(info));
+        pool.node_ptr_to_id = std::move(pool.node_ptr_to_id).set(ptr, id);
+    }
+
+    template <class Pos, class VisitF>
+    void save_inner(Pos& pos, VisitF& visit, bool relaxed)
+    {
+        auto* ptr = static_cast<const void*>(pos.node());
+        if (pool.node_ptr_to_id.count(ptr)) {
+            return;
+        }
+
+        auto node_info = inner_node{
+            .relaxed = relaxed,
+        };
+        pos.each(visitor_helper{}, [&](auto any_tag, auto& child_pos, auto&&) {
+            visit(child_pos);
+            auto* child_id = pool.node_ptr_to_id.find(
+                static_cast<const void*>(child_pos.node()));
+            assert(child_id);
+            node_info.children =
+                std::move(node_info.children).push_back(*child_id);
+        });
+
+        auto hasher = persist::detail::content_hasher{
+            pool.content_hash, persist::detail::content_hash_inner_seed};
+        hasher.add(std::uint64_t{relaxed});
+        for (const auto& child : node_info.children) {
+            hasher.add(child);
+        }
+        const auto hash  = hasher.finish();
+        const auto other = find_by_hash(hash, pool.inners);
+        if (other && other->second == node_info) {
+            pool.node_ptr_to_id =
+                std::move(pool.node_ptr_to_id).set(ptr, other->first);
+            return;
+        }
+
+        const auto id = next_id();
+        remember_hash(hash, id);
+
+        pool.inners = std::move(pool.inners).set(id, std::move(node_info));
+        pool.node_ptr_to_id = std::move(pool.node_ptr_to_id).set(ptr, id);
+    }
+
+    // Ids are only assigned to the nodes that are actually stored, so they
+    // stay consecutive.
+    node_id next_id() const
+    {
+        return node_id{pool.leaves.size() + pool.inners.size()};
+    }
+
+    // Nodes that collide with an already known hash are stored without
+    // deduplication.
+    void remember_hash(std::uint64_t hash, node_id id)
+    {
+        if (!pool.content_to_id.count(hash)) {
+            pool.content_to_id = std::move(pool.content_to_id).set(hash, id);
+        }
+    }
+
+    // Returns the node of the given kind that was first saved with this hash,
+    // if any.
+    template <class Nodes>
+    auto find_by_hash(std::uint64_t hash, const Nodes& nodes) const
+        -> std::optional<std::pair<node_id, typename Nodes::mapped_type>>
+    {
+        if (auto* id = pool.content_to_id.find(hash)) {
+            if (auto* node = nodes.find(*id)) {
+                return std::make_pair(*id, *node);
+            }
+        }
+        return std::nullopt;
+    }
+};
+
 template <typename T,
           typename MemoryPolicy,
           immer::detail::rbts::bits_t B,
@@ -133,6 +270,21 @@ auto save_nodes(
     return std::move(save.pool);
 }
 
+template <typename T,
+          typename MemoryPolicy,
+          immer::detail::rbts::bits_t B,
+          immer::detail::rbts::bits_t BL,
+          class Tree>
+auto save_nodes_by_content(const Tree& tree,
+                           output_pool<T, MemoryPolicy, B, BL> pool)
+{
+    auto save = content_pool_builder<T, MemoryPolicy, B, BL>{
+        .pool = std::move(pool),
+    };
+    tree.traverse(visitor_helper{}, save);
+    return std::move(save.pool);
+}
+
 } // namespace detail
 
 template <typename T,
@@ -143,7 +295,17 @@ std::pair<output_pool<T, MemoryPolicy, B, BL>, container_id>
 add_to_pool(immer::vector<T, MemoryPolicy, B, BL> vec,
             output_pool<T, MemoryPolicy, B, BL> pool)
 {
-    const auto& impl        = vec.impl();
+    const auto& impl = vec.impl();
+    if (pool.content_hash && !(pool.node_ptr_to_id.count(impl.root) &&
+                                pool.node_ptr_to_id.count(impl.tail))) {
+        // The ids of the nodes depend on their content, so they are known
+        // only once the nodes have been saved.  The vector is kept alive even
+        // when all its nodes were already in the pool, since their addresses
+        // are remembered.
+        pool = detail::save_nodes_by_content(impl, std::move(pool));
+        pool.saved_vectors = std::move(pool.saved_vectors).push_back(vec);
+    }
+
     auto root_id            = node_id{};
     auto tail_id            = node_id{};
     std::tie(pool, root_id) = detail::get_node_id(std::move(pool), impl.root);
@@ -159,7 +321,9 @@ add_to_pool(immer::vector<T, MemoryPolicy, B, BL> vec,
         return {std::move(pool), vector_id};
     }
 
-    pool = detail::save_nodes(impl, std::move(pool));
+    if (!pool.content_hash) {
+        pool = detail::save_nodes(impl, std::move(pool));
+    }
 
     assert(pool.inners.count(root_id));
     assert(pool.leaves.count(tail_id));
@@ -168,8 +332,10 @@ add_to_pool(immer::vector<T, MemoryPolicy, B, BL> vec,
 
     pool.rbts_to_id = std::move(pool.rbts_to_id).set(tree_id, vector_id);
     pool.vectors    = std::move(pool.vectors).push_back(tree_id);
-    pool.saved_vectors =
-        std::move(pool.saved_vectors).push_back(std::move(vec));
+    if (!pool.content_hash) {
+        pool.saved_vectors =
+            std::move(pool.saved_vectors).push_back(std::move(vec));
+    }
 
     return {std::move(pool), vector_id};
 }
@@ -182,7 +348,18 @@ std::pair<output_pool<T, MemoryPolicy, B, BL>, container_id>
 add_to_pool(immer::flex_vector<T, MemoryPolicy, B, BL> vec,
             output_pool<T, MemoryPolicy, B, BL> pool)
 {
-    const auto& impl        = vec.impl();
+    const auto& impl = vec.impl();
+    if (pool.content_hash && !(pool.node_ptr_to_id.count(impl.root) &&
+                                pool.node_ptr_to_id.count(impl.tail))) {
+        // The ids of the nodes depend on their content, so they are known
+        // only once the nodes have been saved.  The vector is kept alive even
+        // when all its nodes were already in the pool, since their addresses
+        // are remembered.
+        pool = detail::save_nodes_by_content(impl, std::move(pool));
+        pool.saved_flex_vectors =
+            std::move(pool.saved_flex_vectors).push_back(vec);
+    }
+
     auto root_id            = node_id{};
     auto tail_id            = node_id{};
     std::tie(pool, root_id) = detail::get_node_id(std::move(pool), impl.root);
@@ -198,7 +375,9 @@ add_to_pool(immer::flex_vector<T, MemoryPolicy, B, BL> vec,
         return {std::move(pool), vector_id};
     }
 
-    pool = detail::save_nodes(impl, std::move(pool));
+    if (!pool.content_hash) {
+        pool = detail::save_nodes(impl, std::move(pool));
+    }
 
     assert(pool.inners.count(root_id));
     assert(pool.leaves.count(tail_id));
@@ -207,8 +386,10 @@ add_to_pool(immer::flex_vector<T, MemoryPolicy, B, BL> vec,
 
     pool.rbts_to_id = std::move(pool.rbts_to_id).set(tree_id, vector_id);
     pool.vectors    = std::move(pool.vectors).push_back(tree_id);
-    pool.saved_flex_vectors =
-        std::move(pool.saved_flex_vectors).push_back(std::move(vec));
+    if (!pool.content_hash) {
+        pool.saved_flex_vectors =
+            std::move(pool.saved_flex_vectors).push_back(std::move(vec));
+    }
 
     return {std::move(pool), vector_id};
 }
@@ -4,7 +4,9 @@
 #include <immer/extra/cereal/immer_vector.hpp>
 #include <immer/extra/persist/detail/alias.hpp>
 #include <immer/extra/persist/detail/cereal/compact_map.hpp>
+#include <immer/extra/persist/detail/common/content_hash.hpp>
 #include <immer/extra/persist/detail/common/pool.hpp>
+#include <immer/extra/persist/errors.hpp>
 
 #include <immer/array.hpp>
 #include <immer/flex_vector.hpp>
@@ -88,6 +90,11 @@ struct output_pool
     immer::map<rbts_info, container_id> rbts_to_id;
     immer::map<const void*, node_id> node_ptr_to_id;
 
+    // When set, nodes with the same content share one id even when they are
+    // different objects in memory, see `content_dedup_t`.
+    persist::detail::content_hash_fn content_hash = nullptr;
+    immer::map<std::uint64_t, node_id> content_to_id;
+
     // Saving the persisted vectors, so that no mutations are allowed to happen.
     immer::vector<immer::vector<T, MemoryPolicy, B, BL>> saved_vectors;
     immer::vector<immer::flex_vector<T, MemoryPolicy, B, BL>>
@@ -166,6 +173,11 @@ struct input_pool
            cereal::make_nvp("leaves", detail::make_compact_map(leaves)),
            cereal::make_nvp("inners", detail::make_compact_map(inners)),
            CEREAL_NVP(vectors));
+        for (const auto& [id, leaf] : leaves) {
+            if (leaf.malformed) {
+                throw invalid_compressed_values{id};
+            }
+        }
     }
 
     void merge_previous(const input_pool& other) {}
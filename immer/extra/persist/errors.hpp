@@ -3,6 +3,7 @@
 #include <immer/extra/persist/detail/common/pool.hpp>
 
 #include <stdexcept>
+#include <string>
 
 #include <fmt/format.h>
 
@@ -80,6 +81,34 @@ public:
     }
 };
 
+/**
+ * Thrown when the compressed values of a node can not be decoded.
+ *
+ * @ingroup persist-exceptions
+ */
+class invalid_compressed_values : public pool_exception
+{
+public:
+    explicit invalid_compressed_values(node_id id,
+                                       const std::string& pool_name = {})
+        : pool_exception{pool_name.empty()
+                             ? fmt::format(
+                                   "Node ID {} has malformed compressed values",
+                                   id)
+                             : fmt::format("Node ID {} in pool {} has "
+                                           "malformed compressed values",
+                                           id,
+                                           pool_name)}
+        , id_{id}
+    {
+    }
+
+    node_id id() const { return id_; }
+
+private:
+    node_id id_;
+};
+
 /**
  * Thrown when duplicate pool name is detected.
  *
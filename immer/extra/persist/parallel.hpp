@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace immer::persist {
+
+/**
+ * @brief Controls how the values of the pools are converted by
+ * `transform_output_pool` when a parallel conversion is requested.
+ *
+ * The values of every node of a pool are independent from each other, so they
+ * are converted in batches of `grain` nodes by `threads` worker threads.  The
+ * converting functions must be safe to call concurrently.
+ *
+ * @ingroup persist-transform
+ */
+struct parallel_options
+{
+    unsigned threads  = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t grain = 64;
+};
+
+namespace detail {
+
+/**
+ * Calls `fn(i)` for every `i` in `[0, count)` using the worker threads
+ * described by `options`.  The first exception thrown by `fn` stops the
+ * remaining work and is rethrown to the caller.
+ */
+template <class Fn>
+void parallel_for(std::size_t count, const parallel_options& options, Fn&& fn)
+{
+    const auto grain   = std::max(std::size_t{1}, options.grain);
+    const auto batches = (count + grain - 1) / grain;
+    const auto threads =
+        std::min<std::size_t>(std::max(1u, options.threads), batches);
+    if (threads <= 1) {
+        for (auto i = std::size_t{}; i < count; ++i)
+            fn(i);
+        return;
+    }
+
+    auto next  = std::atomic<std::size_t>{0};
+    auto stop  = std::atomic<bool>{false};
+    auto error = std::exception_ptr{};
+    auto mutex = std::mutex{};
+    auto work  = [&] {
+        try {
+            while (!stop.load(std::memory_order_relaxed)) {
+                const auto first = next.fetch_add(grain);
+                if (first >= count)
+                    break;
+                const auto last = std::min(count, first + grain);
+                for (auto i = first; i < last; ++i)
+                    fn(i);
+            }
+        } catch (...) {
+            auto lock = std::lock_guard<std::mutex>{mutex};
+            if (!error)
+                error = std::current_exception();
+            stop = true;
+        }
+    };
+
+    auto workers = std::vector<std::thread>{};
+    workers.reserve(threads - 1);
+    for (auto i = std::size_t{1}; i < threads; ++i)
+        workers.emplace_back(work);
+    work();
+    for (auto& worker : workers)
+        worker.join();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace detail
+
+} // namespace immer::persist
@@ -2,6 +2,7 @@
 
 #include <immer/extra/persist/cereal/policy.hpp>
 #include <immer/extra/persist/detail/transform.hpp>
+#include <immer/extra/persist/parallel.hpp>
 
 namespace immer::persist {
 
@@ -20,7 +21,7 @@ template <typename T, class Policy = hana_struct_auto_policy>
 auto get_output_pools(const T& value0, const Policy& policy = Policy{})
 {
     const auto types = boost::hana::to_set(policy.get_pool_types(value0));
-    auto pools       = detail::generate_output_pools(types);
+    auto pools       = detail::generate_output_pools(types, policy);
     const auto wrap  = detail::wrap_known_types(types, detail::wrap_for_saving);
     using Pools      = std::decay_t<decltype(pools)>;
 
@@ -65,6 +66,31 @@ transform_output_pool(const detail::output_pools<Storage>& old_pools,
     return old_load_pools.transform_recursive(conversion_map, get_id);
 }
 
+/**
+ * Like `transform_output_pool`, but eagerly applies the transformations using
+ * multiple threads, as described by `options`.
+ *
+ * The nodes of every pool are converted in parallel before any container is
+ * loaded, so `convert_container` only has to assemble the already converted
+ * nodes, preserving the structural sharing between them.  The transforming
+ * functions must be safe to call concurrently.  Functions that take the
+ * second `convert_container` argument can not be evaluated in parallel and
+ * are still applied lazily.
+ *
+ * @ingroup persist-transform
+ * @see transform_output_pool
+ */
+template <class Storage, class ConversionMap>
+inline auto
+transform_output_pool(const detail::output_pools<Storage>& old_pools,
+                      const ConversionMap& conversion_map,
+                      const parallel_options& options)
+{
+    auto new_pools = transform_output_pool(old_pools, conversion_map);
+    new_pools.precompute_transform(conversion_map, options);
+    return new_pools;
+}
+
 /**
  * Given output_pools and new (transformed) input_pools, effectively
  * convert the given container.
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace immer::persist {
@@ -19,6 +21,13 @@ struct xx_hash
 
 std::uint64_t xx_hash_value_string(const std::string& str);
 
+/**
+ * Hashes a block of memory, used to compute the content hash of the nodes
+ * when deduplicating them by content.
+ */
+std::uint64_t
+xx_hash_bytes(const void* data, std::size_t size, std::uint64_t seed);
+
 template <>
 struct xx_hash<std::string>
 {
@@ -9,4 +9,10 @@ std::uint64_t xx_hash_value_string(const std::string& str)
     return XXH3_64bits(str.c_str(), str.size());
 }
 
+std::uint64_t
+xx_hash_bytes(const void* data, std::size_t size, std::uint64_t seed)
+{
+    return XXH3_64bits_withSeed(data, size, seed);
+}
+
 } // namespace immer::persist
@@ -82,6 +82,7 @@ public:
     using reverse_iterator = std::reverse_iterator<iterator>;
 
     using transient_type = flex_vector_transient<T, MemoryPolicy, B, BL>;
+    using debug_stats_t  = detail::rbts::fill_stats;
 
     /*!
      * Returns the maximum theoretical size supported by the internal structure
@@ -500,6 +501,28 @@ public:
         }
     }
 
+    /*!
+     * Returns a flex_vector with the same elements, stored in a dense tree
+     * without relaxed nodes, like the ones built by `push_back`.  Full leaves
+     * that are aligned in the new tree are shared with the original.
+     * Concatenation, insertion and erasure leave underfull leaves and relaxed
+     * nodes behind that make access slower, `get_debug_stats()` can be used
+     * to decide when compacting pays off.  Its complexity is @f$ O(size)
+     * @f$, or @f$ O(1) @f$ when the tree has no relaxed nodes.
+     */
+    IMMER_NODISCARD flex_vector compact() const { return impl_.compact(); }
+
+    /*!
+     * Returns statistics about the shape of the tree: its depth, the number
+     * of nodes of every kind, how full they are at every level, the bytes
+     * taken by the size tables of relaxed nodes and how full the tail is.
+     * Its complexity is @f$ O(size) @f$.
+     */
+    IMMER_NODISCARD debug_stats_t get_debug_stats() const
+    {
+        return impl_.get_fill_stats();
+    }
+
     /*!
      * Returns an @a transient form of this container, an
      * `immer::flex_vector_transient`.
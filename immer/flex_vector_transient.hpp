@@ -63,6 +63,7 @@ public:
     using reverse_iterator = std::reverse_iterator<iterator>;
 
     using persistent_type = flex_vector<T, MemoryPolicy, B, BL>;
+    using debug_stats_t   = detail::rbts::fill_stats;
 
     /*!
      * Default constructor.  It creates a flex_vector of `size() == 0`.  It
@@ -225,6 +226,22 @@ public:
         concat_mut_lr_r(l.impl_, l, impl_, *this);
     }
 
+    /*!
+     * Rebuilds the tree into a dense shape without relaxed nodes.  See
+     * `flex_vector::compact()`.  Its complexity is @f$ O(size) @f$, or @f$
+     * O(1) @f$ when the tree has no relaxed nodes.
+     */
+    void compact() { impl_.compact_mut(*this); }
+
+    /*!
+     * Returns statistics about the shape of the tree.  See
+     * `flex_vector::get_debug_stats()`.
+     */
+    IMMER_NODISCARD debug_stats_t get_debug_stats() const
+    {
+        return impl_.get_fill_stats();
+    }
+
     /*!
      * Returns an @a immutable form of this container, an
      * `immer::flex_vector`.
@@ -0,0 +1,125 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace immer {
+
+/*!
+ * Snapshot of the counters kept by every `counting_heap`.
+ */
+struct heap_stats
+{
+    //! Number of calls to `allocate` so far.
+    std::size_t allocations = 0;
+    //! Number of calls to `deallocate` so far.
+    std::size_t deallocations = 0;
+    //! Total bytes requested from `allocate` so far.
+    std::size_t allocated_bytes = 0;
+    //! Bytes currently allocated and not yet deallocated.
+    std::size_t live_bytes = 0;
+    //! Maximum of `live_bytes` since the last `reset_heap_peak()`.
+    std::size_t peak_live_bytes = 0;
+};
+
+namespace detail {
+
+struct heap_counters
+{
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> deallocations{0};
+    std::atomic<std::size_t> allocated_bytes{0};
+    std::atomic<std::size_t> live_bytes{0};
+    std::atomic<std::size_t> peak_live_bytes{0};
+};
+
+inline heap_counters& global_heap_counters()
+{
+    static heap_counters counters;
+    return counters;
+}
+
+} // namespace detail
+
+/*!
+ * Returns the current values of the counters shared by all the
+ * `counting_heap` instantiations in the program.
+ */
+inline heap_stats get_heap_stats()
+{
+    auto& c = detail::global_heap_counters();
+    auto r  = heap_stats{};
+    r.allocations     = c.allocations.load(std::memory_order_relaxed);
+    r.deallocations   = c.deallocations.load(std::memory_order_relaxed);
+    r.allocated_bytes = c.allocated_bytes.load(std::memory_order_relaxed);
+    r.live_bytes      = c.live_bytes.load(std::memory_order_relaxed);
+    r.peak_live_bytes = c.peak_live_bytes.load(std::memory_order_relaxed);
+    return r;
+}
+
+/*!
+ * Sets the peak of live bytes to the bytes that are live right now, such
+ * that `get_heap_stats().peak_live_bytes` measures from this point on.
+ */
+inline void reset_heap_peak()
+{
+    auto& c = detail::global_heap_counters();
+    c.peak_live_bytes.store(c.live_bytes.load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+}
+
+/*!
+ * A heap that passes on to the parent heap, counting the number of
+ * allocations and the bytes that go through it.  The counters are global
+ * and shared by all instantiations, they can be read with
+ * `get_heap_stats()`.
+ *
+ * With `heap_policy<counting_heap<cpp_heap>>` it counts every node that
+ * the containers allocate.  With `free_list_heap_policy<counting_heap<
+ * cpp_heap>>` it only counts the memory that the free lists request when
+ * they are empty, which is what the program actually takes from the
+ * system.  When the macro `IMMER_ENABLE_COUNTING_HEAP` is set to `1` the
+ * default heap policy does the latter.
+ *
+ * @note Memory released by a garbage collected parent heap is counted as
+ *       deallocated as soon as `deallocate` is called.
+ */
+template <typename Base>
+struct counting_heap : Base
+{
+    template <typename... Tags>
+    static void* allocate(std::size_t size, Tags... tags)
+    {
+        auto p  = Base::allocate(size, tags...);
+        auto& c = detail::global_heap_counters();
+        c.allocations.fetch_add(1, std::memory_order_relaxed);
+        c.allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+        auto live = c.live_bytes.fetch_add(size, std::memory_order_relaxed) +
+                    size;
+        auto peak = c.peak_live_bytes.load(std::memory_order_relaxed);
+        while (peak < live &&
+               !c.peak_live_bytes.compare_exchange_weak(
+                   peak, live, std::memory_order_relaxed))
+            ;
+        return p;
+    }
+
+    template <typename... Tags>
+    static void deallocate(std::size_t size, void* data, Tags... tags)
+    {
+        auto& c = detail::global_heap_counters();
+        c.deallocations.fetch_add(1, std::memory_order_relaxed);
+        c.live_bytes.fetch_sub(size, std::memory_order_relaxed);
+        Base::deallocate(size, data, tags...);
+    }
+};
+
+} // namespace immer
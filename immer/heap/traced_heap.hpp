@@ -0,0 +1,53 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/trace/no_trace_policy.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace immer {
+
+/*!
+ * A heap that passes on to the parent heap, notifying the *trace policy*
+ * `Trace` of every allocation and deallocation.  The containers use it to
+ * wrap the heap of their nodes when the memory policy has a trace policy
+ * other than @ref no_trace_policy.
+ */
+template <typename Trace, typename Base>
+struct traced_heap : Base
+{
+    template <typename... Tags>
+    static void* allocate(std::size_t size, Tags... tags)
+    {
+        auto p = Base::allocate(size, tags...);
+        Trace::on_allocate(size);
+        return p;
+    }
+
+    template <typename... Tags>
+    static void deallocate(std::size_t size, void* data, Tags... tags)
+    {
+        Trace::on_deallocate(size);
+        Base::deallocate(size, data, tags...);
+    }
+};
+
+namespace detail {
+
+template <typename Trace, typename Heap>
+using traced_heap_t =
+    std::conditional_t<std::is_same<Trace, no_trace_policy>::value,
+                       Heap,
+                       traced_heap<Trace, Heap>>;
+
+} // namespace detail
+
+} // namespace immer
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <immer/config.hpp>
 #include <immer/heap/cpp_heap.hpp>
 #include <immer/heap/heap_policy.hpp>
 #include <immer/lock/no_lock_policy.hpp>
@@ -15,10 +16,15 @@
 #include <immer/refcount/no_refcount_policy.hpp>
 #include <immer/refcount/refcount_policy.hpp>
 #include <immer/refcount/unsafe_refcount_policy.hpp>
+#include <immer/trace/no_trace_policy.hpp>
 #include <immer/transience/gc_transience_policy.hpp>
 #include <immer/transience/no_transience_policy.hpp>
 #include <type_traits>
 
+#if IMMER_ENABLE_COUNTING_HEAP
+#include <immer/heap/counting_heap.hpp>
+#endif
+
 namespace immer {
 
 /*!
@@ -82,6 +88,9 @@ constexpr auto get_use_transient_rvalues_v =
  * @tparam UseTransientRValues Boolean flag indicating whether
  *         immutable containers should try to modify contents in-place
  *         when manipulating an r-value reference.
+ * @tparam TracePolicy A *trace policy*, that gets notified of node
+ *         allocations, copies and in-place updates, for example,
+ *         @ref no_trace_policy.
  */
 template <typename HeapPolicy,
           typename RefcountPolicy,
@@ -90,13 +99,15 @@ template <typename HeapPolicy,
           bool PreferFewerBiggerObjects =
               get_prefer_fewer_bigger_objects_v<HeapPolicy>,
           bool UseTransientRValues =
-              get_use_transient_rvalues_v<RefcountPolicy>>
+              get_use_transient_rvalues_v<RefcountPolicy>,
+          typename TracePolicy = no_trace_policy>
 struct memory_policy
 {
     using heap       = HeapPolicy;
     using refcount   = RefcountPolicy;
     using transience = TransiencePolicy;
     using lock       = LockPolicy;
+    using trace      = TracePolicy;
 
     static constexpr bool prefer_fewer_bigger_objects =
         PreferFewerBiggerObjects;
@@ -106,18 +117,53 @@ struct memory_policy
     using transience_t = typename transience::template apply<heap>::type;
 };
 
+/*!
+ * The memory policy `MemoryPolicy`, with all its policies and flags, but
+ * notifying `TracePolicy`.  This saves spelling the defaults of the
+ * parameters of @ref memory_policy that go before the trace policy, for
+ * example:
+ *
+ * @code{.cpp}
+ * using traced_vector = immer::vector<
+ *     int,
+ *     immer::traced_memory_policy<immer::default_memory_policy,
+ *                                 my_trace_policy>>;
+ * @endcode
+ */
+template <typename MemoryPolicy, typename TracePolicy>
+using traced_memory_policy =
+    memory_policy<typename MemoryPolicy::heap,
+                  typename MemoryPolicy::refcount,
+                  typename MemoryPolicy::lock,
+                  typename MemoryPolicy::transience,
+                  MemoryPolicy::prefer_fewer_bigger_objects,
+                  MemoryPolicy::use_transient_rvalues,
+                  TracePolicy>;
+
+/*!
+ * The system heap used by the default *heap policy*.  It is
+ * `counting_heap<cpp_heap>` when `IMMER_ENABLE_COUNTING_HEAP` is defined
+ * to `1`, such that the memory used by the containers can be inspected
+ * with `get_heap_stats()`, and just `cpp_heap` otherwise.
+ */
+#if IMMER_ENABLE_COUNTING_HEAP
+using default_base_heap = counting_heap<cpp_heap>;
+#else
+using default_base_heap = cpp_heap;
+#endif
+
 /*!
  * The default *heap policy* just uses the standard heap with a
  * @ref free_list_heap_policy.  If `IMMER_NO_FREE_LIST` is defined to `1`
  * then it just uses the standard heap.
  */
 #if IMMER_NO_FREE_LIST
-using default_heap_policy = heap_policy<debug_size_heap<cpp_heap>>;
+using default_heap_policy = heap_policy<debug_size_heap<default_base_heap>>;
 #else
 #if IMMER_NO_THREAD_SAFETY
-using default_heap_policy     = unsafe_free_list_heap_policy<cpp_heap>;
+using default_heap_policy = unsafe_free_list_heap_policy<default_base_heap>;
 #else
-using default_heap_policy = free_list_heap_policy<cpp_heap>;
+using default_heap_policy = free_list_heap_policy<default_base_heap>;
 #endif
 #endif
 
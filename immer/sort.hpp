@@ -0,0 +1,330 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/config.hpp>
+#include <immer/flex_vector.hpp>
+#include <immer/flex_vector_transient.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace immer {
+
+/*!
+ * Executor that runs every task immediately in the calling thread.
+ *
+ * An executor is a callable object taking a nullary function.  It returns a
+ * handle with a `get()` method that waits for the function to finish and
+ * rethrows any exception that it raised, like `std::future<void>` does.
+ */
+struct sequential_executor
+{
+    struct handle
+    {
+        void get() {}
+    };
+
+    template <typename Fn>
+    handle operator()(Fn&& fn) const
+    {
+        std::forward<Fn>(fn)();
+        return {};
+    }
+};
+
+/*!
+ * Executor that runs every task in a new thread with `std::async`.  The
+ * algorithms only fork tasks up to a depth that keeps about twice as many
+ * tasks as hardware threads running at once.
+ */
+struct async_executor
+{
+    template <typename Fn>
+    std::future<void> operator()(Fn&& fn) const
+    {
+        return std::async(std::launch::async, std::forward<Fn>(fn));
+    }
+};
+
+namespace detail {
+
+// Forking stops at this depth, so at most about twice as many tasks as
+// hardware threads run at once, instead of one for every large range.
+inline std::size_t max_fork_depth()
+{
+    auto threads = std::max(1u, std::thread::hardware_concurrency());
+    auto depth   = std::size_t{1};
+    while ((std::size_t{1} << depth) < threads)
+        ++depth;
+    return depth + 1;
+}
+
+template <typename Vector, typename Compare, typename Executor>
+struct flex_vector_sorter
+{
+    using vector_t = Vector;
+    using value_t  = typename Vector::value_type;
+    using size_t   = std::size_t;
+
+    // Ranges up to this size are copied into a buffer and sorted with the
+    // standard algorithms.  It spans a few leaves, so the buffer is small.
+    static constexpr size_t chunk_size = size_t{16} << vector_t::bits_leaf;
+    // Ranges below this size are not worth handing to the executor.
+    static constexpr size_t parallel_size = size_t{1} << 14;
+
+    Compare cmp;
+    const Executor& exec;
+    bool stable;
+    size_t max_depth;
+
+    template <typename Fn1, typename Fn2>
+    void fork(size_t size, size_t depth, Fn1&& fn1, Fn2&& fn2)
+    {
+        if (size < parallel_size || depth >= max_depth) {
+            fn1();
+            fn2();
+        } else {
+            auto h = exec(std::forward<Fn1>(fn1));
+            IMMER_TRY {
+                fn2();
+            }
+            IMMER_CATCH (...) {
+                h.get();
+                IMMER_RETHROW;
+            }
+            h.get();
+        }
+    }
+
+    vector_t sort_chunk(const vector_t& v)
+    {
+        auto buf = std::vector<value_t>(v.begin(), v.end());
+        if (stable)
+            std::stable_sort(buf.begin(), buf.end(), cmp);
+        else
+            std::sort(buf.begin(), buf.end(), cmp);
+        return {std::make_move_iterator(buf.begin()),
+                std::make_move_iterator(buf.end())};
+    }
+
+    vector_t sort(const vector_t& v, size_t depth = 0)
+    {
+        if (v.size() <= chunk_size)
+            return sort_chunk(v);
+        auto mid = v.size() / 2;
+        auto l   = vector_t{};
+        auto r   = vector_t{};
+        fork(
+            v.size(),
+            depth,
+            [&] { l = sort(v.take(mid), depth + 1); },
+            [&] { r = sort(v.drop(mid), depth + 1); });
+        return merge(l, r, depth);
+    }
+
+    // Merges two sorted vectors, taking elements from `l` first when they
+    // are equivalent, so it is stable.
+    vector_t merge(const vector_t& l, const vector_t& r, size_t depth)
+    {
+        auto size = l.size() + r.size();
+        if (l.empty())
+            return r;
+        if (r.empty())
+            return l;
+        if (!cmp(r.front(), l.back()))
+            return l + r;
+        if (size < parallel_size)
+            return merge_seq(l, r);
+        // Split the larger side in the middle and find the matching split
+        // point in the other side, then merge both halves independently.
+        auto li = size_t{};
+        auto ri = size_t{};
+        if (l.size() >= r.size()) {
+            li = l.size() / 2;
+            ri = std::lower_bound(r.begin(), r.end(), l[li], cmp) - r.begin();
+        } else {
+            ri = r.size() / 2;
+            li = std::upper_bound(l.begin(), l.end(), r[ri], cmp) - l.begin();
+        }
+        auto a = vector_t{};
+        auto b = vector_t{};
+        fork(
+            size,
+            depth,
+            [&] { a = merge(l.take(li), r.take(ri), depth + 1); },
+            [&] { b = merge(l.drop(li), r.drop(ri), depth + 1); });
+        return std::move(a) + std::move(b);
+    }
+
+    vector_t merge_seq(const vector_t& l, const vector_t& r)
+    {
+        auto t  = vector_t{}.transient();
+        auto lf = l.begin();
+        auto ll = l.end();
+        auto rf = r.begin();
+        auto rl = r.end();
+        while (lf != ll && rf != rl) {
+            if (cmp(*rf, *lf))
+                t.push_back(*rf++);
+            else
+                t.push_back(*lf++);
+        }
+        for (; lf != ll; ++lf)
+            t.push_back(*lf);
+        for (; rf != rl; ++rf)
+            t.push_back(*rf);
+        return t.persistent();
+    }
+
+    vector_t partial_sort(const vector_t& v, size_t k, size_t depth = 0)
+    {
+        k = std::min(k, v.size());
+        if (k == 0)
+            return v;
+        if (v.size() <= chunk_size) {
+            auto buf = std::vector<value_t>(v.begin(), v.end());
+            std::partial_sort(buf.begin(), buf.begin() + k, buf.end(), cmp);
+            return {std::make_move_iterator(buf.begin()),
+                    std::make_move_iterator(buf.end())};
+        }
+        auto mid = v.size() / 2;
+        auto l   = vector_t{};
+        auto r   = vector_t{};
+        fork(
+            v.size(),
+            depth,
+            [&] { l = partial_sort(v.take(mid), k, depth + 1); },
+            [&] { r = partial_sort(v.drop(mid), k, depth + 1); });
+        // The smallest k elements are among the sorted prefixes of both
+        // halves, the rest of the elements are appended unsorted.
+        auto t  = vector_t{}.transient();
+        auto li = size_t{};
+        auto ri = size_t{};
+        auto lf = l.begin();
+        auto rf = r.begin();
+        while (li + ri < k) {
+            if (ri < r.size() && (li == l.size() || cmp(*rf, *lf))) {
+                t.push_back(*rf++);
+                ++ri;
+            } else {
+                t.push_back(*lf++);
+                ++li;
+            }
+        }
+        return t.persistent() + l.drop(li) + r.drop(ri);
+    }
+};
+
+template <typename Vector, typename Compare, typename Executor>
+flex_vector_sorter<Vector, Compare, Executor>
+make_flex_vector_sorter(Compare cmp, const Executor& exec, bool stable)
+{
+    return {std::move(cmp), exec, stable, max_fork_depth()};
+}
+
+} // namespace detail
+
+/*!
+ * Returns a `flex_vector` with the elements of `v` sorted according to
+ * `cmp`.  The order of equivalent elements is not preserved.
+ *
+ * The vector is split into ranges spanning a few leaves that are sorted
+ * independently.  The sorted ranges are then merged recursively, and large
+ * merges are divided in halves that are merged independently and joined
+ * with @f$ O(log(size)) @f$ concatenation.  Both sorting and merging of
+ * large ranges is done in tasks submitted to `exec`.  No flat copy of the
+ * whole vector is ever allocated.  Its complexity is @f$ O(size \cdot
+ * log(size)) @f$.
+ *
+ * The executor is a callable taking a nullary function and returning a
+ * handle with a `get()` method, like `std::future<void>`.  With the default
+ * `sequential_executor` everything happens in the calling thread, while
+ * `async_executor` uses a new thread for each task.  Tasks are only forked
+ * up to a depth of about @f$ log_2(hardware\_concurrency) + 1 @f$, below
+ * which ranges are processed in the task that reached it.  The memory
+ * policy of the vector must be thread safe when using a concurrent
+ * executor.
+ *
+ * @rst
+ *
+ * **Example**
+ *   .. literalinclude:: ../example/flex-vector/sort.cpp
+ *      :language: c++
+ *      :dedent: 8
+ *      :start-after: sort/start
+ *      :end-before:  sort/end
+ *
+ * @endrst
+ */
+template <typename T,
+          typename MemoryPolicy,
+          detail::rbts::bits_t B,
+          detail::rbts::bits_t BL,
+          typename Compare  = std::less<>,
+          typename Executor = sequential_executor>
+flex_vector<T, MemoryPolicy, B, BL>
+sort(const flex_vector<T, MemoryPolicy, B, BL>& v,
+     Compare cmp           = {},
+     const Executor& exec = {})
+{
+    return detail::make_flex_vector_sorter<flex_vector<T, MemoryPolicy, B, BL>>(
+               std::move(cmp), exec, false)
+        .sort(v);
+}
+
+/*!
+ * Like `sort()`, but the order of equivalent elements is preserved.
+ */
+template <typename T,
+          typename MemoryPolicy,
+          detail::rbts::bits_t B,
+          detail::rbts::bits_t BL,
+          typename Compare  = std::less<>,
+          typename Executor = sequential_executor>
+flex_vector<T, MemoryPolicy, B, BL>
+stable_sort(const flex_vector<T, MemoryPolicy, B, BL>& v,
+            Compare cmp           = {},
+            const Executor& exec = {})
+{
+    return detail::make_flex_vector_sorter<flex_vector<T, MemoryPolicy, B, BL>>(
+               std::move(cmp), exec, true)
+        .sort(v);
+}
+
+/*!
+ * Returns a `flex_vector` with the same elements as `v` whose first
+ * `min(middle, size)` elements are the smallest of `v` in sorted order.  The
+ * order of the remaining elements is unspecified.  Its complexity is @f$
+ * O(size \cdot log(middle)) @f$, plus @f$ O(middle \cdot log(size)) @f$
+ * for merging.
+ */
+template <typename T,
+          typename MemoryPolicy,
+          detail::rbts::bits_t B,
+          detail::rbts::bits_t BL,
+          typename Compare  = std::less<>,
+          typename Executor = sequential_executor>
+flex_vector<T, MemoryPolicy, B, BL>
+partial_sort(const flex_vector<T, MemoryPolicy, B, BL>& v,
+             std::size_t middle,
+             Compare cmp           = {},
+             const Executor& exec = {})
+{
+    return detail::make_flex_vector_sorter<flex_vector<T, MemoryPolicy, B, BL>>(
+               std::move(cmp), exec, false)
+        .partial_sort(v, middle);
+}
+
+} // namespace immer
@@ -0,0 +1,268 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/config.hpp>
+#include <immer/detail/text/rope.hpp>
+#include <immer/memory_policy.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <string>
+
+namespace immer {
+
+/*!
+ * Immutable UTF-8 text supporting efficient edits and line lookups.
+ *
+ * @tparam MemoryPolicy Memory management policy. See @ref
+ *         memory_policy.
+ *
+ * @rst
+ *
+ * The bytes are stored in chunks of up to ``ChunkSize`` bytes in the leaves
+ * of a balanced binary tree.  Every node of the tree counts the bytes,
+ * newlines and UTF-8 code points below it, so that mapping line numbers to
+ * byte offsets and back, insertion, erasure, concatenation and slicing are
+ * all :math:`O(log(size))`, and they share most of the tree with the
+ * original text.  Use ``immer::flex_vector<char>`` when the positions of
+ * the lines are not needed.
+ *
+ * Lines are separated by ``'\n'`` and numbered from zero.  Positions are
+ * byte offsets.  The text is not validated, so invalid UTF-8 is kept as is.
+ *
+ * **Example**
+ *   .. literalinclude:: ../example/text/intro.cpp
+ *      :language: c++
+ *      :start-after: intro/start
+ *      :end-before:  intro/end
+ *
+ * @endrst
+ */
+template <typename MemoryPolicy = default_memory_policy,
+          std::size_t ChunkSize = 512>
+class text
+{
+    using impl_t = detail::text::rope<MemoryPolicy, ChunkSize>;
+
+public:
+    using memory_policy   = MemoryPolicy;
+    using value_type      = char;
+    using reference       = char;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = char;
+
+    /*!
+     * Default constructor.  It creates an empty text.  It does not allocate
+     * memory and its complexity is @f$ O(1) @f$.
+     */
+    text() = default;
+
+    /*!
+     * Constructs a text with the bytes in `[first, last)`.
+     */
+    text(const char* first, const char* last)
+        : impl_{impl_t::from_range(first, last)}
+    {
+    }
+
+    /*!
+     * Constructs a text with the bytes of the null terminated string `str`.
+     */
+    text(const char* str)
+        : text{str, str + std::strlen(str)}
+    {
+    }
+
+    /*!
+     * Constructs a text with the bytes of `str`.
+     */
+    text(const std::string& str)
+        : text{str.data(), str.data() + str.size()}
+    {
+    }
+
+    /*!
+     * Returns the number of bytes.  It does not allocate memory and its
+     * complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD size_type size() const { return impl_.size(); }
+
+    /*!
+     * Returns `true` if there are no bytes.  It does not allocate memory
+     * and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD bool empty() const { return size() == 0; }
+
+    /*!
+     * Returns the number of lines, that is, one more than the number of
+     * newlines.  Its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD size_type line_count() const
+    {
+        return impl_.root->lines + 1;
+    }
+
+    /*!
+     * Returns the number of UTF-8 code points.  Its complexity is
+     * @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD size_type codepoint_count() const
+    {
+        return impl_.root->codepoints;
+    }
+
+    /*!
+     * Returns the byte at position `index`.  It is undefined when
+     * @f$ index \geq size() @f$.  Its complexity is @f$ O(log(size)) @f$.
+     */
+    IMMER_NODISCARD char operator[](size_type index) const
+    {
+        return impl_.get(index);
+    }
+
+    /*!
+     * Returns the byte at position `index`.  It throws an
+     * `std::out_of_range` exception when @f$ index \geq size() @f$.
+     */
+    char at(size_type index) const { return impl_.get_check(index); }
+
+    /*!
+     * Returns the offset of the first byte of line `line`.  It is undefined
+     * unless `line < line_count()`.  Its complexity is @f$ O(log(size) +
+     * ChunkSize) @f$.
+     */
+    IMMER_NODISCARD size_type line_to_offset(size_type line) const
+    {
+        assert(line < line_count());
+        return impl_.line_to_offset(line);
+    }
+
+    /*!
+     * Returns the number of the line containing the byte at `offset`.  The
+     * newline at the end of a line belongs to it.  For @f$ offset \geq
+     * size() @f$ it returns the last line.  Its complexity is @f$
+     * O(log(size) + ChunkSize) @f$.
+     */
+    IMMER_NODISCARD size_type offset_to_line(size_type offset) const
+    {
+        return impl_.offset_to_line(offset);
+    }
+
+    /*!
+     * Returns the contents of line `line` without its newline.  It is
+     * undefined unless `line < line_count()`.  Its complexity is @f$
+     * O(log(size)) @f$.
+     */
+    IMMER_NODISCARD text line(size_type line) const
+    {
+        auto first = line_to_offset(line);
+        auto last  = line + 1 < line_count() ? line_to_offset(line + 1) - 1
+                                             : size();
+        return slice(first, last);
+    }
+
+    /*!
+     * Returns a text with `other` inserted at byte `offset`.  It is
+     * undefined unless `offset <= size()`.  Its complexity is @f$
+     * O(log(size)) @f$.
+     */
+    IMMER_NODISCARD text insert(size_type offset, const text& other) const
+    {
+        assert(offset <= size());
+        return impl_.insert(offset, other.impl_);
+    }
+
+    /*!
+     * Returns a text without the bytes in `[first, last)`.  It is undefined
+     * unless `first <= last <= size()`.  Its complexity is @f$
+     * O(log(size)) @f$.
+     */
+    IMMER_NODISCARD text erase(size_type first, size_type last) const
+    {
+        assert(first <= last && last <= size());
+        return impl_.erase(first, last);
+    }
+
+    /*!
+     * Returns a text with the first `min(elems, size())` bytes.  Its
+     * complexity is @f$ O(log(size)) @f$.
+     */
+    IMMER_NODISCARD text take(size_type elems) const
+    {
+        return impl_.take(elems);
+    }
+
+    /*!
+     * Returns a text without the first `min(elems, size())` bytes.  Its
+     * complexity is @f$ O(log(size)) @f$.
+     */
+    IMMER_NODISCARD text drop(size_type elems) const
+    {
+        return impl_.drop(elems);
+    }
+
+    /*!
+     * Returns a text with the bytes in `[first, last)`.  It is undefined
+     * unless `first <= last <= size()`.  Its complexity is @f$
+     * O(log(size)) @f$.
+     */
+    IMMER_NODISCARD text slice(size_type first, size_type last) const
+    {
+        assert(first <= last && last <= size());
+        return impl_.slice(first, last);
+    }
+
+    /*!
+     * Concatenation operator.  Returns a text with the contents of `l`
+     * followed by those of `r`.  Its complexity is @f$ O(log(max(size_l,
+     * size_r))) @f$.
+     */
+    IMMER_NODISCARD friend text operator+(const text& l, const text& r)
+    {
+        return l.impl_.concat(r.impl_);
+    }
+
+    /*!
+     * Returns a `std::string` with a copy of the bytes.
+     */
+    IMMER_NODISCARD std::string str() const
+    {
+        auto r = std::string{};
+        r.reserve(size());
+        impl_.for_each_chunk([&](auto f, auto l) { r.append(f, l); });
+        return r;
+    }
+
+    /*!
+     * Returns whether both texts have the same bytes.
+     */
+    IMMER_NODISCARD bool operator==(const text& other) const
+    {
+        return impl_.equals(other.impl_);
+    }
+    IMMER_NODISCARD bool operator!=(const text& other) const
+    {
+        return !(*this == other);
+    }
+
+    // Semi-private
+    const impl_t& impl() const { return impl_; }
+
+private:
+    text(impl_t impl)
+        : impl_(std::move(impl))
+    {
+    }
+
+    impl_t impl_ = {};
+};
+
+} // namespace immer
@@ -0,0 +1,85 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/detail/type_traits.hpp>
+
+#include <cstddef>
+
+namespace immer {
+
+/*!
+ * Disables tracing.  A *trace policy* is a type with static member
+ * functions that the containers call on some interesting events, in the
+ * same thread where they happen.  This one does nothing, so the calls are
+ * optimized away.  A custom policy must provide all these functions, and
+ * can be passed as the last argument of @ref memory_policy.
+ */
+struct no_trace_policy
+{
+    /*!
+     * A node of `size` bytes was allocated.
+     */
+    static void on_allocate(std::size_t /* size */) {}
+
+    /*!
+     * A node of `size` bytes is about to be deallocated.
+     */
+    static void on_deallocate(std::size_t /* size */) {}
+
+    /*!
+     * A node was copied, instead of updated in place, because it was shared
+     * with other containers.  `count` is the number of elements or children
+     * that were copied.
+     */
+    static void on_copy(std::size_t /* count */) {}
+
+    /*!
+     * A node was updated in place, or its contents moved into a new node,
+     * instead of copied, because it is owned by a transient or only
+     * referenced from an r-value container.
+     */
+    static void on_mutate() {}
+
+    /*!
+     * Concatenating two relaxed trees redistributed the `before` nodes of
+     * one level of the tree into `after` nodes.
+     */
+    static void on_rebalance(std::size_t /* before */,
+                             std::size_t /* after */)
+    {}
+
+    /*!
+     * A value was added to a collision node of a hash trie, which now
+     * holds `count` values with the same hash.
+     */
+    static void on_collision(std::size_t /* count */) {}
+};
+
+/*!
+ * Metafunction that returns the *trace policy* of a *memory policy*, that
+ * is its `trace` member type, or @ref no_trace_policy when it has none.
+ */
+template <typename MemoryPolicy, typename = void>
+struct get_trace_policy
+{
+    using type = no_trace_policy;
+};
+
+template <typename MemoryPolicy>
+struct get_trace_policy<MemoryPolicy,
+                        detail::void_t<typename MemoryPolicy::trace>>
+{
+    using type = typename MemoryPolicy::trace;
+};
+
+template <typename T>
+using get_trace_policy_t = typename get_trace_policy<T>::type;
+
+} // namespace immer
@@ -0,0 +1,69 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/config.hpp>
+#include <immer/flex_vector.hpp>
+#include <immer/memory_policy.hpp>
+#include <immer/vector.hpp>
+
+#include <cstddef>
+
+namespace immer {
+
+/*!
+ * Number of cache lines that the elements of a leaf take in
+ * @ref tuned_vector and @ref tuned_flex_vector.  It is the size of the
+ * inner nodes with the default branching on 64 bit platforms, and thus of
+ * the leaves of `vector<std::size_t>`.  Bigger leaves make access and
+ * iteration faster and updates slower.  The benchmarks in
+ * `benchmark/vector/tuning` measure this trade-off for a given element
+ * type and machine.
+ */
+const auto default_leaf_cache_lines = 4;
+
+/*!
+ * Returns the number of bits of a leaf such that its elements of type `T`
+ * fill, without overflowing, `CacheLines` cache lines of `CacheLineSize`
+ * bytes.  The cache line size defaults to the value of the
+ * `IMMER_CACHE_LINE_SIZE` macro, which is `64` unless defined otherwise.
+ * Leaves always have at least one element.
+ */
+template <typename T,
+          std::size_t CacheLines    = default_leaf_cache_lines,
+          std::size_t CacheLineSize = IMMER_CACHE_LINE_SIZE>
+constexpr detail::rbts::bits_t tuned_bits_leaf = static_cast<
+    detail::rbts::bits_t>(detail::log2(
+    CacheLines * CacheLineSize < sizeof(T) ? std::size_t{1}
+                                           : CacheLines * CacheLineSize /
+                                                 sizeof(T)));
+
+/*!
+ * An @ref vector whose leaves take `CacheLines` cache lines.  See
+ * @ref tuned_bits_leaf.
+ */
+template <typename T,
+          typename MemoryPolicy  = default_memory_policy,
+          std::size_t CacheLines = default_leaf_cache_lines,
+          detail::rbts::bits_t B = default_bits>
+using tuned_vector =
+    vector<T, MemoryPolicy, B, tuned_bits_leaf<T, CacheLines>>;
+
+/*!
+ * An @ref flex_vector whose leaves take `CacheLines` cache lines.  See
+ * @ref tuned_bits_leaf.
+ */
+template <typename T,
+          typename MemoryPolicy  = default_memory_policy,
+          std::size_t CacheLines = default_leaf_cache_lines,
+          detail::rbts::bits_t B = default_bits>
+using tuned_flex_vector =
+    flex_vector<T, MemoryPolicy, B, tuned_bits_leaf<T, CacheLines>>;
+
+} // namespace immer
@@ -96,6 +96,7 @@ public:
     using reverse_iterator = std::reverse_iterator<iterator>;
 
     using transient_type = vector_transient<T, MemoryPolicy, B, BL>;
+    using debug_stats_t  = detail::rbts::fill_stats;
 
     /*!
      * Returns the maximum theoretical size supported by the internal structure
@@ -336,6 +337,16 @@ public:
         return take_move(move_t{}, elems);
     }
 
+    /*!
+     * Returns statistics about the shape of the tree: its depth, the number
+     * of leaves and inner nodes, how full they are at every level and how
+     * full the tail is.  Its complexity is @f$ O(size) @f$.
+     */
+    IMMER_NODISCARD debug_stats_t get_debug_stats() const
+    {
+        return impl_.get_fill_stats();
+    }
+
     /*!
      * Returns an @a transient form of this container, an
      * `immer::vector_transient`.
@@ -0,0 +1,347 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#pragma once
+
+#include <immer/config.hpp>
+#include <immer/flex_vector.hpp>
+#include <immer/vector.hpp>
+#include <immer/vector_transient.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+namespace immer {
+
+namespace detail {
+
+template <typename Vector>
+struct vector_view_impl
+{
+    Vector vector;
+    std::size_t first;
+    std::size_t last;
+
+    template <typename Fn>
+    void for_each_chunk(Fn&& fn) const
+    {
+        vector.impl().for_each_chunk(first, last, std::forward<Fn>(fn));
+    }
+
+    template <typename Fn>
+    bool for_each_chunk_p(Fn&& fn) const
+    {
+        return vector.impl().for_each_chunk_p(
+            first, last, std::forward<Fn>(fn));
+    }
+};
+
+template <typename T,
+          typename MemoryPolicy,
+          detail::rbts::bits_t B,
+          detail::rbts::bits_t BL>
+auto materialize_view(const vector<T, MemoryPolicy, B, BL>& v,
+                      std::size_t first,
+                      std::size_t last)
+{
+    // vectors can only be sliced at the end, other slices are copied
+    if (first == 0)
+        return v.take(last);
+    auto t = vector<T, MemoryPolicy, B, BL>{}.transient();
+    v.impl().for_each_chunk(first, last, [&](auto f, auto l) {
+        for (; f != l; ++f)
+            t.push_back(*f);
+    });
+    return t.persistent();
+}
+
+template <typename T,
+          typename MemoryPolicy,
+          detail::rbts::bits_t B,
+          detail::rbts::bits_t BL>
+auto materialize_view(const flex_vector<T, MemoryPolicy, B, BL>& v,
+                      std::size_t first,
+                      std::size_t last)
+{
+    return v.take(last).drop(first);
+}
+
+} // namespace detail
+
+/*!
+ * Read-only view over the contiguous range `[first, last)` of an
+ * `immer::vector` or `immer::flex_vector`.
+ *
+ * Creating a view, or slicing it further with `take()`, `drop()` or
+ * `slice()`, does not allocate memory and its complexity is @f$ O(1) @f$: it
+ * only refers to the nodes of the original container.  In contrast, `take()`
+ * and `drop()` on the container build new paths of nodes.  Views are thus
+ * useful to pass around subranges that are only read.  The container can be
+ * obtained with `materialize()` when needed.
+ *
+ * The view holds a copy of the container, so it remains valid no matter what
+ * happens to the original.
+ *
+ * @tparam Vector An `immer::vector` or `immer::flex_vector`.
+ *
+ * @rst
+ *
+ * **Example**
+ *   .. literalinclude:: ../example/flex-vector/view.cpp
+ *      :language: c++
+ *      :dedent: 8
+ *      :start-after: view/start
+ *      :end-before:  view/end
+ *
+ * @endrst
+ */
+template <typename Vector>
+class basic_vector_view
+{
+    using impl_t = detail::vector_view_impl<Vector>;
+
+public:
+    using container_type  = Vector;
+    using value_type      = typename Vector::value_type;
+    using reference       = const value_type&;
+    using size_type       = typename Vector::size_type;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = const value_type&;
+
+    using iterator         = typename Vector::iterator;
+    using const_iterator   = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    /*!
+     * Default constructor.  It creates an empty view.
+     */
+    basic_vector_view() = default;
+
+    /*!
+     * Creates a view over all the elements of `v`.
+     */
+    basic_vector_view(Vector v)
+        : impl_{std::move(v), 0, 0}
+    {
+        impl_.last = impl_.vector.size();
+    }
+
+    /*!
+     * Creates a view over the elements of `v` in `[first, last)`.  It is
+     * undefined unless `first <= last <= v.size()`.
+     */
+    basic_vector_view(Vector v, size_type first, size_type last)
+        : impl_{std::move(v), first, last}
+    {
+        assert(first <= last && last <= impl_.vector.size());
+    }
+
+    /*!
+     * Returns an iterator pointing at the first element of the view.  It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD iterator begin() const
+    {
+        return impl_.vector.begin() + impl_.first;
+    }
+
+    /*!
+     * Returns an iterator pointing just after the last element of the view.
+     * It does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD iterator end() const
+    {
+        return impl_.vector.begin() + impl_.last;
+    }
+
+    /*!
+     * Returns an iterator that traverses the view backwards, starting at the
+     * last element.
+     */
+    IMMER_NODISCARD reverse_iterator rbegin() const
+    {
+        return reverse_iterator{end()};
+    }
+
+    /*!
+     * Returns an iterator that traverses the view backwards, pointing just
+     * before the first element.
+     */
+    IMMER_NODISCARD reverse_iterator rend() const
+    {
+        return reverse_iterator{begin()};
+    }
+
+    /*!
+     * Returns the number of elements in the view.
+     */
+    IMMER_NODISCARD size_type size() const { return impl_.last - impl_.first; }
+
+    /*!
+     * Returns `true` if there are no elements in the view.
+     */
+    IMMER_NODISCARD bool empty() const { return impl_.last == impl_.first; }
+
+    /*!
+     * Access the first element.
+     */
+    IMMER_NODISCARD const value_type& front() const
+    {
+        return impl_.vector[impl_.first];
+    }
+
+    /*!
+     * Access the last element.
+     */
+    IMMER_NODISCARD const value_type& back() const
+    {
+        return impl_.vector[impl_.last - 1];
+    }
+
+    /*!
+     * Returns a `const` reference to the element at position `index` of the
+     * view.  It is undefined when @f$ index \geq size() @f$.  Its complexity
+     * is the same as indexing the container.
+     */
+    IMMER_NODISCARD reference operator[](size_type index) const
+    {
+        return impl_.vector[impl_.first + index];
+    }
+
+    /*!
+     * Returns a `const` reference to the element at position `index`. It
+     * throws an `std::out_of_range` exception when @f$ index \geq size()
+     * @f$.
+     */
+    reference at(size_type index) const
+    {
+        if (index >= size())
+            IMMER_THROW(std::out_of_range{"index out of range"});
+        return impl_.vector[impl_.first + index];
+    }
+
+    /*!
+     * Returns a view over the first `min(elems, size())` elements.  It does
+     * not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD basic_vector_view take(size_type elems) const
+    {
+        return {impl_.vector,
+                impl_.first,
+                impl_.first + std::min(elems, size())};
+    }
+
+    /*!
+     * Returns a view without the first `min(elems, size())` elements.  It
+     * does not allocate memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD basic_vector_view drop(size_type elems) const
+    {
+        return {
+            impl_.vector, impl_.first + std::min(elems, size()), impl_.last};
+    }
+
+    /*!
+     * Returns a view over the elements in `[first, last)` of this view.  It
+     * is undefined unless `first <= last <= size()`.  It does not allocate
+     * memory and its complexity is @f$ O(1) @f$.
+     */
+    IMMER_NODISCARD basic_vector_view slice(size_type first,
+                                            size_type last) const
+    {
+        assert(first <= last && last <= size());
+        return {impl_.vector, impl_.first + first, impl_.first + last};
+    }
+
+    /*!
+     * Returns a container with the elements of the view.  For flex vectors
+     * its complexity is @f$ O(log(size)) @f$ and it shares the nodes with
+     * the viewed container.  For vectors, slices that do not start at the
+     * beginning of the container are copied in @f$ O(size) @f$.
+     */
+    IMMER_NODISCARD Vector materialize() const
+    {
+        if (impl_.first == 0 && impl_.last == impl_.vector.size())
+            return impl_.vector;
+        return detail::materialize_view(
+            impl_.vector, impl_.first, impl_.last);
+    }
+
+    /*!
+     * Returns the viewed container.
+     */
+    IMMER_NODISCARD const Vector& container() const { return impl_.vector; }
+
+    /*!
+     * Returns the position of the first element of the view in the
+     * container.
+     */
+    IMMER_NODISCARD size_type offset() const { return impl_.first; }
+
+    /*!
+     * Returns whether both views contain equal elements.
+     */
+    IMMER_NODISCARD bool operator==(const basic_vector_view& other) const
+    {
+        return size() == other.size() &&
+               std::equal(begin(), end(), other.begin());
+    }
+    IMMER_NODISCARD bool operator!=(const basic_vector_view& other) const
+    {
+        return !(*this == other);
+    }
+
+    // Semi-private
+    const impl_t& impl() const { return impl_; }
+
+private:
+    impl_t impl_ = {Vector{}, 0, 0};
+};
+
+/*!
+ * View over a slice of an `immer::vector`.  See `basic_vector_view`.
+ */
+template <typename T,
+          typename MemoryPolicy  = default_memory_policy,
+          detail::rbts::bits_t B = default_bits,
+          detail::rbts::bits_t BL =
+              detail::rbts::derive_bits_leaf<T, MemoryPolicy, B>>
+using vector_view = basic_vector_view<vector<T, MemoryPolicy, B, BL>>;
+
+/*!
+ * View over a slice of an `immer::flex_vector`.  See `basic_vector_view`.
+ */
+template <typename T,
+          typename MemoryPolicy  = default_memory_policy,
+          detail::rbts::bits_t B = default_bits,
+          detail::rbts::bits_t BL =
+              detail::rbts::derive_bits_leaf<T, MemoryPolicy, B>>
+using flex_vector_view = basic_vector_view<flex_vector<T, MemoryPolicy, B, BL>>;
+
+/*!
+ * Returns a view over the elements of `v` in `[first, last)`.
+ */
+template <typename Vector>
+basic_vector_view<Vector>
+make_view(Vector v, std::size_t first, std::size_t last)
+{
+    return {std::move(v), first, last};
+}
+
+/*!
+ * Returns a view over all the elements of `v`.
+ */
+template <typename Vector>
+basic_vector_view<Vector> make_view(Vector v)
+{
+    return {std::move(v)};
+}
+
+} // namespace immer
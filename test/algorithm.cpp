@@ -9,6 +9,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstdint>
+#include <numeric>
+
 struct thing
 {
     int id = 0;
@@ -219,3 +222,108 @@ TEST_CASE("update_if_exists maps move")
     do_check(immer::map<int, int>{});
     do_check(immer::table<thing>{});
 }
+
+TEST_CASE("accumulate integers")
+{
+    auto do_check = [](auto v) {
+        using value_t = typename decltype(v)::value_type;
+        for (auto i = 0; i < 1000; ++i)
+            v = std::move(v).push_back(static_cast<value_t>(i * 7919 % 10007));
+        auto expected = value_t{};
+        for (auto x : v)
+            expected = static_cast<value_t>(expected + x);
+        CHECK(immer::accumulate(v, value_t{}) == expected);
+        CHECK(immer::accumulate(v.begin() + 3, v.end() - 5, value_t{}) ==
+              std::accumulate(v.begin() + 3, v.end() - 5, value_t{}));
+    };
+
+    do_check(immer::vector<int>{});
+    do_check(immer::vector<unsigned char>{});
+    do_check(immer::vector<std::int64_t>{});
+    do_check(immer::flex_vector<unsigned>{});
+}
+
+TEST_CASE("accumulate floats keeps order")
+{
+    auto v = immer::vector<float>{};
+    for (auto i = 0; i < 1000; ++i)
+        v = std::move(v).push_back(i % 2 ? 1e8f : 1.f);
+    CHECK(immer::accumulate(v, 0.f) ==
+          std::accumulate(v.begin(), v.end(), 0.f));
+}
+
+TEST_CASE("count")
+{
+    auto do_check = [](auto v) {
+        using value_t = typename decltype(v)::value_type;
+        for (auto i = 0; i < 1000; ++i)
+            v = std::move(v).push_back(static_cast<value_t>(i % 7));
+        CHECK(immer::count(v, value_t{3}) == 143);
+        CHECK(immer::count(v, value_t{9}) == 0);
+        CHECK(immer::count(v.begin() + 4, v.end(), value_t{3}) == 142);
+        CHECK(immer::count_if(v, [](auto x) { return x < 2; }) == 286);
+        CHECK(immer::count_if(v.begin(), v.begin() + 10, [](auto x) {
+                  return x < 2;
+              }) == 4);
+    };
+
+    do_check(immer::vector<int>{});
+    do_check(immer::vector<double>{});
+    do_check(immer::flex_vector<short>{});
+}
+
+TEST_CASE("find")
+{
+    auto do_check = [](auto v) {
+        using value_t = typename decltype(v)::value_type;
+        for (auto i = 0; i < 1000; ++i)
+            v = std::move(v).push_back(static_cast<value_t>(i % 300));
+        for (auto x : {0, 1, 15, 16, 17, 255, 299}) {
+            auto it = immer::find(v, static_cast<value_t>(x));
+            CHECK(it - v.begin() == x);
+            auto it2 = immer::find(v.begin() + 300, v.end(), value_t(x));
+            CHECK(it2 - v.begin() == x + 300);
+        }
+        CHECK(immer::find(v, value_t{300}) == v.end());
+        CHECK(immer::find(v.begin(), v.begin() + 10, value_t{11}) ==
+              v.begin() + 10);
+    };
+
+    do_check(immer::vector<int>{});
+    do_check(immer::vector<float>{});
+    do_check(immer::flex_vector<std::uint16_t>{});
+    do_check(immer::array<int>{});
+}
+
+TEST_CASE("min and max element")
+{
+    auto do_check = [](auto v) {
+        using value_t = typename decltype(v)::value_type;
+        CHECK(immer::min_element(v) == v.end());
+        CHECK(immer::max_element(v) == v.end());
+        for (auto i = 0; i < 1000; ++i)
+            v = std::move(v).push_back(
+                static_cast<value_t>((i * 7919) % 1009));
+        CHECK(immer::min_element(v) == std::min_element(v.begin(), v.end()));
+        CHECK(immer::max_element(v) == std::max_element(v.begin(), v.end()));
+        CHECK(immer::min_element(v, std::greater<>{}) ==
+              std::max_element(v.begin(), v.end()));
+        v = std::move(v).push_back(*immer::min_element(v));
+        CHECK(immer::min_element(v) == std::min_element(v.begin(), v.end()));
+
+        auto first = v.begin() + 17;
+        auto last  = v.end() - 300;
+        CHECK(immer::min_element(first, last) ==
+              std::min_element(first, last));
+        CHECK(immer::max_element(first, last) ==
+              std::max_element(first, last));
+        CHECK(immer::max_element(first, last, std::greater<>{}) ==
+              std::min_element(first, last));
+        CHECK(immer::min_element(first, first) == first);
+        CHECK(immer::max_element(first, first) == first);
+    };
+
+    do_check(immer::vector<int>{});
+    do_check(immer::vector<double>{});
+    do_check(immer::flex_vector<long>{});
+}
@@ -0,0 +1,199 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <immer/bitvector.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using bitvector_t = immer::bitvector<>;
+
+namespace {
+
+std::vector<bool> make_random(std::size_t n, unsigned seed, double p = 0.5)
+{
+    auto gen  = std::mt19937{seed};
+    auto dist = std::bernoulli_distribution{p};
+    auto r    = std::vector<bool>(n);
+    for (auto i = std::size_t{}; i < n; ++i)
+        r[i] = dist(gen);
+    return r;
+}
+
+bitvector_t make_bitvector(const std::vector<bool>& bits)
+{
+    auto r = bitvector_t{};
+    for (auto b : bits)
+        r = std::move(r).push_back(b);
+    return r;
+}
+
+void check_equal(const bitvector_t& v, const std::vector<bool>& expected)
+{
+    REQUIRE(v.size() == expected.size());
+    for (auto i = std::size_t{}; i < v.size(); ++i)
+        CHECK(v[i] == expected[i]);
+    CHECK(v.count() == static_cast<std::size_t>(std::count(
+                           expected.begin(), expected.end(), true)));
+
+    auto found = std::vector<std::size_t>{};
+    for (auto i = v.find_first(); i != bitvector_t::npos; i = v.find_next(i))
+        found.push_back(i);
+    auto set_bits = std::vector<std::size_t>{};
+    for (auto i = std::size_t{}; i < expected.size(); ++i)
+        if (expected[i])
+            set_bits.push_back(i);
+    CHECK(found == set_bits);
+}
+
+} // namespace
+
+TEST_CASE("instantiation")
+{
+    SECTION("default")
+    {
+        auto v = bitvector_t{};
+        CHECK(v.size() == 0u);
+        CHECK(v.empty());
+        CHECK(v.count() == 0u);
+        CHECK(v.find_first() == bitvector_t::npos);
+        CHECK(v.none());
+    }
+
+    SECTION("initializer list")
+    {
+        auto v = bitvector_t{true, false, true, true};
+        check_equal(v, {true, false, true, true});
+    }
+
+    SECTION("fill")
+    {
+        for (auto n : {0u, 1u, 63u, 64u, 65u, 5000u}) {
+            check_equal(bitvector_t(n), std::vector<bool>(n, false));
+            check_equal(bitvector_t(n, true), std::vector<bool>(n, true));
+        }
+    }
+}
+
+TEST_CASE("push back")
+{
+    for (auto n : {1u, 64u, 100u, 2048u, 2049u, 70000u}) {
+        auto bits = make_random(n, n);
+        check_equal(make_bitvector(bits), bits);
+
+        auto v = bitvector_t{};
+        for (auto b : bits)
+            v = v.push_back(b);
+        check_equal(v, bits);
+        CHECK(v == make_bitvector(bits));
+    }
+}
+
+TEST_CASE("set, reset and flip")
+{
+    const auto n = 10000u;
+    auto bits    = make_random(n, 1);
+    auto v       = make_bitvector(bits);
+
+    auto w = v;
+    for (auto i = 0u; i < n; i += 7) {
+        w       = w.set(i);
+        bits[i] = true;
+    }
+    for (auto i = 0u; i < n; i += 11) {
+        w       = std::move(w).reset(i);
+        bits[i] = false;
+    }
+    for (auto i = 0u; i < n; i += 13) {
+        w       = i % 2 ? w.flip(i) : std::move(w).flip(i);
+        bits[i] = !bits[i];
+    }
+    check_equal(w, bits);
+    check_equal(v, make_random(n, 1));
+    CHECK(v != w);
+    CHECK(w.at(7) == bits[7]);
+    CHECK_THROWS_AS(w.at(n), std::out_of_range);
+}
+
+TEST_CASE("find")
+{
+    auto v = bitvector_t(100000);
+    CHECK(v.find_first() == bitvector_t::npos);
+    v = v.set(99999);
+    CHECK(v.find_first() == 99999u);
+    CHECK(v.find_next(99999) == bitvector_t::npos);
+    v = v.set(64);
+    CHECK(v.find_first() == 64u);
+    CHECK(v.find_next(63) == 64u);
+    CHECK(v.find_next(64) == 99999u);
+    CHECK(v.any());
+
+    auto sparse = make_random(100000, 2, 0.001);
+    check_equal(make_bitvector(sparse), sparse);
+}
+
+TEST_CASE("bitwise operations")
+{
+    for (auto n : {0u, 1u, 64u, 2048u, 2100u, 100000u}) {
+        auto a  = make_random(n, 3);
+        auto b  = make_random(n, 4);
+        auto va = make_bitvector(a);
+        auto vb = make_bitvector(b);
+
+        auto r_and = std::vector<bool>(n);
+        auto r_or  = std::vector<bool>(n);
+        auto r_xor = std::vector<bool>(n);
+        for (auto i = 0u; i < n; ++i) {
+            r_and[i] = a[i] && b[i];
+            r_or[i]  = a[i] || b[i];
+            r_xor[i] = a[i] != b[i];
+        }
+        check_equal(va & vb, r_and);
+        check_equal(va | vb, r_or);
+        check_equal(va ^ vb, r_xor);
+        check_equal(va ^ va, std::vector<bool>(n, false));
+    }
+
+}
+
+TEST_CASE("bitwise operations share structure")
+{
+    const auto n = 1000000u;
+    auto a       = make_bitvector(make_random(n, 7));
+
+    SECTION("same")
+    {
+        CHECK((a & a).words().identity() == a.words().identity());
+        CHECK((a | a).words().identity() == a.words().identity());
+    }
+
+    SECTION("different tail")
+    {
+        auto b = a.flip(n - 1);
+        CHECK((a & b).words().impl().root == a.words().impl().root);
+        CHECK((a | b).words().impl().root == a.words().impl().root);
+        CHECK((a ^ b).words().impl().root != a.words().impl().root);
+        CHECK((a ^ b).count() == 1u);
+    }
+
+    SECTION("different leaf")
+    {
+        auto b     = a.set(10);
+        auto c     = a | b;
+        auto& root = a.words().impl().root;
+        CHECK(c.words().impl().root != root);
+        CHECK(c.words().impl().root->inner()[0] != root->inner()[0]);
+        CHECK(c.words().impl().root->inner()[1] == root->inner()[1]);
+        CHECK(c == b);
+        CHECK((a & b) == a);
+    }
+}
@@ -0,0 +1,296 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <immer/algorithm.hpp>
+#include <immer/compressed_vector.hpp>
+#include <immer/compressed_vector_transient.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+template <typename T>
+std::vector<T> make_monotonic(std::size_t n)
+{
+    auto r = std::vector<T>(n);
+    auto x = T{};
+    for (auto i = std::size_t{}; i < n; ++i) {
+        x += static_cast<T>(1 + i % 3);
+        r[i] = x;
+    }
+    return r;
+}
+
+template <typename T>
+std::vector<T> make_random(std::size_t n)
+{
+    auto gen  = std::mt19937_64{42};
+    auto dist = std::uniform_int_distribution<std::int64_t>{
+        std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
+    auto r    = std::vector<T>(n);
+    for (auto& x : r)
+        x = static_cast<T>(dist(gen));
+    return r;
+}
+
+template <>
+std::vector<std::uint64_t> make_random<std::uint64_t>(std::size_t n)
+{
+    auto gen = std::mt19937_64{42};
+    auto r   = std::vector<std::uint64_t>(n);
+    for (auto& x : r)
+        x = gen();
+    return r;
+}
+
+template <typename V, typename T>
+void check_equal(const V& v, const std::vector<T>& expected)
+{
+    REQUIRE(v.size() == expected.size());
+    for (auto i = std::size_t{}; i < v.size(); ++i)
+        CHECK(v[i] == expected[i]);
+    CHECK(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    CHECK(std::equal(
+        v.rbegin(), v.rend(), expected.rbegin(), expected.rend()));
+
+    auto chunked = std::vector<T>{};
+    immer::for_each_chunk(
+        v, [&](auto f, auto l) { chunked.insert(chunked.end(), f, l); });
+    CHECK(chunked == expected);
+}
+
+template <typename T>
+void check_roundtrip(const std::vector<T>& data)
+{
+    using vector_t = immer::compressed_vector<T>;
+
+    auto v = vector_t{data.begin(), data.end()};
+    check_equal(v, data);
+
+    auto w = vector_t{};
+    for (auto x : data)
+        w = w.push_back(x);
+    check_equal(w, data);
+    CHECK(v == w);
+
+    auto t = vector_t{}.transient();
+    for (auto x : data)
+        t.push_back(x);
+    CHECK(std::equal(t.begin(), t.end(), data.begin(), data.end()));
+    CHECK(std::equal(t.rbegin(), t.rend(), data.rbegin(), data.rend()));
+    check_equal(t.persistent(), data);
+}
+
+} // namespace
+
+TEST_CASE("instantiation")
+{
+    auto v = immer::compressed_vector<int>{};
+    CHECK(v.size() == 0u);
+    CHECK(v.empty());
+    CHECK(v.begin() == v.end());
+
+    auto w = immer::compressed_vector<int>{1, 2, 3};
+    CHECK(w.size() == 3u);
+    CHECK(w.front() == 1);
+    CHECK(w.back() == 3);
+}
+
+TEST_CASE("roundtrip")
+{
+    for (auto n : {0u, 1u, 2u, 127u, 128u, 129u, 1000u, 20000u}) {
+        check_roundtrip(make_monotonic<int>(n));
+        check_roundtrip(make_random<int>(n));
+        check_roundtrip(make_random<std::int8_t>(n));
+        check_roundtrip(make_random<std::int64_t>(n));
+        check_roundtrip(make_random<std::uint64_t>(n));
+        check_roundtrip(make_monotonic<std::uint16_t>(n));
+    }
+}
+
+TEST_CASE("negative and extreme values")
+{
+    using limits = std::numeric_limits<std::int64_t>;
+    auto data    = std::vector<std::int64_t>{};
+    for (auto i = 0; i < 1000; ++i)
+        data.push_back(i % 2 ? limits::min() + i : limits::max() - i);
+    check_roundtrip(data);
+
+    auto neg = std::vector<int>(1000);
+    std::iota(neg.begin(), neg.end(), -500);
+    std::reverse(neg.begin(), neg.end());
+    check_roundtrip(neg);
+}
+
+TEST_CASE("compression")
+{
+    SECTION("monotonic")
+    {
+        auto data = make_monotonic<std::uint64_t>(100000);
+        auto v    = immer::compressed_vector<std::uint64_t>{data.begin(),
+                                                         data.end()};
+        CHECK(v.data_bytes() * 10 < data.size() * sizeof(std::uint64_t));
+    }
+
+    SECTION("constant step")
+    {
+        auto data = std::vector<std::uint64_t>(100000);
+        std::iota(data.begin(), data.end(), 1000);
+        auto v = immer::compressed_vector<std::uint64_t>{data.begin(),
+                                                         data.end()};
+        CHECK(v.data_bytes() * 20 < data.size() * sizeof(std::uint64_t));
+    }
+}
+
+TEST_CASE("iterators")
+{
+    using vector_t = immer::compressed_vector<long>;
+    static_assert(sizeof(vector_t::iterator) <= 8 * sizeof(void*),
+                  "iterators do not hold decoded blocks");
+
+    const auto data = make_random<std::int64_t>(1000);
+    const auto v    = vector_t{data.begin(), data.end()};
+
+    SECTION("random access")
+    {
+        auto gen  = std::mt19937{42};
+        auto dist = std::uniform_int_distribution<std::size_t>{
+            0, data.size() - 1};
+        for (auto i = 0; i < 1000; ++i) {
+            auto idx = dist(gen);
+            auto it  = v.begin() + idx;
+            CHECK(*it == data[idx]);
+            CHECK(it[-static_cast<std::ptrdiff_t>(idx)] == data[0]);
+            if (idx > 0)
+                CHECK(*(it - 1) == data[idx - 1]);
+        }
+    }
+
+    SECTION("back and forth")
+    {
+        auto it = v.begin() + 500;
+        for (auto i = 500u; i < 700; ++i, ++it)
+            CHECK(*it == data[i]);
+        for (auto i = 700u; i > 300; --i, --it)
+            CHECK(*it == data[i]);
+    }
+
+    SECTION("transient")
+    {
+        auto t = v.transient();
+        t.set(10, 42);
+        auto expected = std::vector<long>(data.begin(), data.end());
+        expected[10]  = 42;
+        CHECK(std::equal(t.begin(), t.end(), expected.begin()));
+        CHECK(std::equal(t.rbegin(), t.rend(), expected.rbegin()));
+        CHECK(t.end() - t.begin() == static_cast<std::ptrdiff_t>(t.size()));
+    }
+}
+
+TEST_CASE("at")
+{
+    auto v = immer::compressed_vector<int>{1, 2, 3};
+    CHECK(v.at(2) == 3);
+    CHECK_THROWS_AS(v.at(3), std::out_of_range);
+}
+
+TEST_CASE("set and update")
+{
+    const auto n = 1000u;
+    auto data    = make_monotonic<int>(n);
+    auto v       = immer::compressed_vector<int>{data.begin(), data.end()};
+
+    SECTION("persistent")
+    {
+        auto w = v;
+        for (auto i = 0u; i < n; i += 13) {
+            w       = w.set(i, -static_cast<int>(i));
+            data[i] = -static_cast<int>(i);
+        }
+        check_equal(w, data);
+        CHECK(v != w);
+
+        auto u = v.update(500, [](int x) { return x * 1000; });
+        CHECK(u[500] == v[500] * 1000);
+        CHECK(u[499] == v[499]);
+        CHECK(u[501] == v[501]);
+    }
+
+    SECTION("move")
+    {
+        auto w = v;
+        for (auto i = 0u; i < n; i += 13) {
+            w       = std::move(w).update(i, [](int x) { return x + 1; });
+            data[i] = data[i] + 1;
+        }
+        check_equal(w, data);
+        check_equal(v, make_monotonic<int>(n));
+    }
+
+    SECTION("transient")
+    {
+        auto t = v.transient();
+        for (auto i = 0u; i < n; i += 13) {
+            t.set(i, 42);
+            data[i] = 42;
+        }
+        t.update(999, [](int x) { return x - 1; });
+        data[999] -= 1;
+        check_equal(t.persistent(), data);
+        check_equal(v, make_monotonic<int>(n));
+    }
+}
+
+TEST_CASE("take")
+{
+    const auto n = 1000u;
+    auto data    = make_random<int>(n);
+    auto v       = immer::compressed_vector<int>{data.begin(), data.end()};
+
+    for (auto i : {0u, 1u, 100u, 128u, 300u, 999u, 1000u, 2000u}) {
+        auto expected = std::vector<int>(
+            data.begin(), data.begin() + std::min<std::size_t>(i, n));
+        check_equal(v.take(i), expected);
+
+        auto t = v.transient();
+        t.take(i);
+        CHECK(t.size() == expected.size());
+        check_equal(t.persistent(), expected);
+
+        auto w = v.take(i);
+        for (auto x : {1, 2, 3})
+            w = std::move(w).push_back(x);
+        expected.insert(expected.end(), {1, 2, 3});
+        check_equal(w, expected);
+    }
+    check_equal(v, data);
+}
+
+TEST_CASE("algorithms")
+{
+    auto data = make_monotonic<std::int64_t>(10000);
+    auto v = immer::compressed_vector<std::int64_t>{data.begin(), data.end()};
+
+    CHECK(immer::accumulate(v, std::int64_t{}) ==
+          std::accumulate(data.begin(), data.end(), std::int64_t{}));
+    CHECK(
+        immer::accumulate(v.begin() + 100, v.begin() + 5000, std::int64_t{}) ==
+        std::accumulate(
+            data.begin() + 100, data.begin() + 5000, std::int64_t{}));
+    CHECK(immer::count_if(v, [](auto x) { return x % 2 == 0; }) ==
+          std::count_if(
+              data.begin(), data.end(), [](auto x) { return x % 2 == 0; }));
+    CHECK(immer::all_of(v, [](auto x) { return x > 0; }));
+}
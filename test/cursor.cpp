@@ -0,0 +1,120 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <immer/cursor.hpp>
+#include <immer/flex_vector.hpp>
+#include <immer/vector.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+template <typename V>
+V make_back(unsigned n)
+{
+    auto v = V{};
+    for (auto i = 0u; i < n; ++i)
+        v = std::move(v).push_back(i);
+    return v;
+}
+
+template <typename V>
+V make_relaxed(unsigned n)
+{
+    auto v = V{};
+    for (auto i = 0u; i < n; i += 5) {
+        auto chunk = V{};
+        for (auto j = i; j < std::min(i + 5, n); ++j)
+            chunk = std::move(chunk).push_back(j);
+        v = i % 2 ? v + chunk : v + chunk.push_front(0).drop(1);
+    }
+    return v;
+}
+
+template <typename V>
+void check_cursor(const V& v)
+{
+    auto c = immer::make_cursor(v);
+    CHECK(c.size() == v.size());
+    CHECK(c.index() == 0u);
+    CHECK(c.get() == v[0]);
+
+    for (auto i = 0u; i < v.size(); ++i)
+        CHECK(c[i] == v[i]);
+
+    for (auto i = v.size(); i-- > 0;) {
+        c.seek(i);
+        CHECK(c.index() == i);
+        CHECK(c.get() == v[i]);
+    }
+
+    auto gen  = std::mt19937{42};
+    auto dist = std::uniform_int_distribution<std::size_t>{0, v.size() - 1};
+    for (auto i = 0u; i < 1000; ++i) {
+        auto idx = dist(gen);
+        CHECK(c[idx] == v[idx]);
+    }
+
+    c.seek(0);
+    for (auto i = 0u; i + 3 < v.size(); i += 3) {
+        CHECK(c.get() == v[i]);
+        c.advance(3);
+    }
+}
+
+} // namespace
+
+TEST_CASE("cursor over vector")
+{
+    check_cursor(make_back<immer::vector<unsigned>>(1));
+    check_cursor(make_back<immer::vector<unsigned>>(666));
+    check_cursor(make_back<immer::vector<unsigned>>(5000));
+}
+
+TEST_CASE("cursor over deep vector")
+{
+    using vector_t =
+        immer::vector<unsigned, immer::default_memory_policy, 2, 2>;
+    check_cursor(make_back<vector_t>(1));
+    check_cursor(make_back<vector_t>(1000));
+}
+
+TEST_CASE("cursor over flex_vector")
+{
+    check_cursor(make_back<immer::flex_vector<unsigned>>(666));
+    check_cursor(make_relaxed<immer::flex_vector<unsigned>>(3));
+    check_cursor(make_relaxed<immer::flex_vector<unsigned>>(5000));
+}
+
+TEST_CASE("cursor over deep relaxed flex_vector")
+{
+    using vector_t =
+        immer::flex_vector<unsigned, immer::default_memory_policy, 2, 2>;
+    check_cursor(make_relaxed<vector_t>(1000));
+}
+
+TEST_CASE("cursor keeps the vector alive")
+{
+    auto c = immer::cursor<immer::flex_vector<unsigned>>{};
+    {
+        auto v = make_relaxed<immer::flex_vector<unsigned>>(1000);
+        c      = immer::make_cursor(v);
+    }
+    for (auto i = 0u; i < 1000; ++i)
+        CHECK(c[i] == i);
+}
+
+TEST_CASE("cursor over empty vector")
+{
+    auto c = immer::make_cursor(immer::vector<unsigned>{});
+    CHECK(c.size() == 0u);
+    CHECK(c.index() == 0u);
+}
@@ -0,0 +1,294 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <immer/algorithm.hpp>
+#include <immer/deque.hpp>
+#include <immer/deque_transient.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <deque>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+template <typename D>
+void check_equal(const D& d, const std::deque<int>& expected)
+{
+    REQUIRE(d.size() == expected.size());
+    for (auto i = std::size_t{}; i < d.size(); ++i)
+        CHECK(d[i] == expected[i]);
+    CHECK(std::equal(d.begin(), d.end(), expected.begin(), expected.end()));
+    CHECK(std::equal(
+        d.rbegin(), d.rend(), expected.rbegin(), expected.rend()));
+
+    auto chunked = std::deque<int>{};
+    immer::for_each_chunk(
+        d, [&](auto f, auto l) { chunked.insert(chunked.end(), f, l); });
+    CHECK(chunked == expected);
+    CHECK(immer::accumulate(d, 0) ==
+          std::accumulate(expected.begin(), expected.end(), 0));
+}
+
+} // namespace
+
+TEST_CASE("instantiation")
+{
+    auto d = immer::deque<int>{};
+    CHECK(d.size() == 0u);
+    CHECK(d.empty());
+    CHECK(d.begin() == d.end());
+
+    auto e = immer::deque<int>{1, 2, 3};
+    CHECK(e.size() == 3u);
+    CHECK(e.front() == 1);
+    CHECK(e.back() == 3);
+
+    auto f = immer::deque<int>(4u, 7);
+    check_equal(f, {7, 7, 7, 7});
+
+    auto g = immer::deque<int>{immer::flex_vector<int>{5, 6}};
+    check_equal(g, {5, 6});
+}
+
+TEST_CASE("push front")
+{
+    const auto n = 1000;
+    auto d       = immer::deque<int>{};
+    auto model   = std::deque<int>{};
+    auto olds    = std::vector<immer::deque<int>>{};
+    for (auto i = 0; i < n; ++i) {
+        olds.push_back(d);
+        d = d.push_front(i);
+        model.push_front(i);
+        CHECK(d.front() == i);
+        CHECK(d.back() == 0);
+    }
+    check_equal(d, model);
+    for (auto i = 0; i < n; ++i)
+        CHECK(olds[i].size() == static_cast<std::size_t>(i));
+    check_equal(olds[n / 2], {model.begin() + n / 2, model.end()});
+}
+
+TEST_CASE("pop front")
+{
+    const auto n = 1000;
+    auto model   = std::deque<int>(n);
+    std::iota(model.begin(), model.end(), 0);
+    auto d = immer::deque<int>{model.begin(), model.end()};
+    while (!d.empty()) {
+        CHECK(d.front() == model.front());
+        d = d.pop_front();
+        model.pop_front();
+        if (model.size() % 97 == 0)
+            check_equal(d, model);
+    }
+    CHECK(model.empty());
+}
+
+TEST_CASE("pop back reaching the head")
+{
+    auto d     = immer::deque<int>{};
+    auto model = std::deque<int>{};
+    for (auto i = 0; i < 300; ++i) {
+        d = d.push_front(i);
+        model.push_front(i);
+    }
+    while (!d.empty()) {
+        CHECK(d.back() == model.back());
+        d = d.pop_back();
+        model.pop_back();
+    }
+    check_equal(d, model);
+}
+
+TEST_CASE("random operations")
+{
+    auto gen   = std::mt19937{42};
+    auto op    = std::uniform_int_distribution<int>{0, 5};
+    auto d     = immer::deque<int>{};
+    auto model = std::deque<int>{};
+    for (auto i = 0; i < 20000; ++i) {
+        switch (op(gen)) {
+        case 0:
+        case 1:
+            d = d.push_front(i);
+            model.push_front(i);
+            break;
+        case 2:
+            d = std::move(d).push_back(i);
+            model.push_back(i);
+            break;
+        case 3:
+            if (!model.empty()) {
+                d = std::move(d).pop_front();
+                model.pop_front();
+            }
+            break;
+        case 4:
+            if (!model.empty()) {
+                d = d.pop_back();
+                model.pop_back();
+            }
+            break;
+        case 5:
+            if (!model.empty()) {
+                auto idx   = gen() % model.size();
+                d          = d.set(idx, -i);
+                model[idx] = -i;
+            }
+            break;
+        }
+        if (i % 1000 == 0)
+            check_equal(d, model);
+    }
+    check_equal(d, model);
+    check_equal(d.flex(), model);
+}
+
+TEST_CASE("alternating at the head boundary")
+{
+    auto model = std::deque<int>(1000);
+    std::iota(model.begin(), model.end(), 0);
+    auto d = immer::deque<int>{model.begin(), model.end()};
+
+    const auto capacity = std::decay_t<decltype(d.impl())>::head_capacity;
+    for (auto i = 0u; i < capacity; ++i) {
+        d = d.push_front(-1);
+        model.push_front(-1);
+    }
+    REQUIRE(d.impl().head.size() == capacity);
+
+    // Flushing and refilling the whole head would move elements between
+    // the head and the body twice in every round
+    auto t     = d.transient();
+    auto moves = 0;
+    auto step  = [&](auto next) {
+        if (next.impl().body.size() != d.impl().body.size())
+            ++moves;
+        d = std::move(next);
+    };
+    for (auto i = 0; i < 1000; ++i) {
+        step(d.push_front(i));
+        step(d.pop_front());
+        step(d.pop_front());
+        step(d.push_front(i));
+        t.push_front(i);
+        t.pop_front();
+        t.pop_front();
+        t.push_front(i);
+        model.pop_front();
+        model.push_front(i);
+    }
+    CHECK(moves <= 1);
+    check_equal(d, model);
+    check_equal(std::move(t).persistent(), model);
+}
+
+TEST_CASE("iterators")
+{
+    auto d = immer::deque<int>{};
+    for (auto i = 0; i < 100; ++i)
+        d = d.push_back(i).push_front(-i - 1);
+    CHECK(d.end() - d.begin() == 200);
+    CHECK(*(d.begin() + 50) == d[50]);
+    CHECK(*(d.begin() + 150) == d[150]);
+    CHECK(*(d.end() - 1) == d.back());
+    auto it = d.begin() + 120;
+    it -= 100;
+    CHECK(*it == d[20]);
+    CHECK(it[110] == d[130]);
+    check_equal(d, {d.begin(), d.end()});
+
+    auto sum = 0;
+    immer::for_each_chunk(d.begin() + 30, d.begin() + 170, [&](auto f, auto l) {
+        sum = std::accumulate(f, l, sum);
+    });
+    CHECK(sum == std::accumulate(d.begin() + 30, d.begin() + 170, 0));
+}
+
+TEST_CASE("at")
+{
+    auto d = immer::deque<int>{1, 2, 3}.push_front(0);
+    CHECK(d.at(0) == 0);
+    CHECK(d.at(3) == 3);
+    CHECK_THROWS_AS(d.at(4), std::out_of_range);
+}
+
+TEST_CASE("update")
+{
+    auto d = immer::deque<int>{1, 2, 3}.push_front(0);
+    auto e = d.update(0, [](int x) { return x + 10; });
+    auto f = std::move(e).update(2, [](int x) { return x * 10; });
+    check_equal(d, {0, 1, 2, 3});
+    check_equal(f, {10, 1, 20, 3});
+}
+
+TEST_CASE("equality")
+{
+    auto a = immer::deque<int>{};
+    auto b = immer::deque<int>{};
+    for (auto i = 0; i < 100; ++i) {
+        a = a.push_front(i);
+        b = b.push_back(99 - i);
+    }
+    CHECK(a == b);
+    CHECK(a == a.push_front(1).pop_front());
+    CHECK(a != a.set(50, -1));
+    CHECK(a != a.pop_back());
+    CHECK(a.flex() == b.flex());
+}
+
+TEST_CASE("transient")
+{
+    auto gen   = std::mt19937{13};
+    auto op    = std::uniform_int_distribution<int>{0, 4};
+    auto model = std::deque<int>{1, 2, 3};
+    auto d     = immer::deque<int>{1, 2, 3};
+    auto t     = d.transient();
+    for (auto i = 0; i < 10000; ++i) {
+        switch (op(gen)) {
+        case 0:
+        case 1:
+            t.push_front(i);
+            model.push_front(i);
+            break;
+        case 2:
+            t.push_back(i);
+            model.push_back(i);
+            break;
+        case 3:
+            if (!model.empty()) {
+                t.pop_front();
+                model.pop_front();
+            }
+            break;
+        case 4:
+            if (!model.empty()) {
+                t.pop_back();
+                model.pop_back();
+            }
+            break;
+        }
+        if (!model.empty() && i % 7 == 0) {
+            auto idx = gen() % model.size();
+            t.update(idx, [](int x) { return x + 1; });
+            model[idx] += 1;
+        }
+        if (i % 1000 == 0)
+            check_equal(t.persistent(), model);
+    }
+    CHECK(t.size() == model.size());
+    check_equal(t.persistent(), model);
+    check_equal(d, {1, 2, 3});
+    check_equal(std::move(t).persistent(), model);
+}
@@ -8,7 +8,10 @@
 #include <immer/extra/cereal/immer_vector.hpp>
 #include <immer/extra/persist/detail/cereal/compact_map.hpp>
 
+#include <cereal/archives/binary.hpp>
 #include <cereal/archives/json.hpp>
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/string.hpp>
 
 #include <nlohmann/json.hpp>
 
@@ -134,8 +137,111 @@ struct non_empty_default
     }
 };
 
+template <class OutputArchive, class InputArchive, class T>
+T binary_round_trip(const T& value)
+{
+    auto os = std::ostringstream{};
+    {
+        auto ar = OutputArchive{os};
+        ar(value);
+    }
+    auto is     = std::istringstream{os.str()};
+    auto ar     = InputArchive{is};
+    auto result = T{};
+    ar(result);
+    return result;
+}
+
+template <class Container>
+std::string save_binary(const Container& value)
+{
+    auto os = std::ostringstream{};
+    {
+        auto ar = cereal::BinaryOutputArchive{os};
+        ar(value);
+    }
+    return os.str();
+}
+
+template <class Container>
+std::string save_binary_elementwise(const Container& value)
+{
+    auto os = std::ostringstream{};
+    {
+        auto ar = cereal::BinaryOutputArchive{os};
+        ar(cereal::make_size_tag(static_cast<cereal::size_type>(value.size())));
+        for (const auto& v : value)
+            ar(v);
+    }
+    return os.str();
+}
+
 } // namespace
 
+TEST_CASE("Test binary archives with chunks of arithmetic values")
+{
+    auto vec  = immer::vector<int>{};
+    auto flex = immer::flex_vector<std::uint16_t>{};
+    for (auto i = 0; i < 1000; ++i) {
+        // Concatenating makes the flex vector relaxed, with uneven leaves
+        const auto x = static_cast<std::uint16_t>(i);
+        vec          = std::move(vec).push_back(i * 3);
+        flex =
+            std::move(flex).push_back(x) + immer::flex_vector<std::uint16_t>{x};
+    }
+    const auto arr = immer::array<double>{1.5, -2.0, 3.25};
+    const auto strings = immer::vector<std::string>{"one", "two", "three"};
+
+    SECTION("the format is the same as saving element by element")
+    {
+        REQUIRE(save_binary(vec) == save_binary_elementwise(vec));
+        REQUIRE(save_binary(flex) == save_binary_elementwise(flex));
+        REQUIRE(save_binary(arr) == save_binary_elementwise(arr));
+    }
+
+    SECTION("binary archive")
+    {
+        using out_t = cereal::BinaryOutputArchive;
+        using in_t  = cereal::BinaryInputArchive;
+        REQUIRE(binary_round_trip<out_t, in_t>(vec) == vec);
+        REQUIRE(binary_round_trip<out_t, in_t>(flex) == flex);
+        REQUIRE(binary_round_trip<out_t, in_t>(arr) == arr);
+        REQUIRE(binary_round_trip<out_t, in_t>(strings) == strings);
+        REQUIRE(binary_round_trip<out_t, in_t>(immer::vector<int>{}).empty());
+    }
+
+    SECTION("loaded leaves are full and can be appended to")
+    {
+        using out_t = cereal::BinaryOutputArchive;
+        using in_t  = cereal::BinaryInputArchive;
+        const auto loaded_vec  = binary_round_trip<out_t, in_t>(vec);
+        const auto loaded_flex = binary_round_trip<out_t, in_t>(flex);
+        REQUIRE(loaded_flex.get_debug_stats().relaxed_nodes == 0);
+        REQUIRE(loaded_flex.get_debug_stats().leaves ==
+                flex.compact().get_debug_stats().leaves);
+
+        auto more_vec  = loaded_vec;
+        auto more_flex = loaded_flex;
+        for (auto i = 0; i < 100; ++i) {
+            more_vec  = std::move(more_vec).push_back(i);
+            more_flex = std::move(more_flex).push_back(i);
+        }
+        REQUIRE(loaded_vec == vec);
+        REQUIRE(loaded_flex == flex);
+        REQUIRE(more_vec.size() == vec.size() + 100);
+        REQUIRE(more_flex.size() == flex.size() + 100);
+    }
+
+    SECTION("portable binary archive")
+    {
+        using out_t = cereal::PortableBinaryOutputArchive;
+        using in_t  = cereal::PortableBinaryInputArchive;
+        REQUIRE(binary_round_trip<out_t, in_t>(vec) == vec);
+        REQUIRE(binary_round_trip<out_t, in_t>(flex) == flex);
+        REQUIRE(binary_round_trip<out_t, in_t>(arr) == arr);
+    }
+}
+
 TEST_CASE("Test loading struct with non-empty containers")
 {
     // Create some non-default data
@@ -0,0 +1,225 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <immer/extra/persist/transform.hpp>
+
+#include "utils.hpp"
+
+#define DEFINE_OPERATIONS(name)                                                \
+    friend bool operator==(const name& left, const name& right)                \
+    {                                                                          \
+        return members(left) == members(right);                                \
+    }                                                                          \
+    template <class Archive>                                                   \
+    void serialize(Archive& ar)                                                \
+    {                                                                          \
+        serialize_members(ar, *this);                                          \
+    }                                                                          \
+    static_assert(true, "require semicolon")
+
+namespace {
+
+using test::flex_vector_one;
+using test::members;
+using test::serialize_members;
+using test::vector_one;
+
+template <class T>
+struct dedup_policy
+    : immer::persist::hana_struct_auto_member_name_policy_t<T>
+    , immer::persist::content_dedup_t
+{};
+
+struct two_vectors
+{
+    BOOST_HANA_DEFINE_STRUCT(two_vectors,
+                             (vector_one<int>, first),
+                             (vector_one<int>, second));
+
+    DEFINE_OPERATIONS(two_vectors);
+};
+
+struct two_flex_vectors
+{
+    BOOST_HANA_DEFINE_STRUCT(two_flex_vectors,
+                             (flex_vector_one<std::string>, first),
+                             (flex_vector_one<std::string>, second));
+
+    DEFINE_OPERATIONS(two_flex_vectors);
+};
+
+struct two_maps
+{
+    BOOST_HANA_DEFINE_STRUCT(two_maps,
+                             (immer::map<std::string, int>, first),
+                             (immer::map<std::string, int>, second));
+
+    DEFINE_OPERATIONS(two_maps);
+};
+
+struct three_maps
+{
+    BOOST_HANA_DEFINE_STRUCT(three_maps,
+                             (immer::map<std::string, int>, first),
+                             (immer::map<std::string, int>, second),
+                             (immer::map<std::string, int>, third));
+
+    DEFINE_OPERATIONS(three_maps);
+};
+
+template <class Container>
+Container make_strings(int count)
+{
+    auto result = Container{};
+    for (int i = 0; i < count; ++i) {
+        result = std::move(result).push_back(std::to_string(i));
+    }
+    return result;
+}
+
+immer::map<std::string, int> make_map(int count)
+{
+    auto result = immer::map<std::string, int>{};
+    for (int i = 0; i < count; ++i) {
+        result = std::move(result).set(std::to_string(i), i);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Content dedup: equal vectors built independently")
+{
+    const auto value = two_vectors{
+        .first  = test::gen(vector_one<int>{}, 20),
+        .second = test::gen(vector_one<int>{}, 20),
+    };
+    REQUIRE(value.first.identity() != value.second.identity());
+
+    const auto default_policy =
+        immer::persist::hana_struct_auto_member_name_policy(value);
+    const auto policy = dedup_policy<two_vectors>{};
+
+    const auto default_pools =
+        immer::persist::get_output_pools(value, default_policy);
+    const auto pools = immer::persist::get_output_pools(value, policy);
+    const auto& default_pool =
+        default_pools.get_output_pool<vector_one<int>>();
+    const auto& pool = pools.get_output_pool<vector_one<int>>();
+    REQUIRE(pool.vectors.size() == 1);
+    REQUIRE(pool.leaves.size() * 2 == default_pool.leaves.size());
+    REQUIRE(pool.inners.size() * 2 == default_pool.inners.size());
+
+    const auto json_str = immer::persist::cereal_save_with_pools(value, policy);
+    REQUIRE(json_str.size() <
+            immer::persist::cereal_save_with_pools(value, default_policy)
+                .size());
+
+    const auto loaded =
+        immer::persist::cereal_load_with_pools<two_vectors>(json_str, policy);
+    REQUIRE(loaded == value);
+    REQUIRE(loaded.first.identity() == loaded.second.identity());
+}
+
+TEST_CASE("Content dedup: vectors sharing part of their content")
+{
+    const auto first = test::gen(vector_one<int>{}, 20);
+    const auto value = two_vectors{
+        .first  = first,
+        .second = test::gen(vector_one<int>{}, 20).set(0, 42),
+    };
+
+    const auto policy    = dedup_policy<two_vectors>{};
+    const auto pools     = immer::persist::get_output_pools(value, policy);
+    const auto pools_one = immer::persist::get_output_pools(
+        two_vectors{.first = first, .second = first}, policy);
+    const auto& pool     = pools.get_output_pool<vector_one<int>>();
+    const auto& pool_one = pools_one.get_output_pool<vector_one<int>>();
+    // Only the path to the modified leaf is saved again
+    REQUIRE(pool.vectors.size() == 2);
+    REQUIRE(pool.leaves.size() > pool_one.leaves.size());
+    REQUIRE(pool.leaves.size() < 2 * pool_one.leaves.size());
+
+    const auto json_str = immer::persist::cereal_save_with_pools(value, policy);
+    const auto loaded =
+        immer::persist::cereal_load_with_pools<two_vectors>(json_str, policy);
+    REQUIRE(loaded == value);
+}
+
+TEST_CASE("Content dedup: flex vectors of strings")
+{
+    const auto value = two_flex_vectors{
+        .first = make_strings<flex_vector_one<std::string>>(5) +
+                 make_strings<flex_vector_one<std::string>>(7),
+        .second = make_strings<flex_vector_one<std::string>>(5) +
+                  make_strings<flex_vector_one<std::string>>(7),
+    };
+    const auto policy = dedup_policy<two_flex_vectors>{};
+
+    const auto json_str = immer::persist::cereal_save_with_pools(value, policy);
+    const auto loaded =
+        immer::persist::cereal_load_with_pools<two_flex_vectors>(json_str,
+                                                                 policy);
+    REQUIRE(loaded == value);
+    REQUIRE(loaded.first.identity() == loaded.second.identity());
+}
+
+TEST_CASE("Content dedup: equal maps built independently")
+{
+    const auto value = two_maps{
+        .first  = make_map(100),
+        .second = make_map(100),
+    };
+    REQUIRE(value.first.identity() != value.second.identity());
+
+    const auto default_policy =
+        immer::persist::hana_struct_auto_member_name_policy(value);
+    const auto policy = dedup_policy<two_maps>{};
+
+    const auto default_pools =
+        immer::persist::get_output_pools(value, default_policy);
+    const auto pools = immer::persist::get_output_pools(value, policy);
+    const auto& default_pool =
+        default_pools.get_output_pool<immer::map<std::string, int>>();
+    const auto& pool = pools.get_output_pool<immer::map<std::string, int>>();
+    REQUIRE(pool.nodes.inners.size() * 2 == default_pool.nodes.inners.size());
+
+    const auto json_str = immer::persist::cereal_save_with_pools(value, policy);
+    const auto loaded =
+        immer::persist::cereal_load_with_pools<two_maps>(json_str, policy);
+    REQUIRE(loaded == value);
+    REQUIRE(loaded.first.identity() == loaded.second.identity());
+}
+
+TEST_CASE("Content dedup: maps that only differ in their mapped values")
+{
+    // The nodes holding the key "0" in `first` and `second` have the same
+    // keys but different values, they must not hide that `second` and
+    // `third` are equal.
+    const auto value = three_maps{
+        .first  = make_map(100),
+        .second = make_map(100).set("0", -1),
+        .third  = make_map(100).set("0", -1),
+    };
+    REQUIRE(value.second.identity() != value.third.identity());
+
+    const auto policy = dedup_policy<three_maps>{};
+    const auto pools  = immer::persist::get_output_pools(value, policy);
+    const auto& pool = pools.get_output_pool<immer::map<std::string, int>>();
+
+    const auto two_value = two_maps{
+        .first  = value.first,
+        .second = value.second,
+    };
+    const auto two_pools = immer::persist::get_output_pools(
+        two_value, dedup_policy<two_maps>{});
+    const auto& two_pool =
+        two_pools.get_output_pool<immer::map<std::string, int>>();
+    REQUIRE(pool.nodes.inners.size() == two_pool.nodes.inners.size());
+
+    const auto json_str = immer::persist::cereal_save_with_pools(value, policy);
+    const auto loaded =
+        immer::persist::cereal_load_with_pools<three_maps>(json_str, policy);
+    REQUIRE(loaded == value);
+    REQUIRE(loaded.second.identity() == loaded.third.identity());
+    REQUIRE(loaded.first.identity() != loaded.second.identity());
+}
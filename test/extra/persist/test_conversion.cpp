@@ -2,8 +2,14 @@
 
 #include <immer/extra/persist/cereal/save.hpp>
 #include <immer/extra/persist/detail/type_traverse.hpp>
+#include <immer/extra/persist/hash_container_conversion.hpp>
 #include <immer/extra/persist/transform.hpp>
 
+#include <immer/array.hpp>
+#include <immer/box.hpp>
+#include <immer/map.hpp>
+#include <immer/set.hpp>
+
 #include "utils.hpp"
 
 #define DEFINE_OPERATIONS(name)                                                \
@@ -189,6 +195,136 @@ TEST_CASE("Convert between two hierarchies via JSON compatibility",
     }
 }
 
+TEST_CASE("Convert between two hierarchies in parallel", "[conversion]")
+{
+    const auto value       = model::make_example_history();
+    const auto model_pools = immer::persist::get_output_pools(value);
+
+    const auto map = hana::make_map(
+        hana::make_pair(hana::type_c<vector_one<model::snapshot>>,
+                        [](model::snapshot old, const auto& convert_container) {
+                            const auto format_tracks = convert_container(
+                                hana::type_c<vector_one<format::track_id>>,
+                                old.arr.tracks);
+                            return format::snapshot{.arr = format::arrangement{
+                                                        .tracks = format_tracks,
+                                                    }};
+                        }),
+        hana::make_pair(hana::type_c<vector_one<model::track_id>>,
+                        [](model::track_id old) { //
+                            return format::track_id{old.tid};
+                        })
+
+    );
+    auto sequential_pools =
+        immer::persist::transform_output_pool(model_pools, map);
+    auto parallel_pools = immer::persist::transform_output_pool(
+        model_pools, map, immer::persist::parallel_options{.threads = 4,
+                                                            .grain   = 1});
+
+    const auto sequential = immer::persist::convert_container(
+        model_pools, sequential_pools, value.snapshots);
+    const auto parallel = immer::persist::convert_container(
+        model_pools, parallel_pools, value.snapshots);
+    REQUIRE(parallel == sequential);
+    REQUIRE(test::to_json(parallel) == test::to_json(value.snapshots));
+}
+
+namespace {
+struct champs_and_boxes
+{
+    BOOST_HANA_DEFINE_STRUCT(champs_and_boxes, //
+                             (immer::map<int, std::string>, map),
+                             (immer::set<int>, set),
+                             (immer::box<int>, box),
+                             (immer::array<int>, array));
+
+    DEFINE_OPERATIONS(champs_and_boxes);
+};
+
+champs_and_boxes make_champs_and_boxes()
+{
+    auto value = champs_and_boxes{.box = 42};
+    for (auto i = 0; i < 1000; ++i) {
+        value.map   = std::move(value.map).set(i, fmt::format("{}", i));
+        value.set   = std::move(value.set).insert(i * 7);
+        value.array = std::move(value.array).push_back(i);
+    }
+    return value;
+}
+} // namespace
+
+TEST_CASE("Convert maps and sets with a changed hash in parallel",
+          "[conversion]")
+{
+    const auto value = make_champs_and_boxes();
+    const auto pools = immer::persist::get_output_pools(value);
+
+    const auto map = hana::make_map(
+        hana::make_pair(
+            hana::type_c<immer::map<int, std::string>>,
+            hana::overload(
+                [](const std::pair<int, std::string>& old) {
+                    return std::make_pair(fmt::format("_{}_", old.first),
+                                          old.second);
+                },
+                [](immer::persist::target_container_type_request) {
+                    return immer::persist::incompatible_hash_wrapper<
+                        immer::map<std::string, std::string>>{};
+                })),
+        hana::make_pair(
+            hana::type_c<immer::set<int>>,
+            hana::overload(
+                [](int old) { return fmt::format("_{}_", old); },
+                [](immer::persist::target_container_type_request) {
+                    return immer::persist::incompatible_hash_wrapper<
+                        immer::set<std::string>>{};
+                })),
+        hana::make_pair(hana::type_c<immer::box<int>>,
+                        [](int old) { return old * 10; }),
+        hana::make_pair(hana::type_c<immer::array<int>>,
+                        [](int old) { return old * 10; })
+
+    );
+    auto sequential_pools = immer::persist::transform_output_pool(pools, map);
+    auto parallel_pools   = immer::persist::transform_output_pool(
+        pools, map, immer::persist::parallel_options{.threads = 4, .grain = 1});
+
+    const auto convert = [&](auto& load_pools, const auto& container) {
+        return immer::persist::convert_container(pools, load_pools, container);
+    };
+
+    SECTION("maps")
+    {
+        const auto parallel = convert(parallel_pools, value.map);
+        REQUIRE(parallel == convert(sequential_pools, value.map));
+        REQUIRE(parallel.size() == value.map.size());
+        REQUIRE(parallel["_123_"] == "123");
+        REQUIRE(convert(parallel_pools, value.map).identity() ==
+                parallel.identity());
+    }
+    SECTION("sets")
+    {
+        const auto parallel = convert(parallel_pools, value.set);
+        REQUIRE(parallel == convert(sequential_pools, value.set));
+        REQUIRE(parallel.size() == value.set.size());
+        REQUIRE(parallel.count("_7_"));
+    }
+    SECTION("boxes")
+    {
+        const auto parallel = convert(parallel_pools, value.box);
+        REQUIRE(parallel == convert(sequential_pools, value.box));
+        REQUIRE(parallel.get() == 420);
+    }
+    SECTION("arrays")
+    {
+        const auto parallel = convert(parallel_pools, value.array);
+        REQUIRE(parallel == convert(sequential_pools, value.array));
+        REQUIRE(parallel.size() == value.array.size());
+        REQUIRE(parallel[999] == 9990);
+    }
+}
+
 namespace {
 struct two_vectors
 {
@@ -0,0 +1,296 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <immer/extra/persist/cereal/load.hpp>
+#include <immer/extra/persist/cereal/save.hpp>
+#include <immer/extra/persist/detail/common/value_codec.hpp>
+#include <immer/extra/persist/errors.hpp>
+
+#include "utils.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+using json_t = nlohmann::json;
+
+using immer::persist::detail::codec_buffers;
+using immer::persist::detail::decode_values;
+using immer::persist::detail::encode_values;
+
+template <class T>
+std::vector<T> round_trip(const std::vector<T>& values,
+                          codec_buffers& buffers,
+                          std::size_t* words_size = nullptr)
+{
+    auto words = std::vector<std::uint64_t>{};
+    encode_values(values.data(), values.data() + values.size(), buffers, words);
+    if (words_size)
+        *words_size = words.size();
+    auto result = std::vector<T>{};
+    REQUIRE(decode_values(
+        words.data(), words.data() + words.size(), buffers, result));
+    return result;
+}
+
+template <class T>
+std::vector<T> round_trip(const std::vector<T>& values,
+                          std::size_t* words_size = nullptr)
+{
+    auto buffers = codec_buffers{};
+    return round_trip(values, buffers, words_size);
+}
+
+template <class T>
+struct compress_policy
+    : immer::persist::hana_struct_auto_member_name_policy_t<T>
+    , immer::persist::compress_values_t
+{};
+
+struct numbers
+{
+    BOOST_HANA_DEFINE_STRUCT(numbers,
+                             (immer::vector<std::uint64_t>, ids),
+                             (immer::flex_vector<std::int32_t>, deltas),
+                             (immer::map<std::uint32_t, double>, prices),
+                             (immer::vector<std::string>, names));
+
+    friend bool operator==(const numbers& left, const numbers& right)
+    {
+        return test::members(left) == test::members(right);
+    }
+
+    template <class Archive>
+    void serialize(Archive& ar)
+    {
+        test::serialize_members(ar, *this);
+    }
+};
+
+numbers make_numbers(int count)
+{
+    auto value = numbers{};
+    for (int i = 0; i < count; ++i) {
+        value.ids    = std::move(value.ids).push_back(1000000000000u + 3 * i);
+        value.deltas = std::move(value.deltas).push_back(i % 2 ? -i : i);
+        value.prices = std::move(value.prices).set(i, i * 0.5);
+        value.names  = std::move(value.names).push_back(std::to_string(i));
+    }
+    return value;
+}
+
+} // namespace
+
+TEST_CASE("Value codec: empty and single values")
+{
+    CHECK(round_trip(std::vector<int>{}).empty());
+    CHECK(round_trip(std::vector<int>{42}) == std::vector<int>{42});
+}
+
+TEST_CASE("Value codec: constant values take no packed words")
+{
+    auto size         = std::size_t{};
+    const auto values = std::vector<std::uint64_t>(32, 123456789);
+    CHECK(round_trip(values, &size) == values);
+    // count, header and base
+    CHECK(size == 3);
+}
+
+TEST_CASE("Value codec: long constant values are packed")
+{
+    using immer::persist::detail::codec::max_constant_count;
+    auto size         = std::size_t{};
+    const auto values = std::vector<std::int32_t>(max_constant_count + 1, -7);
+    CHECK(round_trip(values, &size) == values);
+    CHECK(size > 3);
+    CHECK(size < values.size() / 32);
+}
+
+TEST_CASE("Value codec: sorted values use few bits")
+{
+    auto size   = std::size_t{};
+    auto values = std::vector<std::uint64_t>{};
+    for (auto i = 0u; i < 32; ++i)
+        values.push_back(1000000000000u + 7 * i);
+    CHECK(round_trip(values, &size) == values);
+    CHECK(size < values.size() / 4);
+}
+
+TEST_CASE("Value codec: extreme values")
+{
+    using limits   = std::numeric_limits<std::int64_t>;
+    using ulimits  = std::numeric_limits<std::uint64_t>;
+    const auto s64 = std::vector<std::int64_t>{
+        limits::min(), limits::max(), 0, -1, 1, limits::min(), limits::max()};
+    CHECK(round_trip(s64) == s64);
+
+    const auto u64 =
+        std::vector<std::uint64_t>{0, ulimits::max(), 1, ulimits::max() - 1};
+    CHECK(round_trip(u64) == u64);
+
+    const auto s8 = std::vector<std::int8_t>{-128, 127, 0, -1, 5, -5};
+    CHECK(round_trip(s8) == s8);
+}
+
+TEST_CASE("Value codec: floating point values")
+{
+    const auto doubles = std::vector<double>{
+        0.0, -0.0, 1.5, -1e300, std::numeric_limits<double>::infinity()};
+    const auto loaded = round_trip(doubles);
+    REQUIRE(loaded.size() == doubles.size());
+    for (auto i = std::size_t{}; i < doubles.size(); ++i) {
+        CHECK(std::memcmp(&loaded[i], &doubles[i], sizeof(double)) == 0);
+    }
+
+    const auto floats = std::vector<float>{0.25f, -3.0f, 1e30f};
+    CHECK(round_trip(floats) == floats);
+}
+
+TEST_CASE("Value codec: pairs")
+{
+    auto values = std::vector<std::pair<std::uint32_t, double>>{};
+    for (auto i = 0u; i < 40; ++i)
+        values.emplace_back(i * 11, i / 3.0);
+    CHECK(round_trip(values) == values);
+}
+
+TEST_CASE("Value codec: reused buffers")
+{
+    auto buffers = codec_buffers{};
+    auto big     = std::vector<std::pair<std::int64_t, std::uint32_t>>{};
+    for (auto i = 0; i < 64; ++i)
+        big.emplace_back(-1000 * i, i * 7);
+    CHECK(round_trip(big, buffers) == big);
+
+    const auto small = std::vector<std::pair<std::int64_t, std::uint32_t>>{
+        {5, 1}, {-5, 2}};
+    CHECK(round_trip(small, buffers) == small);
+    const auto single = std::vector<std::int64_t>{-3};
+    CHECK(round_trip(single, buffers) == single);
+}
+
+TEST_CASE("Value codec: malformed input")
+{
+    auto buffers = codec_buffers{};
+    auto words   = std::vector<std::uint64_t>{};
+    auto out     = std::vector<int>{};
+    CHECK_FALSE(decode_values(words.data(), words.data(), buffers, out));
+
+    const auto values = std::vector<int>{1, 1000, -1000000};
+    encode_values(values.data(), values.data() + values.size(), buffers, words);
+    CHECK_FALSE(decode_values(
+        words.data(), words.data() + words.size() - 1, buffers, out));
+
+    words.push_back(0);
+    CHECK_FALSE(decode_values(
+        words.data(), words.data() + words.size(), buffers, out));
+}
+
+TEST_CASE("Value codec: malformed counts do not allocate")
+{
+    using immer::persist::detail::codec::max_constant_count;
+    auto buffers = codec_buffers{};
+    auto out     = std::vector<std::uint64_t>{};
+
+    // a constant column claiming more values than allowed
+    const auto constant = std::vector<std::uint64_t>{1u << 27, 0, 42};
+    CHECK_FALSE(decode_values(
+        constant.data(), constant.data() + constant.size(), buffers, out));
+    const auto too_long =
+        std::vector<std::uint64_t>{max_constant_count + 1, 0, 42};
+    CHECK_FALSE(decode_values(
+        too_long.data(), too_long.data() + too_long.size(), buffers, out));
+
+    // packed columns claiming more values than the words can hold
+    const auto packed = std::vector<std::uint64_t>{1u << 27, 1 << 1, 42, 0};
+    CHECK_FALSE(decode_values(
+        packed.data(), packed.data() + packed.size(), buffers, out));
+    const auto overflow =
+        std::vector<std::uint64_t>{~std::uint64_t{} / 2, 64 << 1, 42, 0};
+    CHECK_FALSE(decode_values(
+        overflow.data(), overflow.data() + overflow.size(), buffers, out));
+    const auto wide = std::vector<std::uint64_t>{2, 65 << 1, 42, 0};
+    CHECK_FALSE(decode_values(
+        wide.data(), wide.data() + wide.size(), buffers, out));
+
+    CHECK(out.empty());
+    CHECK(buffers.lanes.capacity() < max_constant_count);
+}
+
+TEST_CASE("Value codec: save and load with pools")
+{
+    const auto value = make_numbers(200);
+
+    const auto default_policy =
+        immer::persist::hana_struct_auto_member_name_policy(value);
+    const auto policy = compress_policy<numbers>{};
+
+    const auto json_str = immer::persist::cereal_save_with_pools(value, policy);
+    REQUIRE(json_str.size() <
+            immer::persist::cereal_save_with_pools(value, default_policy)
+                .size());
+
+    const auto loaded =
+        immer::persist::cereal_load_with_pools<numbers>(json_str, policy);
+    REQUIRE(loaded == value);
+}
+
+TEST_CASE("Value codec: malformed values in pools")
+{
+    const auto value  = make_numbers(200);
+    const auto policy = compress_policy<numbers>{};
+    auto json =
+        json_t::parse(immer::persist::cereal_save_with_pools(value, policy));
+    // A single word with all bits set
+    const auto garbage = json_t("//////////8=");
+
+    SECTION("vector leaf")
+    {
+        auto& leaf     = json["pools"]["ids"]["leaves"][0];
+        leaf[1]        = garbage;
+        const auto str = json.dump();
+        REQUIRE_THROWS_WITH(
+            immer::persist::cereal_load_with_pools<numbers>(str, policy),
+            fmt::format("Node ID {} in pool ids has malformed compressed "
+                        "values",
+                        leaf[0].get<std::size_t>()));
+    }
+
+    SECTION("map node")
+    {
+        json["pools"]["prices"][0]["values"] = garbage;
+        const auto str                       = json.dump();
+        REQUIRE_THROWS_AS(
+            immer::persist::cereal_load_with_pools<numbers>(str, policy),
+            immer::persist::invalid_compressed_values);
+    }
+}
+
+TEST_CASE("Value codec: compressed values are smaller in JSON")
+{
+    // Values that the codec can not pack into fewer bits, so that only the
+    // way the words are written to the JSON makes a difference.
+    auto value = numbers{};
+    auto x     = std::uint64_t{1};
+    for (int i = 0; i < 1000; ++i) {
+        x         = x * 6364136223846793005u + 1442695040888963407u;
+        value.ids = std::move(value.ids).push_back(x);
+    }
+
+    const auto default_policy =
+        immer::persist::hana_struct_auto_member_name_policy(value);
+    const auto policy = compress_policy<numbers>{};
+
+    const auto json_str = immer::persist::cereal_save_with_pools(value, policy);
+    const auto default_str =
+        immer::persist::cereal_save_with_pools(value, default_policy);
+    CHECK(json_str.size() < default_str.size() * 2 / 3);
+    CHECK(json_t::parse(json_str)["pools"]["ids"]["leaves"][0][1].is_string());
+
+    const auto loaded =
+        immer::persist::cereal_load_with_pools<numbers>(json_str, policy);
+    REQUIRE(loaded == value);
+}
@@ -626,3 +626,131 @@ TEST_CASE("exception safety relaxed")
         IMMER_TRACE_E(d.happenings);
     }
 }
+
+TEST_CASE("compact")
+{
+    using vektor_t = FLEX_VECTOR_T<unsigned>;
+    const auto n   = 666u;
+
+    SECTION("regular")
+    {
+        auto v = make_test_flex_vector(0, n);
+        auto c = v.compact();
+        CHECK(c.identity() == v.identity());
+        CHECK(v.get_debug_stats().relaxed_nodes == 0);
+        CHECK(v.get_debug_stats().leaf_fill() == 1);
+    }
+
+    SECTION("empty")
+    {
+        auto c = vektor_t{}.compact();
+        CHECK(c.size() == 0);
+        CHECK(c.get_debug_stats().leaves == 0);
+    }
+
+    SECTION("push front")
+    {
+        auto v = make_test_flex_vector_front(0, n);
+        CHECK(v.get_debug_stats().relaxed_ratio() > 0);
+        auto c = v.compact();
+        CHECK_VECTOR_EQUALS(c, boost::irange(0u, n));
+        CHECK(c.get_debug_stats().relaxed_nodes == 0);
+        CHECK(c.get_debug_stats().leaf_fill() == 1);
+        CHECK(c.compact().identity() == c.identity());
+        CHECK_VECTOR_EQUALS(c.push_back(n), boost::irange(0u, n + 1));
+    }
+
+    SECTION("concat")
+    {
+        auto v = vektor_t{};
+        for (auto i = 0u; i < n; i += 7)
+            v = v + make_test_flex_vector(i, std::min(i + 7, n));
+        auto c = v.compact();
+        CHECK_VECTOR_EQUALS(c, boost::irange(0u, n));
+        CHECK_VECTOR_EQUALS(v, boost::irange(0u, n));
+        CHECK(c.get_debug_stats().relaxed_nodes == 0);
+    }
+
+    SECTION("concat aligned")
+    {
+        auto l = make_test_flex_vector(0, n);
+        auto v = l + l.push_back(42) + l;
+        auto c = v.compact();
+        CHECK_VECTOR_EQUALS(c.take(n), boost::irange(0u, n));
+        CHECK(c[n] == 0);
+        CHECK(c[2 * n] == 42);
+        CHECK(c.size() == 3 * n + 1);
+        CHECK(c == v);
+        CHECK(c.get_debug_stats().relaxed_nodes == 0);
+    }
+}
+
+TEST_CASE("debug stats")
+{
+    const auto n = 666u;
+
+    SECTION("empty")
+    {
+        auto s = FLEX_VECTOR_T<unsigned>{}.get_debug_stats();
+        CHECK(s.size == 0);
+        CHECK(s.depth == 0);
+        CHECK(s.leaves == 0);
+        CHECK(s.inner_nodes == 0);
+        CHECK(s.tail_size == 0);
+        CHECK(s.tail_fill() == 0);
+    }
+
+    SECTION("vector")
+    {
+        auto v = make_test_flex_vector<VECTOR_T<unsigned>>(0, n);
+        auto s = v.get_debug_stats();
+        CHECK(s.size == n);
+        CHECK(s.relaxed_nodes == 0);
+        CHECK(s.relaxed_bytes == 0);
+        CHECK(s.depth == s.levels.size());
+        CHECK(s.depth > 0);
+        CHECK(s.levels.front().nodes == 1);
+        CHECK(s.levels.back().nodes == s.leaves);
+        CHECK(s.levels.back().used + s.tail_size == n);
+        CHECK(s.levels.back().fill() == 1);
+        CHECK(s.tail_size > 0);
+        CHECK(s.tail_size <= s.tail_capacity);
+        auto inner = std::size_t{};
+        for (auto i = 0u; i + 1 < s.levels.size(); ++i) {
+            CHECK(s.levels[i].used == s.levels[i + 1].nodes);
+            inner += s.levels[i].nodes;
+        }
+        CHECK(inner == s.inner_nodes);
+    }
+
+    SECTION("regular")
+    {
+        auto v = make_test_flex_vector(0, n);
+        auto s = v.get_debug_stats();
+        auto f = v.get_debug_stats();
+        CHECK(s.relaxed_nodes == 0);
+        CHECK(s.leaves == f.leaves);
+        CHECK(s.inner_nodes == f.inner_nodes);
+        CHECK(s.levels.back().used + s.tail_size == n);
+    }
+
+    SECTION("relaxed")
+    {
+        auto v = make_test_flex_vector_front(0, n);
+        auto s = v.get_debug_stats();
+        auto f = v.get_debug_stats();
+        CHECK(s.size == n);
+        CHECK(s.relaxed_nodes > 0);
+        CHECK(s.relaxed_nodes == f.relaxed_nodes);
+        CHECK(s.relaxed_bytes >= s.relaxed_nodes * sizeof(std::size_t));
+        CHECK(s.leaves == f.leaves);
+        CHECK(s.levels.back().used == f.elements);
+        CHECK(s.levels.back().used + s.tail_size == n);
+        CHECK(s.levels.back().fill() <= 1);
+
+        auto c = v.compact().get_debug_stats();
+        CHECK(c.relaxed_nodes == 0);
+        CHECK(c.relaxed_bytes == 0);
+        CHECK(c.leaves <= s.leaves);
+    }
+}
@@ -0,0 +1,28 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <immer/tuned.hpp>
+
+#include <cstdint>
+
+static_assert(immer::tuned_bits_leaf<std::uint64_t, 4, 64> == 5, "");
+static_assert(immer::tuned_bits_leaf<std::uint32_t, 4, 64> == 6, "");
+static_assert(immer::tuned_bits_leaf<std::uint64_t, 1, 64> == 3, "");
+static_assert(immer::tuned_bits_leaf<char[1000], 1, 64> == 0, "");
+
+template <typename T>
+using test_flex_vector_t =
+    immer::tuned_flex_vector<T, immer::default_memory_policy, 1, 3u>;
+
+template <typename T>
+using test_vector_t =
+    immer::tuned_vector<T, immer::default_memory_policy, 1, 3u>;
+
+#define FLEX_VECTOR_T test_flex_vector_t
+#define VECTOR_T test_vector_t
+#include "generic.ipp"
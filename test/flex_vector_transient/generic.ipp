@@ -409,3 +409,22 @@ TEST_CASE("exception safety relaxed")
         CHECK(t.d.happenings > 0);
     }
 }
+
+TEST_CASE("compact")
+{
+    const auto n = 666u;
+    auto v       = make_test_flex_vector_front(0, n);
+    auto t       = v.transient();
+    t.compact();
+    CHECK_VECTOR_EQUALS(t, boost::irange(0u, n));
+    CHECK(t.get_debug_stats().relaxed_nodes == 0);
+    CHECK_VECTOR_EQUALS(v, boost::irange(0u, n));
+
+    t.push_back(n);
+    t.compact();
+    CHECK_VECTOR_EQUALS(t, boost::irange(0u, n + 1));
+
+    auto p = t.persistent();
+    CHECK(p.get_debug_stats().relaxed_nodes == 0);
+    CHECK_VECTOR_EQUALS(p, boost::irange(0u, n + 1));
+}
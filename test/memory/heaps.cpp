@@ -6,11 +6,14 @@
 // See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
 //
 
+#include <immer/heap/counting_heap.hpp>
 #include <immer/heap/cpp_heap.hpp>
 #include <immer/heap/free_list_heap.hpp>
 #include <immer/heap/gc_heap.hpp>
 #include <immer/heap/malloc_heap.hpp>
 #include <immer/heap/thread_local_free_list_heap.hpp>
+#include <immer/map.hpp>
+#include <immer/memory_policy.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 #include <numeric>
@@ -99,3 +102,64 @@ TEST_CASE("unsafe free_list")
     test_free_list_heap<
         immer::unsafe_free_list_heap<42u, 2, immer::malloc_heap>>();
 }
+
+TEST_CASE("counting")
+{
+    using heap = immer::counting_heap<immer::malloc_heap>;
+
+    SECTION("basic")
+    {
+        auto s0 = immer::get_heap_stats();
+        auto p  = heap::allocate(42u);
+        do_stuff_to(p, 42u);
+        auto s1 = immer::get_heap_stats();
+        CHECK(s1.allocations == s0.allocations + 1);
+        CHECK(s1.allocated_bytes == s0.allocated_bytes + 42);
+        CHECK(s1.live_bytes == s0.live_bytes + 42);
+        heap::deallocate(42, p);
+        auto s2 = immer::get_heap_stats();
+        CHECK(s2.deallocations == s1.deallocations + 1);
+        CHECK(s2.allocated_bytes == s1.allocated_bytes);
+        CHECK(s2.live_bytes == s0.live_bytes);
+    }
+
+    SECTION("peak")
+    {
+        immer::reset_heap_peak();
+        auto s0 = immer::get_heap_stats();
+        CHECK(s0.peak_live_bytes == s0.live_bytes);
+        auto p = heap::allocate(100u);
+        auto q = heap::allocate(20u);
+        heap::deallocate(100, p);
+        auto u = heap::allocate(50u);
+        heap::deallocate(20, q);
+        heap::deallocate(50, u);
+        auto s1 = immer::get_heap_stats();
+        CHECK(s1.live_bytes == s0.live_bytes);
+        CHECK(s1.peak_live_bytes == s0.live_bytes + 120);
+    }
+
+    SECTION("containers")
+    {
+        using memory = immer::memory_policy<
+            immer::heap_policy<immer::counting_heap<immer::cpp_heap>>,
+            immer::refcount_policy,
+            immer::default_lock_policy>;
+        using map_t =
+            immer::map<int, int, std::hash<int>, std::equal_to<int>, memory>;
+
+        auto s0 = immer::get_heap_stats();
+        {
+            auto m = map_t{};
+            for (auto i = 0; i < 100; ++i)
+                m = m.set(i, i);
+            auto s1 = immer::get_heap_stats();
+            CHECK(s1.allocations > s0.allocations);
+            CHECK(s1.live_bytes > s0.live_bytes);
+        }
+        auto s2 = immer::get_heap_stats();
+        CHECK(s2.live_bytes == s0.live_bytes);
+        CHECK(s2.allocations - s0.allocations ==
+              s2.deallocations - s0.deallocations);
+    }
+}
@@ -0,0 +1,215 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <immer/array.hpp>
+#include <immer/array_transient.hpp>
+#include <immer/flex_vector.hpp>
+#include <immer/map.hpp>
+#include <immer/map_transient.hpp>
+#include <immer/memory_policy.hpp>
+#include <immer/vector.hpp>
+#include <immer/vector_transient.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+struct trace_counts
+{
+    std::size_t allocations   = 0;
+    std::size_t deallocations = 0;
+    std::size_t live_bytes    = 0;
+    std::size_t copies        = 0;
+    std::size_t mutations     = 0;
+    std::size_t rebalances    = 0;
+    std::size_t collisions    = 0;
+};
+
+trace_counts counts;
+
+struct counting_trace_policy
+{
+    static void on_allocate(std::size_t size)
+    {
+        ++counts.allocations;
+        counts.live_bytes += size;
+    }
+    static void on_deallocate(std::size_t size)
+    {
+        ++counts.deallocations;
+        counts.live_bytes -= size;
+    }
+    static void on_copy(std::size_t) { ++counts.copies; }
+    static void on_mutate() { ++counts.mutations; }
+    static void on_rebalance(std::size_t, std::size_t) { ++counts.rebalances; }
+    static void on_collision(std::size_t) { ++counts.collisions; }
+};
+
+using memory_t = immer::traced_memory_policy<immer::default_memory_policy,
+                                             counting_trace_policy>;
+
+struct bad_hash
+{
+    std::size_t operator()(int x) const { return x & 1; }
+};
+
+} // namespace
+
+TEST_CASE("no trace policy by default")
+{
+    static_assert(
+        std::is_same<
+            immer::traced_memory_policy<immer::default_memory_policy,
+                                        immer::no_trace_policy>,
+            immer::default_memory_policy>::value,
+        "");
+    static_assert(std::is_same<immer::get_trace_policy_t<
+                                   immer::default_memory_policy>,
+                               immer::no_trace_policy>::value,
+                  "");
+    static_assert(
+        std::is_same<immer::get_trace_policy_t<memory_t>,
+                     counting_trace_policy>::value,
+        "");
+}
+
+TEST_CASE("trace vector")
+{
+    using vector_t = immer::vector<int, memory_t>;
+    auto empty     = vector_t{};
+    counts         = {};
+
+    SECTION("allocations")
+    {
+        {
+            auto v = vector_t{};
+            for (auto i = 0; i < 1000; ++i)
+                v = v.push_back(i);
+            CHECK(counts.allocations > 0);
+            CHECK(counts.live_bytes > 0);
+        }
+        CHECK(counts.allocations == counts.deallocations);
+        CHECK(counts.live_bytes == 0);
+    }
+
+    SECTION("copies")
+    {
+        auto v = vector_t{};
+        for (auto i = 0; i < 1000; ++i)
+            v = v.push_back(i);
+        counts  = {};
+        auto v2 = v.set(42, 0);
+        CHECK(counts.copies > 0);
+        CHECK(v[42] == 42);
+        CHECK(v2[42] == 0);
+    }
+
+    SECTION("mutations")
+    {
+        // with 64 ints per leaf, the first 960 elements are in 15 leaves
+        // under the root and the last 40 are in the tail
+        auto v = vector_t{}.transient();
+        for (auto i = 0; i < 1000; ++i)
+            v.push_back(i);
+        counts = {};
+        v.set(42, 0);
+        CHECK(counts.mutations == 2);
+        CHECK(counts.copies == 0);
+
+        counts = {};
+        v.set(999, 0);
+        CHECK(counts.mutations == 1);
+        v.push_back(1000);
+        CHECK(counts.mutations == 2);
+        CHECK(counts.copies == 0);
+        CHECK(counts.allocations == 0);
+    }
+
+}
+
+TEST_CASE("trace flex vector rebalance")
+{
+    using vector_t = immer::flex_vector<int, memory_t>;
+    counts         = {};
+
+    auto v = vector_t{};
+    for (auto i = 0; i < 1000; ++i)
+        v = v.push_back(i);
+    auto r = v.drop(3) + v.drop(5);
+    CHECK(counts.rebalances > 0);
+    CHECK(r.size() == 1992);
+}
+
+TEST_CASE("trace map collisions")
+{
+    using map_t = immer::map<int, int, bad_hash, std::equal_to<int>, memory_t>;
+    counts      = {};
+
+    auto m = map_t{};
+    for (auto i = 0; i < 10; ++i)
+        m = m.set(i, i);
+    CHECK(counts.collisions > 0);
+    CHECK(counts.copies > 0);
+}
+
+TEST_CASE("trace map mutations")
+{
+    using map_t =
+        immer::map<int, int, std::hash<int>, std::equal_to<int>, memory_t>;
+
+    // with 5 bits per level, every key sits in a child of the root, next
+    // to the other keys with the same lower 5 bits
+    auto m = map_t{}.transient();
+    for (auto i = 0; i < 100; ++i)
+        m.set(i, i);
+    counts = {};
+
+    m.set(42, 0);
+    CHECK(counts.mutations == 2);
+    m.erase(42);
+    CHECK(counts.mutations == 4);
+    CHECK(counts.copies == 0);
+    CHECK(m.size() == 99);
+}
+
+TEST_CASE("trace array")
+{
+    using array_t = immer::array<int, memory_t>;
+    auto empty    = array_t{};
+    counts        = {};
+
+    {
+        auto a = array_t{1, 2, 3};
+        auto b = a.push_back(4);
+        CHECK(counts.copies == 1);
+        CHECK(b.size() == 4);
+    }
+    CHECK(counts.allocations == counts.deallocations);
+    CHECK(counts.live_bytes == 0);
+}
+
+TEST_CASE("trace array mutations")
+{
+    using array_t = immer::array<int, memory_t>;
+
+    auto t = array_t{1, 2, 3}.transient();
+    counts = {};
+    t.set(0, 0);
+    t.update(1, [](int x) { return x + 1; });
+    CHECK(counts.mutations == 2);
+    CHECK(counts.copies == 0);
+
+    // the array is full, so it is copied even if it could be mutated
+    counts = {};
+    t.push_back(4);
+    CHECK(counts.mutations == 0);
+    CHECK(counts.copies == 1);
+    t.push_back(5);
+    CHECK(counts.mutations == 1);
+    CHECK(counts.copies == 1);
+}
@@ -0,0 +1,203 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <immer/sort.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct item
+{
+    unsigned key;
+    unsigned pos;
+};
+
+struct key_less
+{
+    bool operator()(const item& a, const item& b) const
+    {
+        return a.key < b.key;
+    }
+};
+
+template <typename V>
+V make_random(unsigned n, unsigned keys, bool relaxed)
+{
+    auto engine = std::mt19937{42};
+    auto dist   = std::uniform_int_distribution<unsigned>{0, keys - 1};
+    auto v      = V{};
+    for (auto i = 0u; i < n; ++i) {
+        auto x = typename V::value_type{dist(engine), i};
+        v      = relaxed && i % 3 ? std::move(v).push_front(x)
+                                  : std::move(v).push_back(x);
+    }
+    return v;
+}
+
+template <typename V>
+std::vector<item> to_std(const V& v)
+{
+    return {v.begin(), v.end()};
+}
+
+bool same(const std::vector<item>& a, const std::vector<item>& b)
+{
+    return std::equal(
+        a.begin(), a.end(), b.begin(), b.end(), [](auto& x, auto& y) {
+            return x.key == y.key && x.pos == y.pos;
+        });
+}
+
+bool same_keys(const std::vector<item>& a, const std::vector<item>& b)
+{
+    return std::equal(
+        a.begin(), a.end(), b.begin(), b.end(), [](auto& x, auto& y) {
+            return x.key == y.key;
+        });
+}
+
+const auto sizes = {0u, 1u, 7u, 100u, 1000u, 5000u, 40000u};
+
+// Executor that runs every task in a new thread, remembering the most tasks
+// that were running at once.
+struct counting_executor
+{
+    std::atomic<int>& running;
+    std::atomic<int>& peak;
+
+    // Leaves the task as finished even when it throws
+    struct running_guard
+    {
+        std::atomic<int>& running;
+        ~running_guard() { --running; }
+    };
+
+    template <typename Fn>
+    std::future<void> operator()(Fn&& fn) const
+    {
+        return std::async(std::launch::async, [this, fn] {
+            auto n = ++running;
+            running_guard guard{running};
+            auto p = peak.load();
+            while (p < n && !peak.compare_exchange_weak(p, n))
+                ;
+            fn();
+        });
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("sort")
+{
+    using vector_t = immer::flex_vector<item>;
+
+    SECTION("sequential")
+    {
+        for (auto n : sizes) {
+            for (auto relaxed : {false, true}) {
+                auto v      = make_random<vector_t>(n, 1000, relaxed);
+                auto s      = immer::sort(v, key_less{});
+                auto expect = to_std(v);
+                std::sort(expect.begin(), expect.end(), key_less{});
+                CHECK(s.size() == v.size());
+                CHECK(same_keys(to_std(s), expect));
+            }
+        }
+    }
+
+    SECTION("parallel")
+    {
+        auto v      = make_random<vector_t>(100000, 100000, true);
+        auto s      = immer::sort(v, key_less{}, immer::async_executor{});
+        auto expect = to_std(v);
+        std::sort(expect.begin(), expect.end(), key_less{});
+        CHECK(same_keys(to_std(s), expect));
+    }
+
+    SECTION("parallel tasks are bounded")
+    {
+        std::atomic<int> running{0};
+        std::atomic<int> peak{0};
+        auto v = make_random<vector_t>(1000000, 1000000, true);
+        auto s = immer::sort(v, key_less{}, counting_executor{running, peak});
+        auto expect = to_std(v);
+        std::sort(expect.begin(), expect.end(), key_less{});
+        CHECK(same_keys(to_std(s), expect));
+        CHECK(peak > 0);
+        CHECK(peak < 1 << immer::detail::max_fork_depth());
+    }
+
+    SECTION("default comparison")
+    {
+        auto v = immer::flex_vector<int>{5, 3, 1, 4, 2};
+        CHECK(immer::sort(v) == immer::flex_vector<int>{1, 2, 3, 4, 5});
+        CHECK(immer::sort(v, std::greater<>{}) ==
+              immer::flex_vector<int>{5, 4, 3, 2, 1});
+    }
+
+    SECTION("sorted input")
+    {
+        auto v = immer::flex_vector<int>{};
+        for (auto i = 0; i < 50000; ++i)
+            v = std::move(v).push_back(i);
+        CHECK(immer::sort(v) == v);
+    }
+}
+
+TEST_CASE("stable sort")
+{
+    using vector_t = immer::flex_vector<item>;
+
+    for (auto n : sizes) {
+        for (auto relaxed : {false, true}) {
+            auto v      = make_random<vector_t>(n, 10, relaxed);
+            auto expect = to_std(v);
+            std::stable_sort(expect.begin(), expect.end(), key_less{});
+            CHECK(same(to_std(immer::stable_sort(v, key_less{})), expect));
+            CHECK(same(to_std(immer::stable_sort(
+                           v, key_less{}, immer::async_executor{})),
+                       expect));
+        }
+    }
+}
+
+TEST_CASE("partial sort")
+{
+    using vector_t = immer::flex_vector<item>;
+
+    for (auto n : sizes) {
+        auto v      = make_random<vector_t>(n, 1000, true);
+        auto sorted = to_std(v);
+        std::sort(sorted.begin(), sorted.end(), key_less{});
+        for (auto k : {0u, 1u, 10u, 1000u, n / 2, n, n + 1}) {
+            auto s = immer::partial_sort(v, k, key_less{});
+            auto r = to_std(s);
+            auto m = std::min<std::size_t>(k, n);
+            CHECK(r.size() == n);
+            CHECK(std::equal(r.begin(),
+                             r.begin() + m,
+                             sorted.begin(),
+                             [](auto& x, auto& y) { return x.key == y.key; }));
+            // the remaining elements are a permutation of the original ones
+            auto by_pos = [](auto& x, auto& y) { return x.pos < y.pos; };
+            std::sort(r.begin(), r.end(), by_pos);
+            auto o = to_std(v);
+            std::sort(o.begin(), o.end(), by_pos);
+            CHECK(same(r, o));
+        }
+    }
+}
@@ -0,0 +1,193 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <immer/algorithm.hpp>
+#include <immer/text.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using text_t = immer::text<immer::default_memory_policy, 16>;
+
+namespace {
+
+template <typename Node>
+std::size_t check_balanced(const Node& p)
+{
+    if (p->is_leaf()) {
+        CHECK(p->bytes == p->chunk.size());
+        CHECK(p->height == 0u);
+        return 0;
+    }
+    auto hl = check_balanced(p->left());
+    auto hr = check_balanced(p->right());
+    CHECK(std::max(hl, hr) - std::min(hl, hr) <= 1u);
+    CHECK(p->height == std::max(hl, hr) + 1);
+    CHECK(p->bytes == p->left()->bytes + p->right()->bytes);
+    CHECK(p->lines == p->left()->lines + p->right()->lines);
+    return p->height;
+}
+
+std::string make_string(std::size_t n, unsigned seed)
+{
+    auto gen   = std::mt19937{seed};
+    auto chars = std::string{"abcdefgh \n\n"};
+    auto dist  = std::uniform_int_distribution<std::size_t>{
+        0, chars.size() - 1};
+    auto r     = std::string(n, ' ');
+    for (auto& c : r)
+        c = chars[dist(gen)];
+    return r;
+}
+
+template <typename Text>
+void check_text(const Text& t, const std::string& s)
+{
+    REQUIRE(t.size() == s.size());
+    CHECK(t.str() == s);
+    for (auto i = std::size_t{}; i < s.size(); i += 7)
+        CHECK(t[i] == s[i]);
+    check_balanced(t.impl().root);
+
+    auto lines = std::size_t{1};
+    for (auto i = std::size_t{}; i < s.size(); ++i) {
+        CHECK(t.offset_to_line(i) == lines - 1);
+        if (s[i] == '\n')
+            CHECK(t.line_to_offset(lines++) == i + 1);
+    }
+    CHECK(t.line_count() == lines);
+    CHECK(t.offset_to_line(s.size()) == lines - 1);
+}
+
+} // namespace
+
+TEST_CASE("instantiation")
+{
+    SECTION("default")
+    {
+        auto t = text_t{};
+        CHECK(t.empty());
+        CHECK(t.size() == 0u);
+        CHECK(t.line_count() == 1u);
+        CHECK(t.line_to_offset(0) == 0u);
+        CHECK(t.str() == "");
+    }
+
+    SECTION("from string")
+    {
+        for (auto n : {1u, 15u, 16u, 17u, 100u, 1000u}) {
+            auto s = make_string(n, n);
+            check_text(text_t{s}, s);
+        }
+    }
+
+    SECTION("default chunk size")
+    {
+        auto s = make_string(10000, 1);
+        check_text(immer::text<>{s}, s);
+    }
+}
+
+TEST_CASE("at")
+{
+    auto t = text_t{"hello"};
+    CHECK(t.at(4) == 'o');
+    CHECK_THROWS_AS(t.at(5), std::out_of_range);
+}
+
+TEST_CASE("lines")
+{
+    auto t = text_t{"first line\nsecond line\n\nlast"};
+    CHECK(t.line_count() == 4u);
+    CHECK(t.line(0).str() == "first line");
+    CHECK(t.line(1).str() == "second line");
+    CHECK(t.line(2).str() == "");
+    CHECK(t.line(3).str() == "last");
+    CHECK(t.line_to_offset(1) == 11u);
+    CHECK(t.offset_to_line(10) == 0u);
+    CHECK(t.offset_to_line(11) == 1u);
+}
+
+TEST_CASE("codepoints")
+{
+    auto t = text_t{"a\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80z"};
+    CHECK(t.size() == 11u);
+    CHECK(t.codepoint_count() == 5u);
+    CHECK(t.drop(1).take(2).codepoint_count() == 1u);
+}
+
+TEST_CASE("concat and slice")
+{
+    auto a = make_string(1000, 2);
+    auto b = make_string(37, 3);
+    auto c = make_string(5000, 4);
+    auto t = text_t{a} + text_t{b} + text_t{c};
+    check_text(t, a + b + c);
+    check_text(text_t{b} + text_t{c} + text_t{a}, b + c + a);
+    check_text(text_t{} + text_t{b}, b);
+    check_text(text_t{b} + text_t{}, b);
+
+    auto s = a + b + c;
+    for (auto i = 0u; i < s.size(); i += 797) {
+        check_text(t.take(i), s.substr(0, i));
+        check_text(t.drop(i), s.substr(i));
+        check_text(t.slice(i / 2, i), s.substr(i / 2, i - i / 2));
+    }
+}
+
+TEST_CASE("random edits")
+{
+    auto gen = std::mt19937{5};
+    auto s   = make_string(2000, 6);
+    auto t   = text_t{s};
+    auto old = t;
+    for (auto i = 0; i < 300; ++i) {
+        auto pos = std::uniform_int_distribution<std::size_t>{
+            0, s.size()}(gen);
+        if (i % 3 == 0) {
+            auto len = std::min<std::size_t>(
+                s.size() - pos,
+                std::uniform_int_distribution<std::size_t>{0, 50}(gen));
+            t = t.erase(pos, pos + len);
+            s.erase(pos, len);
+        } else {
+            auto ins = make_string(i % 5 ? 1 : 40, i);
+            t        = t.insert(pos, text_t{ins});
+            s.insert(pos, ins);
+        }
+        if (i % 50 == 0)
+            check_text(t, s);
+    }
+    check_text(t, s);
+    check_text(old, make_string(2000, 6));
+}
+
+TEST_CASE("equality")
+{
+    auto s = make_string(1000, 7);
+    auto t = text_t{s};
+    CHECK(t == t);
+    CHECK(t == text_t{s});
+    CHECK(t == t.take(300) + t.drop(300));
+    CHECK(t != t.take(999));
+    CHECK(t != t.erase(10, 11).insert(10, text_t{"#"}));
+}
+
+TEST_CASE("algorithms")
+{
+    auto s = make_string(3000, 8);
+    auto t = text_t{s};
+    CHECK(immer::count(t, '\n') == std::count(s.begin(), s.end(), '\n'));
+    auto r = std::string{};
+    immer::for_each_chunk(t, [&](auto f, auto l) { r.append(f, l); });
+    CHECK(r == s);
+}
@@ -0,0 +1,157 @@
+//
+// immer: immutable data structures for C++
+// Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+//
+// This software is distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+//
+
+#include <immer/algorithm.hpp>
+#include <immer/flex_vector.hpp>
+#include <immer/vector.hpp>
+#include <immer/vector_view.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+template <typename V>
+V make_back(unsigned n)
+{
+    auto v = V{};
+    for (auto i = 0u; i < n; ++i)
+        v = std::move(v).push_back(i);
+    return v;
+}
+
+template <typename V>
+V make_relaxed(unsigned n)
+{
+    auto v = V{};
+    for (auto i = 0u; i < n; i += 7) {
+        auto chunk = V{};
+        for (auto j = i; j < std::min(i + 7, n); ++j)
+            chunk = std::move(chunk).push_back(j);
+        v = v + chunk;
+    }
+    return v;
+}
+
+template <typename View>
+void check_view(const View& w, unsigned first, unsigned last)
+{
+    CHECK(w.size() == last - first);
+    CHECK(w.empty() == (first == last));
+    for (auto i = 0u; i < w.size(); ++i)
+        CHECK(w[i] == first + i);
+    auto expected = std::vector<unsigned>(last - first);
+    std::iota(expected.begin(), expected.end(), first);
+    CHECK(std::equal(w.begin(), w.end(), expected.begin(), expected.end()));
+    CHECK(std::equal(
+        w.rbegin(), w.rend(), expected.rbegin(), expected.rend()));
+
+    auto chunked = std::vector<unsigned>{};
+    w.impl().for_each_chunk(
+        [&](auto f, auto l) { chunked.insert(chunked.end(), f, l); });
+    CHECK(chunked == expected);
+    CHECK(immer::accumulate(w, 0u) ==
+          std::accumulate(expected.begin(), expected.end(), 0u));
+
+    auto m = w.materialize();
+    CHECK(m.size() == w.size());
+    CHECK(std::equal(m.begin(), m.end(), expected.begin(), expected.end()));
+}
+
+template <typename V>
+void check_all_views(const V& v)
+{
+    auto n = static_cast<unsigned>(v.size());
+    for (auto first = 0u; first <= n; first += 1 + first / 3)
+        for (auto last = first; last <= n; last += 1 + (last - first) / 2)
+            check_view(immer::make_view(v, first, last), first, last);
+}
+
+} // anonymous namespace
+
+TEST_CASE("vector view")
+{
+    SECTION("empty")
+    {
+        auto w = immer::vector_view<unsigned>{};
+        CHECK(w.size() == 0);
+        CHECK(w.empty());
+        CHECK(w.begin() == w.end());
+        CHECK(w.materialize().size() == 0);
+    }
+
+    SECTION("whole vector")
+    {
+        auto v = make_back<immer::vector<unsigned>>(1000);
+        auto w = immer::make_view(v);
+        check_view(w, 0, 1000);
+        CHECK(w.materialize().identity() == v.identity());
+    }
+
+    SECTION("slices")
+    {
+        check_all_views(make_back<immer::vector<unsigned>>(300));
+        check_all_views(make_back<immer::vector<unsigned, //
+                                                immer::default_memory_policy,
+                                                2,
+                                                2>>(300));
+    }
+}
+
+TEST_CASE("flex vector view")
+{
+    SECTION("regular")
+    {
+        check_all_views(make_back<immer::flex_vector<unsigned>>(300));
+    }
+
+    SECTION("relaxed")
+    {
+        check_all_views(make_relaxed<immer::flex_vector<unsigned>>(300));
+        using flex_t = immer::
+            flex_vector<unsigned, immer::default_memory_policy, 2, 2>;
+        check_all_views(make_relaxed<flex_t>(300));
+    }
+}
+
+TEST_CASE("view slicing")
+{
+    auto v = make_relaxed<immer::flex_vector<unsigned>>(500);
+    auto w = immer::flex_vector_view<unsigned>{v, 100, 400};
+
+    check_view(w.take(50), 100, 150);
+    check_view(w.drop(50), 150, 400);
+    check_view(w.slice(10, 20), 110, 120);
+    check_view(w.drop(1000), 400, 400);
+    check_view(w.take(1000), 100, 400);
+    check_view(w.drop(10).take(10).drop(5), 115, 120);
+
+    CHECK(w.front() == 100);
+    CHECK(w.back() == 399);
+    CHECK(w.offset() == 100);
+    CHECK(w.container().identity() == v.identity());
+    CHECK(w.at(0) == 100);
+    CHECK_THROWS_AS(w.at(300), std::out_of_range);
+
+    CHECK(w.slice(0, 10) == immer::make_view(v, 100, 110));
+    CHECK(w.slice(0, 10) != immer::make_view(v, 101, 111));
+    CHECK(w.slice(0, 10) != immer::make_view(v, 100, 109));
+}
+
+TEST_CASE("view outlives container")
+{
+    auto w = [] {
+        auto v = make_relaxed<immer::flex_vector<unsigned>>(200);
+        return immer::make_view(v, 50, 150);
+    }();
+    check_view(w, 50, 150);
+}
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+#
+# immer: immutable data structures for C++
+# Copyright (C) 2016, 2017, 2018 Juan Pedro Bolivar Puente
+#
+# This software is distributed under the Boost Software License, Version 1.0.
+# See accompanying file LICENSE or copy at http://boost.org/LICENSE_1_0.txt
+#
+
+"""Compares two directories of benchmark reports written by the nonius
+`json` reporter in `benchmark/reporter.hpp`, like the ones in `reports/`
+after running the benchmarks with `-DCHECK_BENCHMARKS=1`.
+
+For every benchmark present in both, it runs Welch's t-test over the samples
+and flags it as a regression when it is significantly slower, by more than
+the given threshold.  It exits with status 1 when there are regressions, so
+it can be used to gate changes on performance.
+
+Usage: compare-benchmarks.py OLD_DIR NEW_DIR [--alpha A] [--threshold T]
+"""
+
+import argparse
+import glob
+import json
+import math
+import os
+import sys
+
+
+def load_reports(directory):
+    results = {}
+    for path in sorted(glob.glob(os.path.join(directory, "*.json"))):
+        with open(path) as f:
+            try:
+                data = json.load(f)
+            except ValueError:
+                print("skipping {}: invalid JSON".format(path), file=sys.stderr)
+                continue
+        if not isinstance(data, dict) or "results" not in data:
+            continue
+        for r in data["results"]:
+            params = tuple(sorted(r.get("params", {}).items()))
+            results[(r["benchmark"], r["name"], params)] = r
+    return results
+
+
+def betacf(a, b, x):
+    # continued fraction of the incomplete beta function, from Numerical
+    # Recipes
+    qab, qap, qam = a + b, a + 1.0, a - 1.0
+    c, d = 1.0, 1.0 - qab * x / qap
+    d = 1.0 / (d if abs(d) > 1e-300 else 1e-300)
+    h = d
+    for m in range(1, 300):
+        m2 = 2 * m
+        aa = m * (b - m) * x / ((qam + m2) * (a + m2))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > 1e-300 else 1e-300)
+        c = 1.0 + aa / c
+        c = c if abs(c) > 1e-300 else 1e-300
+        h *= d * c
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > 1e-300 else 1e-300)
+        c = 1.0 + aa / c
+        c = c if abs(c) > 1e-300 else 1e-300
+        delta = d * c
+        h *= delta
+        if abs(delta - 1.0) < 1e-12:
+            break
+    return h
+
+
+def betainc(a, b, x):
+    """Regularized incomplete beta function I_x(a, b)."""
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    lbeta = math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b)
+    front = math.exp(lbeta + a * math.log(x) + b * math.log(1.0 - x))
+    if x < (a + 1.0) / (a + b + 2.0):
+        return front * betacf(a, b, x) / a
+    return 1.0 - front * betacf(b, a, 1.0 - x) / b
+
+
+def welch(old, new):
+    """Returns the two-sided p-value of Welch's t-test for the difference of
+    the means of two benchmark results."""
+    n1, n2 = old["samples"], new["samples"]
+    if n1 < 2 or n2 < 2:
+        return 1.0
+    v1 = old["stddev"] ** 2 / n1
+    v2 = new["stddev"] ** 2 / n2
+    if v1 + v2 == 0:
+        return 0.0 if old["mean"] != new["mean"] else 1.0
+    t = (new["mean"] - old["mean"]) / math.sqrt(v1 + v2)
+    df = (v1 + v2) ** 2 / (v1 ** 2 / (n1 - 1) + v2 ** 2 / (n2 - 1))
+    return betainc(df / 2.0, 0.5, df / (df + t * t))
+
+
+def heap_bytes_change(old, new):
+    """Change in bytes allocated per iteration through the counting heap,
+    only known when both runs were built with `ENABLE_COUNTING_HEAP`."""
+    o, n = old.get("heap_bytes"), new.get("heap_bytes")
+    if o is None or n is None:
+        return "-"
+    return "{:+.4g}".format(n - o)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare two directories of benchmark JSON reports.")
+    parser.add_argument("old", help="directory with the baseline reports")
+    parser.add_argument("new", help="directory with the new reports")
+    parser.add_argument("--alpha", type=float, default=0.01,
+                        help="significance level (default: 0.01)")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="minimum relative slowdown that counts as a "
+                             "regression (default: 0.05)")
+    args = parser.parse_args()
+
+    old = load_reports(args.old)
+    new = load_reports(args.new)
+    common = sorted(set(old) & set(new))
+    if not common:
+        print("no benchmarks in common", file=sys.stderr)
+        return 2
+
+    regressions = 0
+    print("{:<40} {:<28} {:>12} {:>12} {:>8} {:>9} {:>8} {:>10}  {}".format(
+        "benchmark", "name", "old mean", "new mean", "change", "p-value",
+        "allocs", "heap bytes", "verdict"))
+    for key in common:
+        o, n = old[key], new[key]
+        change = (n["mean"] - o["mean"]) / o["mean"] if o["mean"] else 0.0
+        p = welch(o, n)
+        significant = p < args.alpha
+        if significant and change > args.threshold:
+            verdict = "REGRESSION"
+            regressions += 1
+        elif significant and change < -args.threshold:
+            verdict = "improvement"
+        else:
+            verdict = ""
+        allocs = n.get("allocations", 0) - o.get("allocations", 0)
+        print("{:<40} {:<28} {:>12.4g} {:>12.4g} {:>+7.1f}% {:>9.2g} "
+              "{:>+8.3g} {:>10}  {}".format(key[0], key[1], o["mean"],
+                                            n["mean"], change * 100, p,
+                                            allocs, heap_bytes_change(o, n),
+                                            verdict))
+
+    only_old = len(set(old) - set(new))
+    only_new = len(set(new) - set(old))
+    print("\n{} compared, {} regressions, {} only in old, {} only in new"
+          .format(len(common), regressions, only_old, only_new))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())